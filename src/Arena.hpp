@@ -0,0 +1,199 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Arena.hpp
+//!
+//! \brief	Monotonic memory resource, all memory of one job is released in one shot
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <memory_resource> // std::pmr::memory_resource
+#include <memory>          // std::align
+#include <new>             // std::bad_alloc
+#include <cassert>         // assert
+#include <cstddef>         // std::max_align_t
+
+namespace NMemory
+{
+
+#pragma region CLASSES
+
+	class Arena final : public std::pmr::memory_resource
+	{
+	public:
+		static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 14;
+
+//====================================================================================================================================
+//!
+//! \brief	Allocates the first block, further blocks are allocated only if it is exhausted
+//!
+//! \param  blockSize  Size of the first block in bytes
+//!
+//! \throw  std::bad_alloc
+//!
+//====================================================================================================================================
+
+		explicit Arena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+		Arena(const Arena&) = delete;
+		Arena(Arena&&)      = delete;
+		~Arena();
+
+		Arena &operator=(const Arena&) = delete;
+		Arena &operator=(Arena&&)      = delete;
+
+//====================================================================================================================================
+//!
+//! \brief	Releases all the memory at once, the first block is kept for reuse
+//!
+//! \note   Objects allocated from the arena must be destroyed before
+//!
+//====================================================================================================================================
+
+		void release() noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns number of bytes handed out since the last release
+//!
+//! \return  Used bytes
+//!
+//====================================================================================================================================
+
+		size_t used() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns number of bytes taken from the system
+//!
+//! \return  Reserved bytes
+//!
+//====================================================================================================================================
+
+		size_t reserved() const noexcept;
+
+	private:
+		struct Block
+		{
+			Block  *pNext;
+			size_t  size;
+		};
+
+		Block  *pBlocks_; // The last allocated block goes first
+		char   *pCur_,
+		       *pEnd_;
+		size_t  used_,
+		        reserved_;
+
+		void addBlock(size_t size);
+
+		void *do_allocate(size_t bytes, size_t alignment)                    override;
+		void  do_deallocate(void*, size_t, size_t) noexcept                  override;
+		bool  do_is_equal(const std::pmr::memory_resource &crOther) const noexcept override;
+	};
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Arena::Arena(size_t blockSize /* = DEFAULT_BLOCK_SIZE */) :
+		pBlocks_(nullptr),
+		pCur_(nullptr),
+		pEnd_(nullptr),
+		used_(NULL),
+		reserved_(NULL)
+	{
+		addBlock(blockSize);
+	}
+
+	inline Arena::~Arena()
+	{
+		while (pBlocks_)
+		{
+			Block *pNext = pBlocks_->pNext;
+			::operator delete(pBlocks_);
+
+			pBlocks_ = pNext;
+		}
+	}
+
+	inline void Arena::release() noexcept
+	{
+		while (pBlocks_->pNext)
+		{
+			Block *pNext = pBlocks_->pNext;
+			reserved_ -= pBlocks_->size;
+			::operator delete(pBlocks_);
+
+			pBlocks_ = pNext;
+		}
+
+		pCur_ = reinterpret_cast<char*>(pBlocks_ + 1);
+		pEnd_ = reinterpret_cast<char*>(pBlocks_) + pBlocks_->size;
+		used_ = NULL;
+	}
+
+	inline size_t Arena::used() const noexcept
+	{
+		return used_;
+	}
+
+	inline size_t Arena::reserved() const noexcept
+	{
+		return reserved_;
+	}
+
+	inline void Arena::addBlock(size_t size)
+	{
+		size += sizeof(Block);
+
+		Block *pBlock = static_cast<Block*>(::operator new(size));
+		pBlock->pNext = pBlocks_;
+		pBlock->size  = size;
+
+		pBlocks_   = pBlock;
+		pCur_      = reinterpret_cast<char*>(pBlock + 1);
+		pEnd_      = reinterpret_cast<char*>(pBlock) + size;
+		reserved_ += size;
+	}
+
+	inline void *Arena::do_allocate(size_t bytes, size_t alignment)
+	{
+		assert(alignment <= alignof(std::max_align_t));
+
+		void   *pMem  = pCur_;
+		size_t  space = static_cast<size_t>(pEnd_ - pCur_);
+		if (!std::align(alignment, bytes, pMem, space))
+		{
+			size_t last = pBlocks_->size - sizeof(Block);
+			addBlock((bytes + alignment > last ? bytes + alignment : last) << 1); // Blocks grow geometrically
+
+			pMem  = pCur_;
+			space = static_cast<size_t>(pEnd_ - pCur_);
+			if (!std::align(alignment, bytes, pMem, space))
+				throw std::bad_alloc();
+		}
+
+		pCur_  = static_cast<char*>(pMem) + bytes;
+		used_ += bytes;
+
+		return pMem;
+	}
+
+	inline void Arena::do_deallocate(void*, size_t, size_t) noexcept
+	{ } // Memory is returned only by release()
+
+	inline bool Arena::do_is_equal(const std::pmr::memory_resource &crOther) const noexcept
+	{
+		return (this == &crOther);
+	}
+
+#pragma endregion
+
+} // namespace NMemory
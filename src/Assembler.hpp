@@ -0,0 +1,269 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Assembler.hpp
+//!
+//! \brief	Assembles many programm files at once: the files are taken by a pool of threads, each converts one at a time
+//!
+//! \note   The converters of Compiler<> are const and the command tables are constexpr, so all the threads share one compiler.
+//!         Outputs are written through NAtomicFile, so a reader never sees a half written file and a failure leaves none.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <algorithm>   // std::min, std::sort
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::steady_clock
+#include <filesystem>  // std::filesystem::path, std::filesystem::directory_iterator
+#include <iomanip>     // std::setw, std::setprecision
+#include <ostream>     // std::ostream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <thread>      // std::thread
+#include <vector>      // std::vector
+
+#include "Compiler.hpp"
+
+namespace NAssembler
+{
+
+#pragma region CONSTANTS
+
+	constexpr std::string_view SOURCE_EXT = ".txt";
+
+	constexpr std::string_view OUTPUTS[] = { "Com.txt", "BinText.txt", "BinCom.txt" }; // Suffixes of the converted files
+
+#pragma endregion
+
+#pragma region ENUMS
+
+	enum class Mode : unsigned char
+	{
+		text2com,
+		text2bin,
+		com2bin
+	};
+
+#pragma endregion
+
+#pragma region STRUCTS
+
+	struct Result
+	{
+		std::filesystem::path path;  // Without the extension, as given to the converter
+		bool                  ok;
+		double                ms;    // Time of the conversion
+		size_t                bytes; // Size of the source
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 Makes the list of the files to convert
+//!
+//! \param   crPath  Directory or a source file (with or without .txt)
+//! \param   mode    Which sources to take from the directory: the text ones, or the Com ones for com2bin
+//!
+//! \return  Paths without the extension (and without Com for com2bin) in the order of their names, converted files are skipped
+//!
+//====================================================================================================================================
+
+	std::vector<std::filesystem::path> Collect(const std::filesystem::path &crPath, Mode mode);
+
+//====================================================================================================================================
+//!
+//! \brief	 Outputs a line of status, time and path for every file, then the totals
+//!
+//! \param   crResults  Results of Assembler<>::run()
+//! \param   wallMs     Time of the whole run
+//! \param   threads    Number of threads of the run
+//! \param   rOstr      Stream to output
+//!
+//! \return  Number of the failed files
+//!
+//====================================================================================================================================
+
+	size_t Report(const std::vector<Result> &crResults, double wallMs, size_t threads, std::ostream &rOstr);
+
+	inline bool EndsWith(std::string_view str, std::string_view suffix) noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+	template<typename T = int>
+	class Assembler final
+	{
+	public:
+		explicit Assembler(size_t threads = 0); // 0 - a thread per core
+
+		size_t threads() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Converts the files on the pool, every thread takes the next file until none is left
+//!
+//! \param   crFiles  Paths without the extension, see Collect()
+//! \param   mode     Converter to run
+//!
+//! \return  Result of every file in the order of crFiles
+//!
+//====================================================================================================================================
+
+		std::vector<Result> run(const std::vector<std::filesystem::path> &crFiles, Mode mode);
+
+	private:
+		size_t                 threads_;
+		NCompiler::Compiler<T> compiler_; // Only its const converters are called, from all the threads
+
+		bool convert(const std::filesystem::path &crPath, Mode mode) const; // Reports an exception as a failure of the file
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline bool EndsWith(std::string_view str, std::string_view suffix) noexcept
+	{
+		return (str.length() >= suffix.length() && str.substr(str.length() - suffix.length()) == suffix);
+	}
+
+	inline std::vector<std::filesystem::path> Collect(const std::filesystem::path &crPath, Mode mode)
+	{
+		std::string_view suffix = (mode == Mode::com2bin ? OUTPUTS[0] : SOURCE_EXT);
+
+		std::vector<std::filesystem::path> files;
+		auto take = [&](const std::filesystem::path &crFile)
+		{
+			std::string name = crFile.generic_string();
+			if (!EndsWith(name, suffix)) return;
+
+			for (auto &&output : OUTPUTS) // Converted files are not sources, except Com ones for com2bin
+				if (output != suffix && EndsWith(name, output)) return;
+
+			files.emplace_back(name.substr(0, name.length() - suffix.length()));
+		};
+
+		std::error_code error;
+		if (std::filesystem::is_directory(crPath, error))
+		{
+			for (auto &&entry : std::filesystem::directory_iterator(crPath, error))
+				if (entry.is_regular_file(error)) take(entry.path());
+
+			std::sort(files.begin(), files.end());
+		}
+		else if (EndsWith(crPath.generic_string(), SOURCE_EXT))
+			take(crPath);
+		else
+			files.push_back(crPath);
+
+		return files;
+	}
+
+	inline size_t Report(const std::vector<Result> &crResults, double wallMs, size_t threads, std::ostream &rOstr)
+	{
+		size_t failed = 0,
+		       bytes  = 0;
+		double workMs = 0;
+		for (auto &&result : crResults)
+		{
+			rOstr << std::left  << std::setw(8) << (result.ok ? "OK" : "FAILED")
+			      << std::right << std::fixed << std::setprecision(3) << std::setw(12) << result.ms << " ms  "
+			      << result.path.generic_string() << '\n';
+
+			failed += !result.ok;
+			bytes  += result.bytes;
+			workMs += result.ms;
+		}
+
+		rOstr << crResults.size() << " files, " << failed << " failed, " << std::setprecision(1) << bytes / double(1 << 20) << " MB in "
+		      << std::setprecision(3) << wallMs << " ms on " << threads << " threads (" << workMs << " ms of work)" << std::endl;
+
+		return failed;
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	template<typename T>
+	Assembler<T>::Assembler(size_t threads /* = 0 */) :
+		threads_(threads ? threads : std::max<size_t>(std::thread::hardware_concurrency(), 1)),
+		compiler_()
+	{ }
+
+	template<typename T>
+	inline size_t Assembler<T>::threads() const noexcept
+	{
+		return threads_;
+	}
+
+	template<typename T>
+	std::vector<Result> Assembler<T>::run(const std::vector<std::filesystem::path> &crFiles, Mode mode)
+	{
+		compiler_.setThreads(std::max<size_t>(threads_ / std::max<size_t>(crFiles.size(), 1), 1)); // Threads left over by the files split them
+		std::vector<Result> results(crFiles.size());
+		std::atomic<size_t> next = NULL;
+
+		auto work = [&]
+		{ // Files differ in size, so they are taken one by one instead of being split in equal parts
+			for (size_t i = next++; i < crFiles.size(); i = next++)
+			{
+				auto &&result = results[i];
+				result.path   = crFiles[i];
+
+				std::error_code error;
+				auto source  = crFiles[i].generic_string() + std::string(mode == Mode::com2bin ? OUTPUTS[0] : SOURCE_EXT);
+				result.bytes = static_cast<size_t>(std::filesystem::file_size(source, error));
+				if (error) result.bytes = NULL;
+
+				auto start = std::chrono::steady_clock::now();
+				result.ok  = convert(crFiles[i], mode);
+				result.ms  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			}
+		};
+
+		std::vector<std::thread> pool;
+		for (size_t i = 1; i < std::min(threads_, crFiles.size()); i++)
+			pool.emplace_back(work);
+
+		work(); // The calling thread is one of the pool
+
+		for (auto &&thread : pool)
+			thread.join();
+
+		return results;
+	}
+
+	template<typename T>
+	bool Assembler<T>::convert(const std::filesystem::path &crPath, Mode mode) const
+	{
+		try
+		{
+			switch (mode)
+			{
+			case Mode::text2com: return compiler_.text2com(crPath);
+			case Mode::text2bin: return compiler_.text2bin(crPath);
+			case Mode::com2bin:  return compiler_.com2bin(crPath);
+			}
+		}
+		catch (const std::exception &exc) // Must not leave the thread, the other files go on
+		{
+			NDebugger::Error(crPath.generic_string() + ": " + exc.what(), std::cerr);
+		}
+
+		return false;
+	}
+
+#pragma endregion
+
+} // namespace NAssembler
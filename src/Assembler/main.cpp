@@ -0,0 +1,64 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <chrono>   // std::chrono::steady_clock
+#include <cstdlib>  // std::strtoul
+#include <iostream> // std::cout, std::cerr
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+#include "../Assembler.hpp"
+
+//====================================================================================================================================
+//!
+//! \brief	Assembles all the programms of the directories and files on all the cores, run it on deploy
+//!
+//! \note   Assembler [--com | --bin | --com2bin] [-j threads] <directory or file>...
+//!         --com (default) is text2com, --bin is text2bin, --com2bin converts the Com files. Returns 1 if any file failed
+//!
+//====================================================================================================================================
+
+int main(int argc, char *argv[])
+{
+	std::ios::sync_with_stdio(false);
+
+	NAssembler::Mode         mode    = NAssembler::Mode::text2com;
+	size_t                   threads = 0;
+	std::vector<std::string> paths;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg(argv[i]);
+
+		if      (arg == "--com")              mode    = NAssembler::Mode::text2com;
+		else if (arg == "--bin")              mode    = NAssembler::Mode::text2bin;
+		else if (arg == "--com2bin")          mode    = NAssembler::Mode::com2bin;
+		else if (arg == "-j" && i + 1 < argc) threads = std::strtoul(argv[++i], nullptr, 10);
+		else                                  paths.push_back(arg);
+	}
+
+	std::vector<std::filesystem::path> files; // The mode tells which files of the directories are sources
+	for (auto &&path : paths)
+		for (auto &&file : NAssembler::Collect(path, mode))
+			files.push_back(file);
+
+	if (files.empty())
+	{
+		std::cerr << "Usage: Assembler [--com | --bin | --com2bin] [-j threads] <directory or file>...\n";
+
+		return 2;
+	}
+
+	Logger::init();
+
+	NAssembler::Assembler<> assembler(threads);
+
+	auto start   = std::chrono::steady_clock::now();
+	auto results = assembler.run(files, mode);
+	auto finish  = std::chrono::steady_clock::now();
+
+	size_t failed = NAssembler::Report(results, std::chrono::duration<double, std::milli>(finish - start).count(), assembler.threads(), std::cout);
+
+	Logger::close();
+
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,200 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <algorithm> // std::min, std::remove_if
+#include <cstring>   // std::memcpy
+#include <ctime>     // std::time_t, std::tm
+#include <iomanip>   // std::setw, std::put_time
+
+#include "AsyncLog.hpp"
+
+namespace NLog
+{
+
+//====================================================================================================================================
+//=========================================================METHOD_DEFINITION==========================================================
+//====================================================================================================================================
+
+#pragma region METHOD_DEFINITION
+
+	AsyncBackend::AsyncBackend(std::ostream &rOstr) :
+		rOstr_(rOstr),
+		channels_(),
+		channelsMutex_(),
+		ioMutex_(),
+		batch_(),
+		running_(false),
+		stateMutex_(),
+		wakeUp_(),
+		worker_()
+	{
+		batch_.reserve(RING_SIZE);
+	}
+
+	AsyncBackend::~AsyncBackend()
+	{
+		stop();
+	}
+
+	void AsyncBackend::start()
+	{
+		if (running_.exchange(true)) return;
+
+		worker_ = std::thread(&AsyncBackend::run, this);
+	}
+
+	void AsyncBackend::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(stateMutex_);
+			if (!running_.exchange(false)) return;
+		}
+
+		wakeUp_.notify_one();
+		worker_.join();
+	}
+
+	bool AsyncBackend::running() const noexcept
+	{
+		return running_.load(std::memory_order_relaxed);
+	}
+
+	bool AsyncBackend::push(Level level, std::string_view func, std::string_view info) noexcept
+	{
+		if (!running()) return false;
+
+		Channel *pChannel = nullptr;
+		try
+		{
+			pChannel = channel();
+		}
+		catch (...)
+		{
+			return false;
+		}
+
+		long long time = std::chrono::system_clock::now().time_since_epoch().count();
+
+		bool pushed = pChannel->ring.push([&](Record &rRecord)
+		{
+			rRecord.time       = time;
+			rRecord.level      = level;
+			rRecord.funcLength = static_cast<unsigned char>(std::min(func.length(), FUNC_SIZE));
+			rRecord.infoLength = static_cast<unsigned char>(std::min(info.length(), INFO_SIZE));
+
+			std::memcpy(rRecord.func, func.data(), rRecord.funcLength);
+			std::memcpy(rRecord.info, info.data(), rRecord.infoLength);
+		});
+
+		if (!pushed)
+			pChannel->dropped.fetch_add(1, std::memory_order_relaxed);
+
+		return pushed;
+	}
+
+	std::unique_lock<std::recursive_mutex> AsyncBackend::lock()
+	{
+		std::unique_lock<std::recursive_mutex> lock(ioMutex_);
+
+		drain();
+
+		return lock;
+	}
+
+	AsyncBackend::Channel *AsyncBackend::channel()
+	{ // One backend per process is expected, the ring of the thread is registered on its first record
+		struct Holder
+		{
+			std::shared_ptr<Channel> pChannel;
+
+			~Holder()
+			{
+				if (pChannel) pChannel->retired.store(true, std::memory_order_release);
+			}
+		};
+
+		thread_local Holder holder;
+		if (!holder.pChannel)
+		{
+			auto pChannel = std::make_shared<Channel>();
+
+			std::lock_guard<std::mutex> lock(channelsMutex_);
+			channels_.push_back(pChannel);
+
+			holder.pChannel = std::move(pChannel);
+		}
+
+		return holder.pChannel.get();
+	}
+
+	void AsyncBackend::run()
+	{
+		std::unique_lock<std::mutex> lock(stateMutex_);
+		while (running_)
+		{
+			lock.unlock();
+			drain();
+			lock.lock();
+
+			wakeUp_.wait_for(lock, FLUSH_INTERVAL, [this] { return !running_; });
+		}
+		lock.unlock();
+
+		drain();
+	}
+
+	void AsyncBackend::drain()
+	{
+		std::lock_guard<std::recursive_mutex> ioLock(ioMutex_);
+
+		std::vector<std::pair<std::thread::id, size_t>> dropped;
+		{
+			std::lock_guard<std::mutex> lock(channelsMutex_);
+			for (auto &&pChannel : channels_)
+			{
+				Record record;
+				while (pChannel->ring.pop(record))
+					batch_.push_back(record);
+
+				if (size_t count = pChannel->dropped.load(std::memory_order_relaxed); count != pChannel->reported)
+				{
+					dropped.emplace_back(pChannel->owner, count - pChannel->reported);
+					pChannel->reported = count;
+				}
+			}
+
+			channels_.erase(std::remove_if(channels_.begin(), channels_.end(), [](auto &&pChannel) -> bool
+			{
+				return (pChannel->retired.load(std::memory_order_acquire) && pChannel->ring.empty());
+			}), channels_.end());
+		}
+
+		if (batch_.empty() && dropped.empty()) return;
+
+		std::sort(batch_.begin(), batch_.end(), [](const Record &crA, const Record &crB) { return (crA.time < crB.time); });
+		for (auto &&record : batch_)
+			format(record);
+
+		for (auto &&[owner, count] : dropped)
+			rOstr_ << "[WARNING][" << std::setw(FUNC_SIZE) << "Logger" << "] " << count << " records of thread " << owner << " were dropped\n";
+
+		rOstr_.flush();
+		batch_.clear();
+	}
+
+	void AsyncBackend::format(const Record &crRecord)
+	{
+		using std::chrono::system_clock;
+		std::time_t tt = system_clock::to_time_t(system_clock::time_point(system_clock::duration(crRecord.time)));
+
+		std::tm tm = LocalTime(tt);
+
+		rOstr_ << "[" << LevelName(crRecord.level) << "]["
+		       << std::put_time(&tm, "%X")
+		       << "][" << std::setw(FUNC_SIZE) << std::string_view(crRecord.func, crRecord.funcLength) << "] "
+		       << std::string_view(crRecord.info, crRecord.infoLength) << '\n';
+	}
+
+#pragma endregion
+
+} // namespace NLog
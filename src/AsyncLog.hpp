@@ -0,0 +1,311 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   AsyncLog.hpp
+//!
+//! \brief	Asynchronous log backend: callers put records to per-thread lock-free rings, a background thread writes them
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <atomic>             // std::atomic
+#include <array>              // std::array
+#include <chrono>             // std::chrono::milliseconds
+#include <condition_variable> // std::condition_variable
+#include <ctime>              // std::time_t, std::tm
+#include <memory>             // std::shared_ptr
+#include <mutex>              // std::mutex, std::recursive_mutex
+#include <ostream>            // std::ostream
+#include <string_view>        // std::string_view
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+namespace NLog
+{
+
+#pragma region CONSTANTS
+
+	constexpr size_t CACHE_LINE_SIZE = 1 << 6;
+	constexpr size_t RECORD_SIZE     = 1 << 8;
+	constexpr size_t FUNC_SIZE       = 1 << 6;
+	constexpr size_t INFO_SIZE       = RECORD_SIZE - FUNC_SIZE - (1 << 4);
+	constexpr size_t RING_SIZE       = 1 << 10; // Records per thread, must be a power of two
+
+	constexpr std::chrono::milliseconds FLUSH_INTERVAL(1 << 4);
+
+#pragma endregion
+
+#pragma region ENUMS
+
+	enum class Level : unsigned char
+	{
+		Trace,
+		Debug,
+		Info,
+		Warning,
+		Error,
+		Off
+	};
+
+	enum class Subsystem : unsigned char
+	{
+		General,
+		Parser,
+		Stack,
+		Ram,
+		Register,
+		CPU,
+		Compiler,
+
+		NUM
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+	constexpr std::string_view LevelName(Level level) noexcept;
+
+	inline std::tm LocalTime(std::time_t time) noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+//====================================================================================================================================
+//!
+//! \brief	Fixed-size log record, strings longer than the fields are truncated
+//!
+//====================================================================================================================================
+
+	struct Record final
+	{
+		long long     time; // std::chrono::system_clock ticks
+		Level         level;
+		unsigned char funcLength,
+		              infoLength;
+		char          func[FUNC_SIZE],
+		              info[INFO_SIZE];
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Lock-free ring buffer for one producer and one consumer
+//!
+//====================================================================================================================================
+
+	template<typename T, size_t SIZE>
+	class RingBuffer final
+	{
+	public:
+		explicit RingBuffer() noexcept;
+		RingBuffer(const RingBuffer&) = delete;
+		RingBuffer(RingBuffer&&)      = delete;
+		~RingBuffer()                 = default;
+
+		RingBuffer &operator=(const RingBuffer&) = delete;
+		RingBuffer &operator=(RingBuffer&&)      = delete;
+
+//====================================================================================================================================
+//!
+//! \brief	 Fills the next free slot in place (producer side)
+//!
+//! \param   fill  Callable taking T&
+//!
+//! \return  False if the ring is full, fill is not called then
+//!
+//====================================================================================================================================
+
+		template<typename Fill>
+		bool push(Fill fill) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Takes the oldest element (consumer side)
+//!
+//! \param   rVal  Where to put the element
+//!
+//! \return  False if the ring is empty
+//!
+//====================================================================================================================================
+
+		bool pop(T &rVal) noexcept;
+
+		bool empty() const noexcept;
+
+	private:
+		static constexpr size_t MASK = SIZE - 1;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_; // Written only by the producer
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_; // Written only by the consumer
+		alignas(CACHE_LINE_SIZE) std::array<T, SIZE> buf_;
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Collects records from all the threads and writes them to the stream in batches on its own thread
+//!
+//! \note   Producers never block on the stream, records which do not fit their ring are dropped and counted
+//!
+//====================================================================================================================================
+
+	class AsyncBackend final
+	{
+	public:
+		explicit AsyncBackend(std::ostream &rOstr);
+		AsyncBackend(const AsyncBackend&) = delete;
+		AsyncBackend(AsyncBackend&&)      = delete;
+		~AsyncBackend();
+
+		AsyncBackend &operator=(const AsyncBackend&) = delete;
+		AsyncBackend &operator=(AsyncBackend&&)      = delete;
+
+		void start();
+
+//====================================================================================================================================
+//!
+//! \brief	Stops the background thread, all the pending records are written
+//!
+//====================================================================================================================================
+
+		void stop();
+
+		bool running() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Puts the record to the ring of the calling thread, never waits for the stream
+//!
+//! \param   level  Level of the record
+//! \param   func   Where the record comes from
+//! \param   info   Message
+//!
+//! \return  False if the backend is not running or the record was dropped
+//!
+//====================================================================================================================================
+
+		bool push(Level level, std::string_view func, std::string_view info) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Writes all the pending records and keeps the background thread off the stream
+//!
+//! \return  Lock, the stream may be written directly while it is held
+//!
+//====================================================================================================================================
+
+		std::unique_lock<std::recursive_mutex> lock();
+
+	private:
+		struct Channel
+		{
+			RingBuffer<Record, RING_SIZE> ring;
+			std::atomic<size_t>           dropped  = 0;
+			size_t                        reported = 0; // Used only by the consumer
+			std::atomic<bool>             retired  = false;
+			std::thread::id               owner    = std::this_thread::get_id();
+		};
+
+		std::ostream                          &rOstr_;
+		std::vector<std::shared_ptr<Channel>>  channels_;
+		std::mutex                             channelsMutex_;
+		std::recursive_mutex                   ioMutex_; // Owner of the stream
+		std::vector<Record>                    batch_;
+
+		std::atomic<bool>                      running_;
+		std::mutex                             stateMutex_;
+		std::condition_variable                wakeUp_;
+		std::thread                            worker_;
+
+		Channel *channel();
+
+		void run();
+		void drain();
+		void format(const Record &crRecord);
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	constexpr std::string_view LevelName(Level level) noexcept
+	{
+		switch (level)
+		{
+		case Level::Trace:   return "TRACE";
+		case Level::Debug:   return "DEBUG";
+		case Level::Info:    return "INFO";
+		case Level::Warning: return "WARNING";
+		case Level::Error:   return "ERROR";
+		default:             return "null";
+		}
+	}
+
+	inline std::tm LocalTime(std::time_t time) noexcept
+	{
+		std::tm tm = { };
+
+#ifdef _WIN32
+		localtime_s(&tm, &time);
+#else
+		localtime_r(&time, &tm);
+#endif // _WIN32
+
+		return tm;
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	template<typename T, size_t SIZE>
+	inline RingBuffer<T, SIZE>::RingBuffer() noexcept :
+		head_(NULL),
+		tail_(NULL),
+		buf_()
+	{
+		static_assert(SIZE && !(SIZE & MASK), "Size of the ring must be a power of two\n");
+	}
+
+	template<typename T, size_t SIZE>
+	template<typename Fill>
+	inline bool RingBuffer<T, SIZE>::push(Fill fill) noexcept
+	{
+		size_t head = head_.load(std::memory_order_relaxed);
+		if (head - tail_.load(std::memory_order_acquire) == SIZE)
+			return false;
+
+		fill(buf_[head & MASK]);
+		head_.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, size_t SIZE>
+	inline bool RingBuffer<T, SIZE>::pop(T &rVal) noexcept
+	{
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		if (tail == head_.load(std::memory_order_acquire))
+			return false;
+
+		rVal = buf_[tail & MASK];
+		tail_.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, size_t SIZE>
+	inline bool RingBuffer<T, SIZE>::empty() const noexcept
+	{
+		return (tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire));
+	}
+
+#pragma endregion
+
+} // namespace NLog
@@ -0,0 +1,154 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   AtomicFile.hpp
+//!
+//! \brief	Output file which appears at once: it is written to a temporary next to the target and renamed over it on commit
+//!
+//! \note   Readers see the old file or the whole new one, never a part of it. The temporary is removed if the output is
+//!         not committed (an error in the middle of a conversion), so a failed conversion leaves no output.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <atomic>     // std::atomic
+#include <filesystem> // std::filesystem::path, std::filesystem::rename
+#include <fstream>    // std::ofstream
+#include <random>     // std::random_device
+#include <string>     // std::to_string
+
+namespace NAtomicFile
+{
+
+#pragma region CLASSES
+
+	class Output final
+	{
+	public:
+		explicit Output(const std::filesystem::path &crPath, std::ios::openmode mode = std::ios::out);
+		Output(const Output&) = delete;
+		Output(Output&&)      = delete;
+		~Output();
+
+		Output &operator=(const Output&) = delete;
+		Output &operator=(Output&&)      = delete;
+
+		bool is_open() const;
+
+		template<typename U>
+		Output &operator<<(const U &crVal);
+
+//====================================================================================================================================
+//!
+//! \brief	 Closes the file and replaces the target with it
+//!
+//! \return  False if the file could not be written or renamed, the target is left as it was then
+//!
+//====================================================================================================================================
+
+		bool commit();
+
+//====================================================================================================================================
+//!
+//! \brief	 Closes the file and removes it, the target is left as it was
+//!
+//====================================================================================================================================
+
+		void close();
+
+	private:
+		std::filesystem::path path_,
+		                      temp_; // Unique among the threads and processes writing the same target
+		std::ofstream         file_;
+		bool                  done_ = false;
+
+		static std::filesystem::path tempFor(const std::filesystem::path &crPath);
+	};
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Output::Output(const std::filesystem::path &crPath, std::ios::openmode mode /* = std::ios::out */) :
+		path_(crPath),
+		temp_(tempFor(crPath)),
+		file_(temp_, mode | std::ios::out | std::ios::trunc)
+	{ }
+
+	inline Output::~Output()
+	{
+		close();
+	}
+
+	inline bool Output::is_open() const
+	{
+		return file_.is_open();
+	}
+
+	template<typename U>
+	inline Output &Output::operator<<(const U &crVal)
+	{
+		file_ << crVal;
+
+		return (*this);
+	}
+
+	inline bool Output::commit()
+	{
+		if (done_) return false;
+
+		file_.close();
+		if (!file_)
+		{
+			close();
+
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temp_, path_, error); // Replaces the target in one step
+		if (error)
+		{
+			close();
+
+			return false;
+		}
+
+		done_ = true;
+
+		return true;
+	}
+
+	inline void Output::close()
+	{
+		if (done_) return;
+
+		if (file_.is_open())
+			file_.close();
+
+		std::error_code error;
+		std::filesystem::remove(temp_, error);
+
+		done_ = true;
+	}
+
+	inline std::filesystem::path Output::tempFor(const std::filesystem::path &crPath)
+	{
+		static const unsigned      PROCESS = std::random_device{}(); // Tells the processes apart
+		static std::atomic<size_t> counter = NULL;                   // Tells the outputs of this process apart
+
+		std::filesystem::path temp = crPath;
+		temp += ".tmp" + std::to_string(PROCESS) + "." + std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+
+		return temp;
+	}
+
+#pragma endregion
+
+} // namespace NAtomicFile
@@ -0,0 +1,114 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <cstdlib>  // std::strtod
+#include <fstream>  // std::ifstream
+#include <iomanip>  // std::setw, std::setprecision
+#include <iostream> // std::cout, std::cerr
+#include <string>   // std::string
+#include <vector>   // std::vector
+
+#include "../Benchmarks/BenchmarkResults.hpp"
+
+//====================================================================================================================================
+//!
+//! \brief	Compares two JSON files of the Benchmarks project, run it before a version of the VM is pinned
+//!
+//! \note   BenchCompare <baseline.json> <current.json> [--threshold 5] [--alpha 0.05]
+//!         A benchmark regressed if its median time per instruction grew more than threshold percents
+//!         and the Mann-Whitney test says it is not noise (p < alpha). Returns 1 if anything regressed
+//!
+//====================================================================================================================================
+
+using NBenchmarks::Result;
+
+bool Load(const char *pPath, std::vector<Result> &rResults)
+{
+	std::ifstream file(pPath);
+	if (file && NBenchmarks::ReadJson(file, rResults)) return true;
+
+	std::cerr << "Not a benchmark results file: " << pPath << '\n';
+
+	return false;
+}
+
+const Result *Find(const std::vector<Result> &crResults, const Result &crKey)
+{ // Benchmarks of different guard levels are different benchmarks
+	for (auto &&result : crResults)
+		if (result.program == crKey.program && result.mode == crKey.mode && result.type == crKey.type && result.guardLevel == crKey.guardLevel)
+			return &result;
+
+	return nullptr;
+}
+
+std::vector<double> PerInstruction(const Result &crResult)
+{ // Programms may change between the versions, time of the instruction is compared
+	std::vector<double> samples;
+	for (auto &&run : crResult.runs)
+		samples.push_back(run / (crResult.instructions ? crResult.instructions : 1));
+
+	return samples;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		std::cerr << "Usage: BenchCompare <baseline.json> <current.json> [--threshold 5] [--alpha 0.05]\n";
+
+		return 2;
+	}
+
+	double threshold = 5.,
+	       alpha     = .05;
+	for (int i = 3; i + 1 < argc; i += 2)
+	{
+		if      (std::string(argv[i]) == "--threshold") threshold = std::strtod(argv[i + 1], nullptr);
+		else if (std::string(argv[i]) == "--alpha")     alpha     = std::strtod(argv[i + 1], nullptr);
+	}
+
+	std::vector<Result> base,
+	                    current;
+	if (!Load(argv[1], base) || !Load(argv[2], current)) return 2;
+
+	std::cout << std::left  << std::setw(40) << "benchmark"
+	          << std::right << std::setw(12) << "base ns/op" << std::setw(12) << "new ns/op" << std::setw(10) << "change" << std::setw(10) << "p" << "  verdict\n"
+	          << std::fixed;
+
+	size_t regressions = 0;
+	for (auto &&result : current)
+	{
+		const Result *pBase = Find(base, result);
+		if (!pBase)
+		{
+			std::cout << std::left << std::setw(40) << result.name() << " no baseline\n";
+			continue;
+		}
+
+		auto   baseSamples = PerInstruction(*pBase),
+		       newSamples  = PerInstruction(result);
+		double baseP50     = NBenchmarks::Percentile(baseSamples, 50.),
+		       newP50      = NBenchmarks::Percentile(newSamples,  50.),
+		       change      = (baseP50 > 0. ? (newP50 / baseP50 - 1.) * 100. : 0.),
+		       slower      = NBenchmarks::MannWhitney(baseSamples, newSamples),
+		       faster      = NBenchmarks::MannWhitney(newSamples,  baseSamples);
+
+		const char *pVerdict = "";
+		double      p        = (change >= 0. ? slower : faster);
+		if      (change >  threshold && slower < alpha) pVerdict = "REGRESSION", regressions++;
+		else if (change < -threshold && faster < alpha) pVerdict = "improvement";
+
+		std::cout << std::left  << std::setw(40) << result.name()
+		          << std::right << std::setprecision(3) << std::setw(12) << baseP50 << std::setw(12) << newP50
+		          << std::setprecision(1) << std::setw(9) << change << '%'
+		          << std::setprecision(3) << std::setw(10) << p << "  " << pVerdict << '\n';
+	}
+
+	for (auto &&result : base)
+		if (!Find(current, result))
+			std::cout << std::left << std::setw(40) << result.name() << " missing in " << argv[2] << '\n';
+
+	std::cout << regressions << " regressions\n";
+
+	return (regressions ? 1 : 0);
+}
@@ -0,0 +1,379 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   AssemblerBenchmarks.hpp
+//!
+//! \brief	Throughput of the assembler front end in MB/s on big synthetic sources: byte classification, lexing and the converters,
+//!         the cost of one mnemonic or register lookup, the scaling of the parallel assembler with the threads,
+//!         the one of a single big source split into chunks and the load of a programm from the cache of images against the one from its source
+//!
+//! \note   The sources are written to the temporary directory and removed after the benchmarks.
+//!         Build with -mavx2 (/arch:AVX2) to measure the AVX2 scanner, with -DNO_SIMD to measure the table one in the lexer.
+//!
+//====================================================================================================================================
+
+#include <algorithm>   // std::find_if
+#include <array>       // std::array
+#include <chrono>      // std::chrono::steady_clock
+#include <cstdint>     // uint64_t
+#include <filesystem>  // std::filesystem::path, std::filesystem::temp_directory_path
+#include <fstream>     // std::ofstream
+#include <iostream>    // std::cout
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <thread>      // std::thread::hardware_concurrency
+#include <type_traits> // std::is_same_v, std::invoke_result_t
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+#include "BenchmarkResults.hpp"
+#include "BenchmarkUtils.hpp"
+
+#include "../Assembler.hpp"
+#include "../Compiler.hpp"
+#include "../Scanner.hpp"
+
+namespace NAssemblerBenchmarks
+{
+	using namespace NBenchmarks;
+
+	using NCompiler::Compiler;
+
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+	constexpr size_t           SOURCE_SIZE = 1 << 25; // 32 MiB, far bigger than the caches
+	constexpr std::string_view SOURCE_NAME = "AssemblerBenchmark";
+
+	constexpr size_t           FUNCTIONS = 1 << 6;  // Called by the loops of the sources
+
+	constexpr size_t           FILES     = 1 << 6;  // Programms of the parallel assembler
+	constexpr size_t           FILE_SIZE = 1 << 19; // 512 KiB each
+
+	constexpr std::array<std::pair<std::string_view, size_t>, 2> SOURCES
+	{ {
+		{ "short lines", 0   }, // Length of the names of the labels and functions
+		{ "long lines",  120 }
+	} };
+
+//====================================================================================================================================
+//========================================================FUNCTION_DECLARATION========================================================
+//====================================================================================================================================
+
+//====================================================================================================================================
+//!
+//! \brief	 Makes a programm of loops and calls of FUNCTIONS functions placed after its end, every line is a valid instruction or label
+//!
+//! \param   size         Minimum size in bytes
+//! \param   nameLength   Length added to the names of the labels and functions
+//!
+//====================================================================================================================================
+
+	std::string MakeSource(size_t size, size_t nameLength);
+
+//====================================================================================================================================
+//!
+//! \brief	Runs func the given number of times and reports the median in MB/s of the source
+//!
+//! \param  name   Name of the benchmark
+//! \param  bytes  Size of the source
+//! \param  runs   Number of runs
+//! \param  func   Benchmark body, the benchmark is reported as failed if it returns false
+//!
+//====================================================================================================================================
+
+	template<typename Func>
+	void Throughput(std::string_view name, size_t bytes, size_t runs, Func func);
+
+	void RunSource(std::string_view name, size_t nameLength, size_t runs);
+
+//====================================================================================================================================
+//!
+//! \brief	Compares the perfect hash lookups with the linear search over the table they replaced
+//!
+//====================================================================================================================================
+
+	void RunLookup();
+
+//====================================================================================================================================
+//!
+//! \brief	Converts the same programms by the pool of one thread, then of two, four... up to a thread per core
+//!
+//====================================================================================================================================
+
+	void RunParallel(size_t runs);
+
+//====================================================================================================================================
+//!
+//! \brief	Loads a big programm which ends at once from its source, then from its image in the cache
+//!
+//====================================================================================================================================
+
+	void RunCache(size_t runs);
+
+//====================================================================================================================================
+//!
+//! \brief	Converts and loads one big programm by one thread, then by two, four... up to a thread per core, each lexes a chunk
+//!
+//====================================================================================================================================
+
+	void RunChunked(size_t runs);
+
+	void RunAllBenchmarks(size_t runs);
+
+//====================================================================================================================================
+//========================================================FUNCTION_DEFINITION=========================================================
+//====================================================================================================================================
+
+	std::string MakeSource(size_t size, size_t nameLength)
+	{
+		std::string source,
+		            suffix(nameLength, 'x');
+		source.reserve(size + (1 << 12));
+
+		for (size_t i = 0; source.length() < size; i++)
+		{
+			std::string loop = "loop" + std::to_string(i) + suffix,
+			            func = "func" + std::to_string(i % FUNCTIONS) + suffix;
+
+			source += ":" + loop + "\n"
+			          "    push " + std::to_string(i) + "\n"
+			          "    move 0, ax\n"
+			          "    push [ax]\n"
+			          "    add\n"
+			          "    dup\n"
+			          "    push 0\n"
+			          "    jb " + loop + "\n"
+			          "    call " + func + "\n";
+		}
+		source += "end\n";
+
+		for (size_t i = 0; i < FUNCTIONS; i++)
+			source += "func" + std::to_string(i) + suffix + ":\n"
+			          "    ret\n";
+
+		return source;
+	}
+
+	template<typename Func>
+	void Throughput(std::string_view name, size_t bytes, size_t runs, Func func)
+	{
+		std::vector<double> times;
+		bool                ok = true;
+		for (size_t run = 0; run < runs; run++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			if constexpr (std::is_same_v<std::invoke_result_t<Func>, bool>) ok = func() && ok;
+			else                                                             func();
+			auto finish = std::chrono::steady_clock::now();
+
+			times.push_back(std::chrono::duration<double, std::nano>(finish - start).count());
+		}
+
+		if (!ok)
+		{
+			std::cout << name << " failed" << std::endl;
+			return;
+		}
+
+		ReportThroughput(name, Percentile(times, 50.), bytes);
+	}
+
+	void RunSource(std::string_view name, size_t nameLength, size_t runs)
+	{
+		std::string source = MakeSource(SOURCE_SIZE, nameLength),
+		            prefix = std::string(name) + " ";
+		size_t      blocks = source.length() / NScanner::BLOCK;
+
+		Throughput(prefix + "classify scalar", source.length(), runs, [&]
+		{
+			uint64_t sum = 0;
+			for (size_t i = 0; i < blocks; i++)
+			{
+				auto masks = NScanner::ClassifyScalar(source.data() + i * NScanner::BLOCK);
+				sum += masks.tokens ^ masks.newlines;
+			}
+			DoNotOptimize(sum);
+		});
+
+		Throughput(prefix + "classify " + std::string(NScanner::ISA), source.length(), runs, [&]
+		{
+			uint64_t sum = 0;
+			for (size_t i = 0; i < blocks; i++)
+			{
+				auto masks = NScanner::Classify(source.data() + i * NScanner::BLOCK);
+				sum += masks.tokens ^ masks.newlines;
+			}
+			DoNotOptimize(sum);
+		});
+
+		Throughput(prefix + "lex", source.length(), runs, [&]
+		{
+			NParser::Lexer     lexer(source);
+			NParser::Statement statement{};
+
+			size_t statements = 0;
+			while (lexer.next(statement))
+				statements++;
+			DoNotOptimize(statements);
+		});
+
+		auto path = std::filesystem::temp_directory_path() / SOURCE_NAME;
+		{
+			std::ofstream file(path.generic_string() + ".txt", std::ios::binary);
+			file.write(source.data(), static_cast<std::streamsize>(source.length()));
+		}
+
+		Throughput(prefix + "read", source.length(), runs, [&]
+		{
+			std::string text;
+			NParser::ReadSource(path.generic_string() + ".txt", text);
+			DoNotOptimize(text.length());
+		});
+
+		Compiler<int> comp;
+		Throughput(prefix + "text2com", source.length(), runs, [&] { return comp.text2com(path); });
+		Throughput(prefix + "text2bin", source.length(), runs, [&] { return comp.text2bin(path); });
+		Throughput(prefix + "com2bin",  source.length(), runs, [&] { return comp.com2bin(path); }); // MB of the text source too
+
+		for (std::string_view suffix : { ".txt", "Com.txt", "BinText.txt", "BinCom.txt" })
+			std::filesystem::remove(path.generic_string() + std::string(suffix));
+	}
+
+	void RunLookup()
+	{
+		typedef NCpu::Commands::CPU_COMMANDS table_t;
+
+		std::array<std::string_view, 1024> names{}; // Commands as they come in a programm, every eighth is a label
+		for (size_t i = 0; i < names.size(); i++)
+			names[i] = (i % 8 ? table_t::buf[i * 7 % table_t::buf.size()].name : std::string_view("loop"));
+
+		Report("lookup mnemonic linear", Measure([&](size_t iterations)
+		{
+			size_t sum = 0;
+			for (size_t i = 0; i < iterations; i++)
+			{
+				auto name = names[i % names.size()];
+				sum += static_cast<size_t>(std::find_if(table_t::cbegin(), table_t::cend(), [&](auto &&com) -> bool { return (com.name == name); }) - table_t::cbegin());
+			}
+			DoNotOptimize(sum);
+		}));
+
+		Report("lookup mnemonic hash", Measure([&](size_t iterations)
+		{
+			size_t sum = 0;
+			for (size_t i = 0; i < iterations; i++)
+				sum += static_cast<size_t>(table_t::find(names[i % names.size()]) - table_t::cbegin());
+			DoNotOptimize(sum);
+		}));
+
+		Report("lookup register hash", Measure([&](size_t iterations)
+		{
+			size_t sum = 0;
+			for (size_t i = 0; i < iterations; i++)
+				sum += static_cast<size_t>(NRegister::MakeReg(NRegister::REG_NAMES[i % NRegister::REG_NAMES.size()]));
+			DoNotOptimize(sum);
+		}));
+	}
+
+	void RunParallel(size_t runs)
+	{
+		auto dir = std::filesystem::temp_directory_path() / SOURCE_NAME;
+		std::filesystem::create_directory(dir);
+
+		std::string source = MakeSource(FILE_SIZE, 0);
+		for (size_t i = 0; i < FILES; i++)
+		{
+			std::ofstream file(dir / ("programm" + std::to_string(i) + ".txt"), std::ios::binary);
+			file.write(source.data(), static_cast<std::streamsize>(source.length()));
+		}
+
+		auto   files = NAssembler::Collect(dir, NAssembler::Mode::text2com);
+		size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+		for (size_t threads = 1; ; threads = std::min(threads * 2, cores))
+		{
+			NAssembler::Assembler<int> assembler(threads);
+			Throughput("parallel text2com " + std::to_string(threads) + " threads", source.length() * FILES, runs, [&]
+			{
+				DoNotOptimize(assembler.run(files, NAssembler::Mode::text2com).size());
+			});
+
+			if (threads == cores) break;
+		}
+
+		std::filesystem::remove_all(dir);
+	}
+
+	void RunCache(size_t runs)
+	{
+		auto dir  = std::filesystem::temp_directory_path() / SOURCE_NAME;
+		auto path = dir / "programm";
+		std::filesystem::create_directory(dir);
+
+		std::string source = "end\n" + MakeSource(SOURCE_SIZE / 4, 0); // Only loaded, the run ends at the first instruction
+		{
+			std::ofstream file(path.generic_string() + ".txt", std::ios::binary);
+			file.write(source.data(), static_cast<std::streamsize>(source.length()));
+		}
+
+		Compiler<int> plain;
+		Throughput("load source", source.length(), runs, [&] { return plain.fromTextFile(path); });
+
+		Compiler<int> cached;
+		if (!cached.startCache(dir / "images") || !cached.fromTextFile(path)) // Writes the image
+			std::cout << "load cached image can not be prepared" << std::endl;
+		else
+		{
+			Throughput("load cached image", source.length(), runs, [&] { return cached.fromTextFile(path); });
+			if (cached.cache()->hits() < runs) std::cout << "load cached image missed the cache" << std::endl;
+		}
+
+		std::filesystem::remove_all(dir);
+	}
+
+	void RunChunked(size_t runs)
+	{
+		auto path = std::filesystem::temp_directory_path() / SOURCE_NAME;
+
+		std::string source = "end\n" + MakeSource(SOURCE_SIZE, 0); // Only loaded, the run ends at the first instruction
+		{
+			std::ofstream file(path.generic_string() + ".txt", std::ios::binary);
+			file.write(source.data(), static_cast<std::streamsize>(source.length()));
+		}
+
+		size_t cores = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+		for (size_t threads = 1; ; threads = std::min(threads * 2, cores))
+		{
+			Compiler<int> comp;
+			comp.setThreads(threads);
+
+			std::string suffix = " " + std::to_string(threads) + " threads";
+			Throughput("chunked text2com" + suffix, source.length(), runs, [&] { return comp.text2com(path); });
+			Throughput("chunked load"     + suffix, source.length(), runs, [&] { return comp.fromTextFile(path); });
+
+			if (threads == cores) break;
+		}
+
+		for (std::string_view suffix : { ".txt", "Com.txt" })
+			std::filesystem::remove(path.generic_string() + std::string(suffix));
+	}
+
+	void RunAllBenchmarks(size_t runs)
+	{
+		std::cout << "[ASSEMBLER BENCHMARKS] " << NScanner::ISA << std::endl;
+
+		RunLookup();
+
+		for (auto &&[name, nameLength] : SOURCES)
+			RunSource(name, nameLength, runs);
+
+		RunParallel(runs);
+		RunCache(runs);
+		RunChunked(runs);
+
+		std::cout << std::endl;
+	}
+
+} // namespace NAssemblerBenchmarks
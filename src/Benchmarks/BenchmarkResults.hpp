@@ -0,0 +1,409 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   BenchmarkResults.hpp
+//!
+//! \brief	Results of the VM benchmarks: JSON output and input, percentiles and the significance test used by BenchCompare
+//!
+//! \note   { "version": 1, "results": [ { "program", "mode", "type", "guard_level", "instructions",
+//!                                        "ops_per_sec", "p50_ns", "p99_ns", "runs_ns": [ ... ] }, ... ] }
+//!         ops_per_sec, p50_ns and p99_ns are derived from runs_ns, the reader takes only runs_ns
+//!
+//====================================================================================================================================
+
+#include <algorithm>   // std::sort, std::fill, std::min, std::max
+#include <cctype>      // std::isspace
+#include <cmath>       // std::ceil, std::sqrt, std::erfc
+#include <cstdlib>     // std::strtod
+#include <iomanip>     // std::setprecision
+#include <istream>     // std::istream
+#include <iterator>    // std::istreambuf_iterator
+#include <ostream>     // std::ostream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <utility>     // std::move, std::swap
+#include <vector>      // std::vector
+
+namespace NBenchmarks
+{
+
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+	constexpr unsigned RESULTS_VERSION  = 1;
+	constexpr size_t   MAX_EXACT_PAIRS  = 1 << 10; // Bigger samples are tested with the normal approximation
+
+//====================================================================================================================================
+//==============================================================STRUCTS===============================================================
+//====================================================================================================================================
+
+	struct Result
+	{
+		std::string         program,
+		                    mode,
+		                    type;
+		int                 guardLevel   = 0;
+		size_t              instructions = 0;
+		std::vector<double> runs; // Nanoseconds of every run
+
+		std::string name() const;
+	};
+
+//====================================================================================================================================
+//========================================================FUNCTION_DECLARATION========================================================
+//====================================================================================================================================
+
+//====================================================================================================================================
+//!
+//! \brief	 Nearest-rank percentile
+//!
+//! \param   samples  Samples, copied to be sorted
+//! \param   percent  Percentile from 0 to 100
+//!
+//! \return  The sample, 0 if there are none
+//!
+//====================================================================================================================================
+
+	inline double Percentile(std::vector<double> samples, double percent);
+
+//====================================================================================================================================
+//!
+//! \brief	 One-sided Mann-Whitney U test, does not assume the run times are normally distributed
+//!
+//! \param   crBase     Samples of the baseline
+//! \param   crCurrent  Samples to check
+//!
+//! \return  Probability to see current samples this much bigger than base ones if they are not bigger (p-value)
+//!
+//====================================================================================================================================
+
+	inline double MannWhitney(const std::vector<double> &crBase, const std::vector<double> &crCurrent);
+
+	inline void WriteJson(std::ostream &rOstr, const std::vector<Result> &crResults);
+
+//====================================================================================================================================
+//!
+//! \brief	 Reads the results written by WriteJson(), unknown keys are skipped
+//!
+//! \param   rIstr      Stream to read
+//! \param   rResults   Where to put the results
+//!
+//! \return  False if the input is not valid
+//!
+//====================================================================================================================================
+
+	inline bool ReadJson(std::istream &rIstr, std::vector<Result> &rResults);
+
+//====================================================================================================================================
+//==============================================================CLASSES===============================================================
+//====================================================================================================================================
+
+//====================================================================================================================================
+//!
+//! \brief	Recursive descent reader of the results, only JSON features WriteJson() uses are supported
+//!
+//====================================================================================================================================
+
+	class JsonReader final
+	{
+	public:
+		explicit JsonReader(std::string_view text) noexcept;
+
+		bool results(std::vector<Result> &rResults);
+
+	private:
+		std::string_view text_;
+		size_t           pos_;
+
+		bool result(Result &rResult);
+
+		bool expect(char ch) noexcept;
+		bool peek(char ch) noexcept;
+		bool string(std::string &rStr);
+		bool number(double &rVal);
+		bool numbers(std::vector<double> &rVals);
+		bool skip();
+	};
+
+//====================================================================================================================================
+//========================================================FUNCTION_DEFINITION=========================================================
+//====================================================================================================================================
+
+	inline std::string Result::name() const
+	{
+		return (program + "<" + type + ">/" + mode);
+	}
+
+	inline double Percentile(std::vector<double> samples, double percent)
+	{
+		if (samples.empty()) return 0.;
+
+		std::sort(samples.begin(), samples.end());
+
+		auto rank = static_cast<size_t>(std::ceil(percent / 100. * samples.size()));
+
+		return samples[std::min(std::max(rank, size_t(1)), samples.size()) - 1];
+	}
+
+	inline double MannWhitney(const std::vector<double> &crBase, const std::vector<double> &crCurrent)
+	{
+		size_t n1 = crCurrent.size(),
+		       n2 = crBase.size();
+		if (!n1 || !n2) return 1.;
+
+		double u = 0.; // Pairs where the current sample is bigger
+		for (auto &&cur : crCurrent)
+			for (auto &&base : crBase)
+				u += (cur > base ? 1. : (cur == base ? .5 : 0.));
+
+		if (n1 * n2 > MAX_EXACT_PAIRS)
+		{
+			double mean  = n1 * n2 / 2.,
+			       sigma = std::sqrt(n1 * n2 * (n1 + n2 + 1) / 12.);
+
+			return std::erfc((u - .5 - mean) / sigma / std::sqrt(2.)) / 2.;
+		}
+
+		// counts[i][j][k] is the number of orderings of i current and j base samples with U == k, only the last i is kept
+		size_t maxU = n1 * n2;
+		std::vector<std::vector<double>> prev(n2 + 1, std::vector<double>(maxU + 1, 0.)),
+		                                 next(n2 + 1, std::vector<double>(maxU + 1, 0.));
+		for (size_t j = 0; j <= n2; j++)
+			prev[j][0] = 1.;
+
+		for (size_t i = 1; i <= n1; i++)
+		{
+			for (auto &&row : next)
+				std::fill(row.begin(), row.end(), 0.);
+
+			next[0][0] = 1.;
+			for (size_t j = 1; j <= n2; j++)
+				for (size_t k = 0; k <= maxU; k++)
+					next[j][k] = (k >= j ? prev[j][k - j] : 0.) + next[j - 1][k]; // The biggest sample is current or base
+
+			std::swap(prev, next);
+		}
+
+		double total = 0.,
+		       tail  = 0.;
+		auto   from  = static_cast<size_t>(std::ceil(u));
+		for (size_t k = 0; k <= maxU; k++)
+		{
+			total += prev[n2][k];
+			if (k >= from) tail += prev[n2][k];
+		}
+
+		return tail / total;
+	}
+
+	inline void WriteJson(std::ostream &rOstr, const std::vector<Result> &crResults)
+	{
+		auto flags = rOstr.flags();
+		rOstr << std::fixed << std::setprecision(1);
+
+		rOstr << "{\n  \"version\": " << RESULTS_VERSION << ",\n  \"results\": [";
+		for (size_t i = 0; i < crResults.size(); i++)
+		{
+			auto &&result = crResults[i];
+			double p50    = Percentile(result.runs, 50.);
+
+			rOstr << (i ? ",\n" : "\n")
+			      << "    {\n"
+			      << "      \"program\": \"" << result.program << "\",\n"
+			      << "      \"mode\": \"" << result.mode << "\",\n"
+			      << "      \"type\": \"" << result.type << "\",\n"
+			      << "      \"guard_level\": " << result.guardLevel << ",\n"
+			      << "      \"instructions\": " << result.instructions << ",\n"
+			      << "      \"ops_per_sec\": " << (p50 > 0. ? result.instructions * 1e9 / p50 : 0.) << ",\n"
+			      << "      \"p50_ns\": " << p50 << ",\n"
+			      << "      \"p99_ns\": " << Percentile(result.runs, 99.) << ",\n"
+			      << "      \"runs_ns\": [";
+
+			for (size_t run = 0; run < result.runs.size(); run++)
+				rOstr << (run ? ", " : "") << result.runs[run];
+
+			rOstr << "]\n    }";
+		}
+		rOstr << "\n  ]\n}\n";
+
+		rOstr.flags(flags);
+	}
+
+	inline bool ReadJson(std::istream &rIstr, std::vector<Result> &rResults)
+	{
+		std::string text((std::istreambuf_iterator<char>(rIstr)), std::istreambuf_iterator<char>());
+
+		return JsonReader(text).results(rResults);
+	}
+
+//====================================================================================================================================
+//=========================================================METHOD_DEFINITION==========================================================
+//====================================================================================================================================
+
+	inline JsonReader::JsonReader(std::string_view text) noexcept :
+		text_(text),
+		pos_(NULL)
+	{ }
+
+	inline bool JsonReader::results(std::vector<Result> &rResults)
+	{
+		if (!expect('{')) return false;
+
+		while (!peek('}'))
+		{
+			std::string key;
+			if (!string(key) || !expect(':')) return false;
+
+			if (key == "results")
+			{
+				if (!expect('[')) return false;
+
+				while (!peek(']'))
+				{
+					Result record;
+					if (!result(record)) return false;
+
+					rResults.push_back(std::move(record));
+					peek(',');
+				}
+			}
+			else if (!skip()) return false;
+
+			peek(',');
+		}
+
+		return true;
+	}
+
+	inline bool JsonReader::result(Result &rResult)
+	{
+		if (!expect('{')) return false;
+
+		while (!peek('}'))
+		{
+			std::string key;
+			if (!string(key) || !expect(':')) return false;
+
+			double val = 0.;
+			bool   ok  = true;
+			if      (key == "program")      ok = string(rResult.program);
+			else if (key == "mode")         ok = string(rResult.mode);
+			else if (key == "type")         ok = string(rResult.type);
+			else if (key == "guard_level")  ok = number(val), rResult.guardLevel   = static_cast<int>(val);
+			else if (key == "instructions") ok = number(val), rResult.instructions = static_cast<size_t>(val);
+			else if (key == "runs_ns")      ok = numbers(rResult.runs);
+			else                            ok = skip();
+
+			if (!ok) return false;
+
+			peek(',');
+		}
+
+		return true;
+	}
+
+	inline bool JsonReader::expect(char ch) noexcept
+	{
+		while (pos_ < text_.length() && std::isspace(static_cast<unsigned char>(text_[pos_]))) pos_++;
+
+		if (pos_ >= text_.length() || text_[pos_] != ch) return false;
+
+		pos_++;
+
+		return true;
+	}
+
+	inline bool JsonReader::peek(char ch) noexcept
+	{ // Takes ch only if it is the next character
+		return expect(ch);
+	}
+
+	inline bool JsonReader::string(std::string &rStr)
+	{
+		if (!expect('"')) return false;
+
+		rStr.clear();
+		while (pos_ < text_.length() && text_[pos_] != '"')
+		{
+			if (text_[pos_] == '\\' && pos_ + 1 < text_.length()) pos_++;
+
+			rStr.push_back(text_[pos_++]);
+		}
+
+		return expect('"');
+	}
+
+	inline bool JsonReader::number(double &rVal)
+	{
+		while (pos_ < text_.length() && std::isspace(static_cast<unsigned char>(text_[pos_]))) pos_++;
+
+		std::string tmp(text_.substr(pos_, text_.find_first_of(",]} \t\r\n", pos_) - pos_));
+		if (tmp.empty()) return false;
+
+		char *pEnd = nullptr;
+		rVal = std::strtod(tmp.c_str(), &pEnd);
+		if (pEnd != tmp.c_str() + tmp.length()) return false;
+
+		pos_ += tmp.length();
+
+		return true;
+	}
+
+	inline bool JsonReader::numbers(std::vector<double> &rVals)
+	{
+		if (!expect('[')) return false;
+
+		rVals.clear();
+		while (!peek(']'))
+		{
+			double val = 0.;
+			if (!number(val)) return false;
+
+			rVals.push_back(val);
+			peek(',');
+		}
+
+		return true;
+	}
+
+	inline bool JsonReader::skip()
+	{
+		std::string str;
+		double      val = 0.;
+
+		if (peek('['))
+		{
+			while (!peek(']'))
+				if (!skip()) return false;
+				else peek(',');
+
+			return true;
+		}
+
+		if (peek('{'))
+		{
+			while (!peek('}'))
+				if (!string(str) || !expect(':') || !skip()) return false;
+				else peek(',');
+
+			return true;
+		}
+
+		size_t start = text_.find_first_not_of(" \t\r\n", pos_);
+		if (start == std::string_view::npos) return false;
+
+		if (text_[start] == '"') return string(str);
+
+		for (std::string_view word : { "true", "false", "null" })
+			if (text_.substr(start, word.length()) == word)
+			{
+				pos_ = start + word.length();
+				return true;
+			}
+
+		return number(val);
+	}
+
+} // namespace NBenchmarks
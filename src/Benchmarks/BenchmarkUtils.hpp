@@ -0,0 +1,133 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   BenchmarkUtils.hpp
+//!
+//! \brief	Timing helpers shared by all the benchmarks
+//!
+//====================================================================================================================================
+
+#include <chrono>      // std::chrono::steady_clock
+#include <iostream>    // std::cout
+#include <iomanip>     // std::setw, std::setprecision
+#include <string_view> // std::string_view
+
+namespace NBenchmarks
+{
+
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+	constexpr size_t DEFAULT_ITERATIONS = 1 << 24;
+
+//====================================================================================================================================
+//========================================================FUNCTION_DECLARATION========================================================
+//====================================================================================================================================
+
+//====================================================================================================================================
+//!
+//! \brief	 Runs func(iterations) once and measures it
+//!
+//! \param   func        Benchmark body, must do iterations operations
+//! \param   iterations  Number of operations
+//!
+//! \return  Nanoseconds per operation
+//!
+//====================================================================================================================================
+
+	template<typename Func>
+	double Measure(Func func, size_t iterations = DEFAULT_ITERATIONS);
+
+//====================================================================================================================================
+//!
+//! \brief	Outputs result as 'name ... ns/op'
+//!
+//! \param  name  Name of the benchmark
+//! \param  ns    Nanoseconds per operation
+//!
+//====================================================================================================================================
+
+	inline void Report(std::string_view name, double ns);
+
+//====================================================================================================================================
+//!
+//! \brief	Outputs result as 'name ... ns/unit ... unit/s ... count'
+//!
+//! \param  name   Name of the benchmark
+//! \param  ns     Nanoseconds per operation
+//! \param  count  Number of operations done
+//! \param  unit   What the operation is called
+//!
+//====================================================================================================================================
+
+	inline void Report(std::string_view name, double ns, size_t count, std::string_view unit = "instr");
+
+//====================================================================================================================================
+//!
+//! \brief	Outputs result as 'name ... MB/s ... MB'
+//!
+//! \param  name   Name of the benchmark
+//! \param  ns     Nanoseconds of the whole run
+//! \param  bytes  Bytes processed by the run
+//!
+//====================================================================================================================================
+
+	inline void ReportThroughput(std::string_view name, double ns, size_t bytes);
+
+//====================================================================================================================================
+//!
+//! \brief	Keeps the value alive, so the compiler can not throw away the code computing it
+//!
+//! \param  crVal  Value to keep
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	inline void DoNotOptimize(const T &crVal);
+
+//====================================================================================================================================
+//========================================================FUNCTION_DEFINITION=========================================================
+//====================================================================================================================================
+
+	template<typename Func>
+	double Measure(Func func, size_t iterations /* = DEFAULT_ITERATIONS */)
+	{
+		auto start = std::chrono::steady_clock::now();
+		func(iterations);
+		auto finish = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(finish - start).count() / iterations;
+	}
+
+	inline void Report(std::string_view name, double ns)
+	{
+		std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3) << std::setw(10) << ns << " ns/op" << std::endl;
+	}
+
+	inline void Report(std::string_view name, double ns, size_t count, std::string_view unit /* = "instr" */)
+	{
+		std::cout << std::left  << std::setw(40) << name
+		          << std::right << std::fixed << std::setprecision(3) << std::setw(10) << ns << " ns/" << unit
+		          << std::setprecision(0) << std::setw(14) << 1e9 / ns << " " << unit << "/s"
+		          << std::setw(12) << count << " " << unit << std::endl;
+	}
+
+	inline void ReportThroughput(std::string_view name, double ns, size_t bytes)
+	{
+		double mb = bytes / double(1 << 20);
+
+		std::cout << std::left  << std::setw(40) << name
+		          << std::right << std::fixed << std::setprecision(1) << std::setw(10) << mb * 1e9 / ns << " MB/s"
+		          << std::setprecision(0) << std::setw(12) << mb << " MB" << std::endl;
+	}
+
+	template<typename T>
+	inline void DoNotOptimize(const T &crVal)
+	{
+		static volatile T sink;
+		sink = crVal;
+	}
+
+} // namespace NBenchmarks
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "AssemblerBenchmarks.hpp"
+#include "BenchmarkUtils.hpp"
+#include "StorageBenchmarks.hpp"
+#include "VMBenchmarks.hpp"
+
+void RunBenchmarksAutomatic(const NVMBenchmarks::Options &crOptions = NVMBenchmarks::Options())
+{
+	NStorageBenchmarks::RunAllBenchmarks();
+	NAssemblerBenchmarks::RunAllBenchmarks(crOptions.runs);
+	NVMBenchmarks::RunAllBenchmarks(crOptions);
+}
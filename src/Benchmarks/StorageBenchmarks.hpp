@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>     // std::array
+#include <stdexcept> // std::out_of_range
+
+#include "BenchmarkUtils.hpp"
+
+#include "../Register.hpp"
+#include "../RAM.hpp"
+
+namespace NStorageBenchmarks
+{
+	using namespace NBenchmarks;
+
+	using NRegister::REG;
+	using NRegister::Register;
+
+	using NRam::Ram;
+	using NRam::RAM_SIZE;
+
+	constexpr size_t REG_NUM = static_cast<size_t>(REG::NUM);
+
+	void RegisterVirtual();
+	void RegisterChecked();
+	void RegisterUnchecked();
+	void RamVirtual();
+	void RamChecked();
+	void RamUnchecked();
+
+	typedef void(*benchmark_func_t)();
+
+	constexpr size_t STORAGE_BENCHMARK_FUNC_NUM = 6;
+
+	constexpr std::array<benchmark_func_t, STORAGE_BENCHMARK_FUNC_NUM> STORAGE_BENCHMARK_FUNC
+	{
+		RegisterVirtual,
+		RegisterChecked,
+		RegisterUnchecked,
+		RamVirtual,
+		RamChecked,
+		RamUnchecked
+	};
+
+	void RunAllBenchmarks()
+	{
+		std::cout << "[STORAGE BENCHMARKS]" << std::endl;
+
+		for (auto it = STORAGE_BENCHMARK_FUNC.cbegin(); it != STORAGE_BENCHMARK_FUNC.cend(); ++it)
+			(*it)();
+
+		std::cout << std::endl;
+	}
+
+#pragma region Replica of the virtual Storage
+
+	template<typename T, size_t SIZE>
+	class VirtualStorage
+	{ // Element access as it was before Storage became CRTP-based
+	public:
+		virtual ~VirtualStorage() = default;
+
+		virtual T &operator[](size_t index) { return buf_.at(index); }
+
+	protected:
+		std::array<T, SIZE> buf_ = { };
+	};
+
+	class VirtualRam final : public VirtualStorage<int, RAM_SIZE>
+	{
+	public:
+		int &operator[](size_t index) override
+		{
+			if (index >= counter_) throw std::out_of_range(std::string("[") + __FUNCTION__ + "] Ram out of range\n");
+
+			return buf_[index];
+		}
+
+	private:
+		size_t counter_ = RAM_SIZE;
+	};
+
+#pragma endregion
+
+	template<typename Container>
+	double Sum(Container &rStorage, size_t size)
+	{ // Read-modify-write every element, the same access pattern as the CPU has
+		return Measure([&](size_t iterations)
+		{
+			int sum = 0;
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				rStorage[i % size] += 1;
+				sum                += rStorage[(i + 1) % size];
+			}
+
+			DoNotOptimize(sum);
+		});
+	}
+
+	template<typename Container>
+	double SumUnchecked(Container &rStorage, size_t size)
+	{
+		return Measure([&](size_t iterations)
+		{
+			int sum = 0;
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				rStorage.get(i % size) += 1;
+				sum                    += rStorage.get((i + 1) % size);
+			}
+
+			DoNotOptimize(sum);
+		});
+	}
+
+	void RegisterVirtual()
+	{
+		VirtualStorage<int, REG_NUM> reg;
+		VirtualStorage<int, REG_NUM> *volatile pReg = &reg; // Hides the dynamic type from the optimizer
+
+		Report("Register virtual operator[] (before)", Sum(*pReg, REG_NUM));
+	}
+
+	void RegisterChecked()
+	{
+		Register<> reg;
+
+		Report("Register operator[]", Sum(reg, REG_NUM));
+	}
+
+	void RegisterUnchecked()
+	{
+		Register<> reg;
+
+		Report("Register get()", SumUnchecked(reg, REG_NUM));
+	}
+
+	void RamVirtual()
+	{
+		VirtualRam                           ram;
+		VirtualStorage<int, RAM_SIZE> *volatile pRam = &ram;
+
+		Report("Ram virtual operator[] (before)", Sum(*pRam, RAM_SIZE));
+	}
+
+	void RamChecked()
+	{
+		Ram<> ram;
+		for (size_t i = 0; i < RAM_SIZE; ++i)
+			ram.put(0);
+
+		Report("Ram operator[]", Sum(ram, RAM_SIZE));
+	}
+
+	void RamUnchecked()
+	{
+		Ram<> ram;
+		for (size_t i = 0; i < RAM_SIZE; ++i)
+			ram.put(0);
+
+		Report("Ram get()", SumUnchecked(ram, RAM_SIZE));
+	}
+
+} // namespace NStorageBenchmarks
@@ -0,0 +1,349 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   VMBenchmarks.hpp
+//!
+//! \brief	Runs the programms of src/Tests/Programs through all the four execution paths of the compiler,
+//!         then generated programms of millions of instructions, which must cost the same per instruction whatever their size
+//!
+//! \note   Linux: g++ -std=c++17 -O2 -DNDEBUG -I src src/Benchmarks/main.cpp src/AsyncLog.cpp src/Debugger.cpp
+//!                    src/Logger.cpp src/MyMath.cpp src/Parser.cpp -lpthread
+//!         Usage: Benchmarks [programms dir] [--json results.json] [--runs N], compare two JSON files with BenchCompare
+//!
+//====================================================================================================================================
+
+#include <algorithm>   // std::max
+#include <array>       // std::array
+#include <chrono>      // std::chrono::steady_clock
+#include <filesystem>  // std::filesystem::path
+#include <fstream>     // std::ofstream
+#include <iostream>    // std::cout
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_same_v
+#include <typeinfo>    // typeid
+#include <vector>      // std::vector
+
+#include "BenchmarkResults.hpp"
+#include "BenchmarkUtils.hpp"
+
+#include "../Compiler.hpp"
+
+namespace NVMBenchmarks
+{
+	using namespace NBenchmarks;
+
+	using NCompiler::Compiler;
+
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+	constexpr size_t           VM_RUNS       = 5;                           // Fewer runs can not show a significant difference
+	constexpr std::string_view PROGRAMS_PATH = "../../src/Tests/Programs/"; // From the directory of the VS project
+
+#ifdef GUARD_LVL
+	constexpr int              GUARD_LEVEL   = GUARD_LVL;
+#else
+	constexpr int              GUARD_LEVEL   = 0;
+#endif // GUARD_LVL
+
+//====================================================================================================================================
+//===============================================================ENUMS================================================================
+//====================================================================================================================================
+
+	enum class Mode : unsigned char
+	{
+		Text,
+		Com,
+		BinText,
+		BinCom,
+
+		NUM
+	};
+
+	constexpr std::array<std::string_view, static_cast<size_t>(Mode::NUM)> MODE_NAMES
+	{
+		"fromTextFile",
+		"fromComFile",
+		"fromBinTextFile",
+		"fromBinComFile"
+	};
+
+	constexpr std::array<std::string_view, 5> PROGRAMS
+	{
+		"Fibbonachi",  // Doubly recursive fib(20), every call returns n + fib(n) * 1e-6
+		"Factorial",   // 12! computed recursively 3000 times
+		"NestedLoops", // 300 x 300 counting loops
+		"Numeric",     // cos(sin(sqrt(i))^2) for 30000 values
+		"Recursion"    // Recursive sum of 2000 numbers 20 times, deep call stack
+	};
+
+	constexpr std::array<size_t, 3> LARGE_SIZES     = { 1 << 20, 1 << 21, 1 << 22 }; // Instructions of the generated programms
+	constexpr size_t                LARGE_FUNCTIONS = 1 << 10;
+
+//====================================================================================================================================
+//==============================================================STRUCTS===============================================================
+//====================================================================================================================================
+
+	struct Options
+	{
+		std::filesystem::path programms = PROGRAMS_PATH;
+		std::filesystem::path json;               // Results are not written if empty
+		size_t                runs      = VM_RUNS;
+	};
+
+//====================================================================================================================================
+//========================================================FUNCTION_DECLARATION========================================================
+//====================================================================================================================================
+
+	template<typename T>
+	std::string TypeName();
+
+//====================================================================================================================================
+//!
+//! \brief	 Makes Com, BinText and BinCom files of the programm, so every execution path has its input
+//!
+//! \param   path  Programm without extension
+//!
+//! \return  Are all the files written
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	bool Prepare(const std::filesystem::path &path);
+
+//====================================================================================================================================
+//!
+//! \brief	 Loads the Text or Com file for Run(), the binary files are read while they run
+//!
+//! \return  Is the programm loaded, true for the binary files
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	bool Load(Compiler<T> &rComp, Mode mode, const std::filesystem::path &path);
+
+	template<typename T>
+	bool Run(Compiler<T> &rComp, Mode mode, const std::filesystem::path &path);
+
+//====================================================================================================================================
+//!
+//! \brief	Runs the programm in every mode and reports the median run, the Text and Com loads are reported apart from it
+//!
+//! \param  path      Programm without extension
+//! \param  name      Name of the programm in the report
+//! \param  runs      Runs of every mode
+//! \param  rResults  Where to put the times of all the runs
+//! \param  last      Mode after the last one to run
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	void RunProgramm(const std::filesystem::path &path, std::string_view name, size_t runs, std::vector<Result> &rResults, Mode last = Mode::NUM);
+
+	template<typename T>
+	void RunProgramms(const std::filesystem::path &dir, size_t runs, std::vector<Result> &rResults);
+
+//====================================================================================================================================
+//!
+//! \brief	 Writes a programm which calls LARGE_FUNCTIONS functions placed after its end, every instruction is run once
+//!
+//! \param   path          Programm without extension
+//! \param   instructions  About how many instructions to write
+//!
+//====================================================================================================================================
+
+	bool MakeLarge(const std::filesystem::path &path, size_t instructions);
+
+//====================================================================================================================================
+//!
+//! \brief	Runs the programms of LARGE_SIZES from the text and Com files (the binary paths search the file for every label)
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	void RunLarge(size_t runs, std::vector<Result> &rResults);
+
+	void RunAllBenchmarks(const Options &crOptions = Options());
+
+//====================================================================================================================================
+//========================================================FUNCTION_DEFINITION=========================================================
+//====================================================================================================================================
+
+	template<typename T>
+	std::string TypeName()
+	{ // typeid(T).name() differs between compilers, the results of the different builds must be comparable
+		if constexpr (std::is_same_v<T, int>)    return "int";
+		if constexpr (std::is_same_v<T, double>) return "double";
+		if constexpr (std::is_same_v<T, float>)  return "float";
+
+		return typeid(T).name();
+	}
+
+	template<typename T>
+	bool Prepare(const std::filesystem::path &path)
+	{
+		Compiler<T> comp;
+
+		return (comp.text2com(path) && comp.text2bin(path) && comp.com2bin(path));
+	}
+
+	template<typename T>
+	bool Load(Compiler<T> &rComp, Mode mode, const std::filesystem::path &path)
+	{
+		switch (mode)
+		{
+		case Mode::Text: return rComp.load(path);
+		case Mode::Com:  return rComp.load(path.generic_string() + "Com");
+		default:         return true;
+		}
+	}
+
+	template<typename T>
+	bool Run(Compiler<T> &rComp, Mode mode, const std::filesystem::path &path)
+	{
+		switch (mode)
+		{
+		case Mode::Text:
+		case Mode::Com:     return rComp.run(); // Loaded by Load()
+		case Mode::BinText: return rComp.fromBinTextFile(path);
+		case Mode::BinCom:  return rComp.fromBinComFile(path);
+		default:            return false;
+		}
+	}
+
+	template<typename T>
+	void RunProgramm(const std::filesystem::path &path, std::string_view name, size_t runs, std::vector<Result> &rResults, Mode last /* = Mode::NUM */)
+	{
+		for (size_t mode = 0; mode < static_cast<size_t>(last); mode++)
+		{
+			Result result;
+			result.program    = name;
+			result.mode       = MODE_NAMES[mode];
+			result.type       = TypeName<T>();
+			result.guardLevel = GUARD_LEVEL;
+
+			Result load = result; // Of the whole programm, so one instruction
+			load.mode         += "/load";
+			load.instructions  = 1;
+
+			for (size_t run = 0; run < runs; run++)
+			{
+				Compiler<T> comp; // Every run starts with an empty CPU
+
+				auto start  = std::chrono::steady_clock::now();
+				bool ok     = Load(comp, static_cast<Mode>(mode), path);
+				auto loaded = std::chrono::steady_clock::now();
+				ok          = ok && Run(comp, static_cast<Mode>(mode), path);
+				auto finish = std::chrono::steady_clock::now();
+
+				if (!ok || !comp.executed())
+				{
+					result.runs.clear();
+					break;
+				}
+
+				if (mode <= static_cast<size_t>(Mode::Com))
+					load.runs.push_back(std::chrono::duration<double, std::nano>(loaded - start).count());
+
+				result.runs.push_back(std::chrono::duration<double, std::nano>(finish - loaded).count());
+				result.instructions = comp.executed();
+			}
+
+			if (result.runs.empty())
+			{
+				std::cout << result.name() << " failed" << std::endl;
+				continue;
+			}
+
+			if (!load.runs.empty())
+			{
+				Report(load.name(), Percentile(load.runs, 50.));
+				rResults.push_back(std::move(load));
+			}
+
+			Report(result.name(), Percentile(result.runs, 50.) / result.instructions, result.instructions);
+			rResults.push_back(std::move(result));
+		}
+	}
+
+	template<typename T>
+	void RunProgramms(const std::filesystem::path &dir, size_t runs, std::vector<Result> &rResults)
+	{
+		for (auto &&name : PROGRAMS)
+		{
+			auto path = dir / name;
+			if (!Prepare<T>(path))
+			{
+				std::cout << name << " can not be prepared" << std::endl;
+				continue;
+			}
+
+			RunProgramm<T>(path, name, runs, rResults);
+		}
+	}
+
+	bool MakeLarge(const std::filesystem::path &path, size_t instructions)
+	{
+		std::ofstream file(path.generic_string() + ".txt", std::ios::binary);
+
+		file << "push 0\n"; // The stack is never empty, so SP can be read after a pop
+		for (size_t i = 0; i < LARGE_FUNCTIONS; i++)
+			file << "call func" << i << '\n';
+		file << "end\n";
+
+		size_t pushes = std::max<size_t>(instructions / LARGE_FUNCTIONS / 2, 1);
+		for (size_t i = 0; i < LARGE_FUNCTIONS; i++)
+		{
+			file << "func" << i << ":\n";
+			for (size_t j = 0; j < pushes; j++)
+				file << "    push " << j << "\n    pop\n";
+			file << "    ret\n";
+		}
+
+		return static_cast<bool>(file);
+	}
+
+	template<typename T>
+	void RunLarge(size_t runs, std::vector<Result> &rResults)
+	{
+		auto path = std::filesystem::temp_directory_path() / "LargeProgramm";
+		for (size_t size : LARGE_SIZES)
+		{
+			Compiler<T> comp;
+			if (!MakeLarge(path, size) || !comp.text2com(path))
+			{
+				std::cout << "Large programm can not be prepared" << std::endl;
+				break;
+			}
+
+			RunProgramm<T>(path, "Large" + std::to_string(size >> 20) + "M", runs, rResults, Mode::BinText);
+		}
+
+		for (std::string_view suffix : { ".txt", "Com.txt" })
+			std::filesystem::remove(path.generic_string() + std::string(suffix));
+	}
+
+	void RunAllBenchmarks(const Options &crOptions /* = Options() */)
+	{
+		std::cout << "[VM BENCHMARKS]" << std::endl;
+
+		std::vector<Result> results;
+		RunProgramms<int>   (crOptions.programms, crOptions.runs, results);
+		RunProgramms<double>(crOptions.programms, crOptions.runs, results);
+		RunLarge<int>(crOptions.runs, results);
+
+		if (!crOptions.json.empty())
+		{
+			std::ofstream file(crOptions.json);
+			WriteJson(file, results);
+
+			std::cout << (file ? "Results are written to " : "Results can not be written to ") << crOptions.json << std::endl;
+		}
+
+		std::cout << std::endl;
+	}
+
+} // namespace NVMBenchmarks
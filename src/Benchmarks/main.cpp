@@ -0,0 +1,22 @@
+#include <cstdlib> // std::strtoull
+#include <cstring> // std::strcmp
+
+#include "Benchmarks.hpp"
+
+int main(int argc, char *argv[])
+{ // Benchmarks [programms dir] [--json results.json] [--runs N]
+	NVMBenchmarks::Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		if      (!std::strcmp(argv[i], "--json") && i + 1 < argc) options.json = argv[++i];
+		else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc) options.runs = std::strtoull(argv[++i], nullptr, 10);
+		else                                                      options.programms = argv[i];
+	}
+
+	RunBenchmarksAutomatic(options);
+
+#ifdef _WIN32
+	system("pause");
+#endif // _WIN32
+	return 0;
+}
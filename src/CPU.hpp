@@ -4,6 +4,7 @@
 #include "RAM.hpp"
 #include "Stack.hpp"
 #include "MyMath.hpp"
+#include "Stats.hpp"
 
 namespace NCpu
 {
@@ -23,18 +24,36 @@ namespace NCpu
 
 #pragma endregion
 
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+	constexpr size_t CACHE_LINE_SIZE = 1 << 6;
+
 //====================================================================================================================================
 //==============================================================CLASSES===============================================================
+//====================================================================================================================================
+
+//====================================================================================================================================
+//!
+//! \brief	Virtual CPU, aligned to the cache line so that CPUs running on different cores never share one
+//!
+//! \note   Registers and the stack header go first and take at most two cache lines (see HOT_SIZE),
+//!         guard metadata of all the parts lives out of line
+//!
 //====================================================================================================================================
 
 	template<typename T = int>
-	class CPU final
+	class alignas(CACHE_LINE_SIZE) CPU final
 	{
 	public:
 		typedef       T  &rVal_;
 		typedef       T &&rrVal_;
 		typedef const T  &crVal_;
 
+		static constexpr size_t STACK_INLINE_SIZE         = 1 << 5;
+		static constexpr size_t FUNC_RET_ADDR_INLINE_SIZE = 1 << 3;
+
 		enum class MemoryStorage
 		{
 			REGISTER,
@@ -43,12 +62,20 @@ namespace NCpu
 			STACK_FUNC_RET_ADDR
 		};
 
-		explicit CPU()  noexcept;
-		CPU(const CPU&) noexcept;
+//====================================================================================================================================
+//!
+//! \brief	Constructs CPU
+//!
+//! \param  pResource  Memory resource for all the memory of the CPU (e.g. NMemory::Arena)
+//!
+//====================================================================================================================================
+
+		explicit CPU(std::pmr::memory_resource *pResource = std::pmr::get_default_resource()) noexcept;
+		CPU(const CPU&);
 		CPU(CPU&&)      noexcept;
 		~CPU();
 
-		CPU<T> &operator=(const CPU&) noexcept;
+		CPU<T> &operator=(const CPU&);
 		CPU<T> &operator=(CPU&&)      noexcept ;
 
 		void push(crVal_, MemoryStorage);
@@ -59,6 +86,20 @@ namespace NCpu
 
 		std::streampos top() const noexcept;
 
+		size_t depth() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief  Makes room in the stack, so that the programm does not take memory while running
+//! 
+//! \param  depth  Expected stack depth
+//!
+//! \throw  std::bad_alloc
+//!
+//====================================================================================================================================
+
+		void reserve(size_t depth);
+
 		void add();
 		void sub();
 		void mul();
@@ -71,20 +112,67 @@ namespace NCpu
 
 		std::pair<T, T> getPair();
 
-		void swap(CPU&) noexcept(std::_Is_nothrow_swappable<T>::value);
+		void swap(CPU&) noexcept(std::is_nothrow_swappable_v<T>);
 
 		void move(REG, REG);
 		void move(crVal_, REG);
 
+//====================================================================================================================================
+//!
+//! \brief   Counts a jump, conditional or not
+//! 
+//! \param   taken  Does the jump jump
+//!
+//! \return  taken
+//!
+//====================================================================================================================================
+
+		bool branch(bool taken) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief   Counts an instruction the executor has finished
+//!
+//====================================================================================================================================
+
+		void retire() noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief   Returns the counters gathered since the CPU was constructed
+//! 
+//! \return  Statistics, all zero if STATS_LVL is 0
+//!
+//====================================================================================================================================
+
+		NStats::Stats stats() const noexcept;
+
 		void dump(std::ostream& = std::cout) const;
 		
 	private:
-		Register<T>           reg_;
-		Ram<T>                ram_;
-		Stack<T>              stack_;
-		Stack<std::streampos> funcRetAddr_;
+		static constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::CPU;
+
+		Register<T>                                      reg_;   // Hot
+		Stack<T, STACK_INLINE_SIZE>                      stack_; // Hot header, then the bottom of the stack
+		Ram<T>                                           ram_;
+		Stack<std::streampos, FUNC_RET_ADDR_INLINE_SIZE> funcRetAddr_;
+
+		STATS(NStats::Stats      stats_            = {};)                  // Counters only the CPU sees, the rest are asked from the parts
+		STATS(unsigned long long guardChecksStart_ = NStats::guardChecks;)
+
+	public:
+		static constexpr size_t HOT_SIZE = sizeof(Register<T>) + Stack<T, STACK_INLINE_SIZE>::HOT_SIZE; // Bytes touched by every instruction
 	};
 
+#pragma region SIZE_REPORT
+
+	static_assert(alignof(CPU<>) == CACHE_LINE_SIZE,      "CPU must start a cache line\n");
+	static_assert(sizeof(CPU<>) % CACHE_LINE_SIZE == 0,   "CPU must not share a cache line with its neighbours\n");
+	static_assert(CPU<>::HOT_SIZE <= 2 * CACHE_LINE_SIZE, "Hot state of CPU<> does not fit in two cache lines\n");
+	static_assert(sizeof(Register<>) <= CACHE_LINE_SIZE,  "Register<> does not fit in one cache line\n");
+
+#pragma endregion
+
 //====================================================================================================================================
 //=========================================================METHOD_DEFINITION==========================================================
 //====================================================================================================================================
@@ -92,21 +180,21 @@ namespace NCpu
 #pragma region METHOD_DEFINITION
 
 	template<typename T>
-	inline CPU<T>::CPU() noexcept :
-		reg_(),
-		ram_(),
-		stack_(),
-		funcRetAddr_()
+	inline CPU<T>::CPU(std::pmr::memory_resource *pResource /* = std::pmr::get_default_resource() */) noexcept :
+		reg_(pResource),
+		stack_(decltype(stack_)::DEFAULT_SIZE, decltype(stack_)::DEFAULT_MAX_SIZE, pResource),
+		ram_(pResource),
+		funcRetAddr_(decltype(funcRetAddr_)::DEFAULT_SIZE, decltype(funcRetAddr_)::DEFAULT_MAX_SIZE, pResource)
 	{ 
 		static_assert(std::is_arithmetic<T>::value, "Wrong type in CPU\n");
 		LOG_CONSTRUCTING()
 	}
 
 	template<typename T>
-	inline CPU<T>::CPU(const CPU &crCPU) noexcept :
+	inline CPU<T>::CPU(const CPU &crCPU) :
 		reg_(crCPU.reg_),
-		ram_(crCPU.ram_),
 		stack_(crCPU.stack_),
+		ram_(crCPU.ram_),
 		funcRetAddr_(crCPU.funcRetAddr_)
 	{
 		static_assert(std::is_arithmetic<T>::value, "Wrong type in CPU\n");
@@ -116,8 +204,8 @@ namespace NCpu
 	template<typename T>
 	inline CPU<T>::CPU(CPU<T> &&rrCPU) noexcept :
 		reg_(std::move(rrCPU.reg_)),
-		ram_(std::move(rrCPU.ram_)),
 		stack_(std::move(rrCPU.stack_)),
+		ram_(std::move(rrCPU.ram_)),
 		funcRetAddr_(std::move(rrCPU.funcRetAddr_))
 	{
 		static_assert(std::is_arithmetic<T>::value, "Wrong type in CPU\n");
@@ -131,7 +219,7 @@ namespace NCpu
 	}
 
 	template<typename T>
-	inline CPU<T> &CPU<T>::operator=(const CPU &crCPU) noexcept
+	inline CPU<T> &CPU<T>::operator=(const CPU &crCPU)
 	{
 		if (this != &crCPU)
 		{
@@ -160,55 +248,57 @@ namespace NCpu
 	template<typename T>
 	inline void CPU<T>::push(crVal_ val, MemoryStorage memory)
 	{ 
-		LOG_ARGS(crVal_, val)
+		LOG_ARGS(val)
 
 		if (memory == MemoryStorage::STACK)
 		{
 			stack_.push(val);
 
-			reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-			reg_.rehash();
+			reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+			HASH_GUARD(reg_.rehash();)
 		}
 		else if (memory == MemoryStorage::RAM) ram_.put(val);
-		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation");
+		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation", std::cerr);
 	}
 
 	template<typename T>
 	inline void CPU<T>::push(rrVal_ val, MemoryStorage memory)
 	{ 
-		LOG_ARGS(rrVal_, val)
+		LOG_ARGS(val)
 
 		if (memory == MemoryStorage::STACK)
 		{
 			stack_.push(val);
 
-			reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-			reg_.rehash();
+			reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+			HASH_GUARD(reg_.rehash();)
 		}
 		else if (memory == MemoryStorage::RAM) ram_.put(val);		
-		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation");
+		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation", std::cerr);
 	}
 
 	template<typename T>
 	inline void CPU<T>::push(REG reg, MemoryStorage memory)
 	{	
-		LOG_ARGS(std::string_view, NRegister::GetReg(reg))
+		LOG_ARGS(NRegister::GetReg(reg))
 
 		if (memory == MemoryStorage::STACK)
 		{
-			stack_.push(reg_[static_cast<size_t>(reg)]);
+			stack_.push(reg_.get(static_cast<size_t>(reg)));
 
-			reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-			reg_.rehash();
+			reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+			HASH_GUARD(reg_.rehash();)
 		}
-		else if (memory == MemoryStorage::RAM) ram_.put(reg_[static_cast<size_t>(reg)]);	
-		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation");
+		else if (memory == MemoryStorage::RAM) ram_.put(reg_.get(static_cast<size_t>(reg)));	
+		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation", std::cerr);
 	}
 	
 	template<typename T>
 	inline void CPU<T>::push(size_t pos)
 	{
-		LOG_ARGS(size_t, pos)
+		LOG_ARGS(pos)
+
+		STATS(stats_.calls++;)
 
 		funcRetAddr_.push(pos);
 	}
@@ -222,12 +312,12 @@ namespace NCpu
 		{
 			stack_.pop();
 
-			reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-			reg_.rehash();
+			reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+			HASH_GUARD(reg_.rehash();)
 		}
 		else if (memory == MemoryStorage::RAM) ram_.pop();
 		else if (memory == MemoryStorage::STACK_FUNC_RET_ADDR) funcRetAddr_.pop();
-		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation");
+		else NDebugger::Error(std::string("[") + __FUNCTION__ + "] Undefined operation", std::cerr);
 	}
 
 	template<typename T>
@@ -238,11 +328,27 @@ namespace NCpu
 		return funcRetAddr_.top();
 	}
 
+	template<typename T>
+	inline size_t CPU<T>::depth() const noexcept
+	{
+		return stack_.size();
+	}
+
+	template<typename T>
+	inline void CPU<T>::reserve(size_t depth)
+	{
+		LOG_ARGS(depth)
+
+		stack_.reserve(std::min(depth, stack_.limit())); // The estimate does not follow the jumps, it may be above the limit
+	}
+
 	template<typename T>
 	void CPU<T>::add()
 	{
 		LOG_FUNC()
 
+		STATS(stats_.arithmetic++;)
+
 		auto a = stack_.top();
 		stack_.pop();
 
@@ -251,8 +357,8 @@ namespace NCpu
 
 		stack_.push(a + b);
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
@@ -260,6 +366,8 @@ namespace NCpu
 	{
 		LOG_FUNC()
 
+		STATS(stats_.arithmetic++;)
+
 		auto a = stack_.top();
 		stack_.pop();
 
@@ -268,14 +376,16 @@ namespace NCpu
 
 		stack_.push(a - b);
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
 	void CPU<T>::mul()
 	{
 		LOG_FUNC()
+
+		STATS(stats_.arithmetic++;)
 		
 		auto a = stack_.top();
 		stack_.pop();
@@ -285,8 +395,8 @@ namespace NCpu
 
 		stack_.push(a * b);
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
@@ -294,6 +404,8 @@ namespace NCpu
 	{
 		LOG_FUNC()
 
+		STATS(stats_.arithmetic++;)
+
 		auto a = stack_.top();
 		stack_.pop();
 
@@ -303,8 +415,8 @@ namespace NCpu
 		if (!b) throw std::logic_error(std::string("[") + __FUNCTION__ + "] Division by zero\n");
 		stack_.push(a / b);
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
@@ -320,9 +432,11 @@ namespace NCpu
 	{
 		LOG_FUNC()
 
+		STATS(stats_.arithmetic++;)
+
 #pragma warning(push)
 #pragma warning(disable : 4127) // The conditional expression is a constant
-		if (std::is_arithmetic<T>()) assert(!"Type T must be arithmetic\n");
+		if (!std::is_arithmetic<T>::value) assert(!"Type T must be arithmetic\n");
 #pragma warning(pop)
 
 		auto a = stack_.top();
@@ -330,8 +444,8 @@ namespace NCpu
 
 		stack_.push(static_cast<T>(sqrt_(std::is_integral<T>::value ? static_cast<double>(a) : a)));
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
@@ -339,9 +453,11 @@ namespace NCpu
 	{
 		LOG_FUNC()
 
+		STATS(stats_.arithmetic++;)
+
 #pragma warning(push)
 #pragma warning(disable : 4127) // The conditional expression is a constant
-		if (std::is_arithmetic<T>::value) assert(!"Type T must be arithmetic\n");
+		if (!std::is_arithmetic<T>::value) assert(!"Type T must be arithmetic\n");
 #pragma warning(pop)
 
 		auto a = stack_.top();
@@ -349,8 +465,8 @@ namespace NCpu
 
 		stack_.push(static_cast<T>(sin_(std::is_integral<T>::value ? static_cast<double>(a) : a)));
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
@@ -358,9 +474,11 @@ namespace NCpu
 	{
 		LOG_FUNC()
 
+		STATS(stats_.arithmetic++;)
+
 #pragma warning(push)
 #pragma warning(disable : 4127) // The conditional expression is a constant
-		if (std::is_arithmetic<T>::value) assert(!"Type T must be arithmetic\n");
+		if (!std::is_arithmetic<T>::value) assert(!"Type T must be arithmetic\n");
 #pragma warning(pop)
 
 		auto a = stack_.top();
@@ -368,8 +486,8 @@ namespace NCpu
 
 		stack_.push(static_cast<T>(cos_(std::is_integral<T>::value ? static_cast<double>(a) : a)));
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
@@ -385,14 +503,14 @@ namespace NCpu
 		pair.second = stack_.top();
 		stack_.pop();
 
-		reg_[static_cast<size_t>(REG::SP)] = stack_.top();
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(REG::SP)) = stack_.top();
+		HASH_GUARD(reg_.rehash();)
 
 		return pair;
 	}
 
 	template<typename T>
-	inline void CPU<T>::swap(CPU &rCPU) noexcept(std::_Is_nothrow_swappable<T>::value)
+	inline void CPU<T>::swap(CPU &rCPU) noexcept(std::is_nothrow_swappable_v<T>)
 	{ 
 		reg_.swap(rCPU.reg_);
 		stack_.swap(rCPU.stack_); 
@@ -403,19 +521,50 @@ namespace NCpu
 	template<typename T>
 	inline void CPU<T>::move(REG src, REG dest) 
 	{ 
-		LOG_ARGS(size_t, static_cast<size_t>(src), static_cast<size_t>(dest))
+		LOG_ARGS(NRegister::GetReg(src), NRegister::GetReg(dest))
 		
-		reg_[static_cast<size_t>(dest)] = reg_[static_cast<size_t>(src)];
-		reg_.rehash();
+		reg_.get(static_cast<size_t>(dest)) = reg_.get(static_cast<size_t>(src));
+		HASH_GUARD(reg_.rehash();)
 	}
 
 	template<typename T>
 	inline void CPU<T>::move(crVal_ src, REG dest) 
 	{ 
-		LOG_ARGS(size_t, src, reinterpret_cast<crVal_>(dest))
+		LOG_ARGS(src, NRegister::GetReg(dest))
+
+		reg_.get(static_cast<size_t>(dest)) = src;
+		HASH_GUARD(reg_.rehash();)
+	}
+
+	template<typename T>
+	inline bool CPU<T>::branch(bool taken) noexcept
+	{
+		STATS(taken ? stats_.branchesTaken++ : stats_.branchesNotTaken++;)
 
-		reg_[static_cast<size_t>(dest)] = src;
-		reg_.rehash();
+		return taken;
+	}
+
+	template<typename T>
+	inline void CPU<T>::retire() noexcept
+	{
+		STATS(stats_.retired++;)
+	}
+
+	template<typename T>
+	inline NStats::Stats CPU<T>::stats() const noexcept
+	{
+		NStats::Stats stats = {};
+
+		STATS
+		(
+			stats                = stats_;
+			stats.stackHighWater = stack_.highWater();
+			stats.ramCellsUsed   = ram_.highWater();
+			stats.reallocations  = stack_.reallocations() + funcRetAddr_.reallocations();
+			stats.guardChecks    = NStats::guardChecks - guardChecksStart_;
+		)
+
+		return stats;
 	}
 
 	template<typename T>
@@ -423,15 +572,15 @@ namespace NCpu
 	{
 		LOG_FUNC()
 			
-		NDebugger::Info("\n\t\t[CPU DUMP]", NDebugger::TextColor::LightMagenta, true, rOstr);
+		NDebugger::Text(std::string_view("\n\t\t[CPU DUMP]"), rOstr, NDebugger::Colors::LightMagenta);
 
 		rOstr << "CPU <" << typeid(T).name() << "> [0x" << this << "]\n\n";
 
-		reg_.dump();
-		ram_.dump();
-		stack_.dump();
+		reg_.dump(rOstr);
+		ram_.dump(rOstr);
+		stack_.dump(rOstr);
 
-		NDebugger::Info("\t\t[  END   ]\n", NDebugger::TextColor::LightMagenta, true, rOstr);
+		NDebugger::Text(std::string_view("\t\t[  END   ]\n"), rOstr, NDebugger::Colors::LightMagenta);
 	}
 
 #pragma endregion
@@ -2,10 +2,10 @@
 
 #include <string_view> // std::string_view
 #include <array>       // std::array
-#include <functional>  // std::function
-#include <sstream>     // std::stringstream
 
 #include "CPU.hpp"
+#include "Parser.hpp"
+#include "PerfectHash.hpp"
 
 namespace NCpu::Commands
 {
@@ -52,6 +52,80 @@ namespace NCpu::Commands
 		NUM
 	};
 
+	enum class Operand : unsigned char
+	{
+		none,
+		imm,     // 42
+		reg,     // ax
+		mem_imm, // [42]
+		mem_reg, // [ax]
+		label
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Commands specialized on the kinds of their operands by the assembler, so the handlers never look at the operands text
+//!
+//====================================================================================================================================
+
+	enum class Opcode : unsigned char
+	{
+		push_imm,
+		push_reg,
+		push_mem_imm,
+		push_mem_reg,
+		pop,
+		pop_mem,
+
+		add,
+		sub,
+		mul,
+		div,
+		sqrt,
+		dup,
+		sin,
+		cos,
+
+		dump,
+
+		cmp_imm_imm,
+		cmp_imm_reg,
+		cmp_reg_imm,
+		cmp_reg_reg,
+		jump,
+
+		je,
+		jne,
+		ja,
+		jae,
+		jb,
+		jbe,
+
+		move_reg_reg,
+		move_imm_reg,
+
+		call,
+		ret,
+
+		end,
+
+		NUM
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	What the interpreter does after a handler, the program counter itself is only moved by the interpreter
+//!
+//====================================================================================================================================
+
+	enum class Flow : unsigned char
+	{
+		next, // The next instruction
+		jump, // The target of the instruction
+		call, // The target of the instruction, the return address is pushed
+		ret   // The popped return address
+	};
+
 //====================================================================================================================================
 //=============================================================CONSTANTS==============================================================
 //====================================================================================================================================
@@ -62,40 +136,59 @@ namespace NCpu::Commands
 //=============================================================TYPEDEFS===============================================================
 //====================================================================================================================================
 
-	typedef std::array<std::string, MAX_ARGS> args_t;
+	template<typename T>
+	using values_t = std::array<T, MAX_ARGS>; // Immediates of the operands parsed at load time, T() for the others
 
 //====================================================================================================================================
-//==============================================================CLASSES===============================================================
+//==============================================================STRUCTS===============================================================
 //====================================================================================================================================
 
 	template<typename T>
+	struct Operands
+	{
+		values_t<T>               values; // Immediates and RAM addresses
+		std::array<REG, MAX_ARGS> regs;   // Registers, REG::NUM for the other operands
+	};
+
+	template<typename T>
+	struct Instruction
+	{
+		Opcode      opcode;   // Opcode::NUM for the labels, the signatures of the functions and the unknown commands
+		Operands<T> operands;
+		size_t      target;   // Program counter of the label of a jump or call, or the one to go on from after a label or a function
+		                      // (past its ret), NULL for an unknown command. Resolved when the programm is loaded
+	};
+
+	template<typename T>
+	using handler_t = Flow(*)(NCpu::CPU<T>&, const Operands<T>&); // Plain pointers, so the table is constexpr
+
+//====================================================================================================================================
+//==============================================================CLASSES===============================================================
+//====================================================================================================================================
+
 	class Command
 	{
 	public:
-		std::string_view                                  name;
-		Commands                                          number;
-		char                                              numOfArgs;
-		std::function<short(NCpu::CPU<T>&, const args_t&)> func;
+		std::string_view name;
+		Commands         number;
+		char             numOfArgs;
 
-		explicit Command() :
+		constexpr explicit Command() :
 			name("null"),
 			number(Commands::undefined),
-			numOfArgs('0'),
-			func(nullptr)
+			numOfArgs('0')
 		{ }
 
-		Command(std::string_view str, Commands com, char num, std::function<short(NCpu::CPU<T>&, const args_t&)> cpuFunc) :
+		constexpr Command(std::string_view str, Commands com, char num) :
 			name(str),
 			number(com),
-			numOfArgs(num),
-			func(cpuFunc)
+			numOfArgs(num)
 		{ }
 
-		Command(const Command &crCommand) :
+		constexpr Command(const Command &crCommand) :
 			name(crCommand.name),
 			number(crCommand.number),
-			numOfArgs(crCommand.numOfArgs),
-			func(crCommand.func)
+			numOfArgs(crCommand.numOfArgs)
 		{ }
 
 		Command &operator=(const Command&) = default;
@@ -111,82 +204,219 @@ namespace NCpu::Commands
 	template<typename T>
 	T GetValue(std::string_view);
 
+//====================================================================================================================================
+//!
+//! \brief	 Returns how the command changes the stack size
+//!
+//! \param   cmd  Command
+//! \param   arg  First argument of the command
+//!
+//! \return  Number of pushed elements minus number of popped ones
+//!
+//====================================================================================================================================
+
+	inline int StackEffect(Commands cmd, std::string_view arg);
+
+//====================================================================================================================================
+//!
+//! \brief	 Tells the kind of the operand from its text
+//!
+//! \note    Every operand in brackets is RAM, as the interpreters of the files take it: [] is mem_imm (pop [])
+//!
+//====================================================================================================================================
+
+	inline Operand OperandKind(std::string_view arg) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Picks the opcode of the command for the kinds of its operands
+//!
+//! \return  Opcode::NUM if the command does not take such operands
+//!
+//====================================================================================================================================
+
+	inline Opcode Specialize(Commands cmd, Operand arg0, Operand arg1) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Tells the command of the opcode, the reverse of Specialize()
+//!
+//! \return  Commands::undefined for Opcode::NUM
+//!
+//====================================================================================================================================
+
+	inline Commands Generalize(Opcode opcode) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Names of the commands for the perfect hash
+//!
+//====================================================================================================================================
+
+	template<size_t N>
+	constexpr std::array<std::string_view, N> Names(const std::array<Command, N> &crCommands) noexcept
+	{
+		std::array<std::string_view, N> names{};
+		for (size_t i = 0; i < N; i++)
+			names[i] = crCommands[i].name;
+
+		return names;
+	}
+
+//====================================================================================================================================
+//!
+//! \brief	 Tells whether every command stands at the index of its number, so a number is found without a search
+//!
+//====================================================================================================================================
+
+	template<size_t N>
+	constexpr bool InOrder(const std::array<Command, N> &crCommands) noexcept
+	{
+		for (size_t i = 0; i < N; i++)
+			if (static_cast<size_t>(crCommands[i].number) != i) return false;
+
+		return true;
+	}
+
+//====================================================================================================================================
+//!
+//! \brief	 Runs the handler of the opcode
+//!
+//! \note    Every case calls a constant entry of CPU_OPCODES, so the compiler calls the handler directly and may inline it
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	inline Flow Execute(CPU<T> &rCPU, Opcode opcode, const Operands<T> &crOperands);
+
+	template<typename T>
+	Flow cpu_push_imm(CPU<T>&, const Operands<T>&);
+
+	template<typename T>
+	Flow cpu_push_reg(CPU<T>&, const Operands<T>&);
+
+	template<typename T>
+	Flow cpu_push_mem_imm(CPU<T>&, const Operands<T>&);
+
+	template<typename T>
+	Flow cpu_push_mem_reg(CPU<T>&, const Operands<T>&);
+
+	template<typename T>
+	Flow cpu_pop(CPU<T>&, const Operands<T>&);
+
+	template<typename T>
+	Flow cpu_pop_mem(CPU<T>&, const Operands<T>&);
+
+	template<typename T>
+	Flow cpu_add(CPU<T>&, const Operands<T>&);
+
 	template<typename T>
-	short cpu_push(CPU<T>&, const args_t&);
+	Flow cpu_sub(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_pop(CPU<T>&, const args_t&);
+	Flow cpu_mul(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_add(CPU<T>&, const args_t&);
+	Flow cpu_div(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_sub(CPU<T>&, const args_t&);
+	Flow cpu_sqrt(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_mul(CPU<T>&, const args_t&);
+	Flow cpu_dup(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_div(CPU<T>&, const args_t&);
+	Flow cpu_sin(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_sqrt(CPU<T>&, const args_t&);
+	Flow cpu_cos(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_dup(CPU<T>&, const args_t&);
+	Flow cpu_dump(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_sin(CPU<T>&, const args_t&);
+	Flow cpu_cmp_imm_imm(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_cos(CPU<T>&, const args_t&);
+	Flow cpu_cmp_imm_reg(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_dump(CPU<T>&, const args_t&);
+	Flow cpu_cmp_reg_imm(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_cmp(CPU<T>&, const args_t&);
+	Flow cpu_cmp_reg_reg(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_jump(CPU<T>&, const args_t&);
+	Flow cpu_jump(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_je(CPU<T>&, const args_t&);
+	Flow cpu_je(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_jne(CPU<T>&, const args_t&);
+	Flow cpu_jne(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_ja(CPU<T>&, const args_t&);
+	Flow cpu_ja(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_jae(CPU<T>&, const args_t&);
+	Flow cpu_jae(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_jb(CPU<T>&, const args_t&);
+	Flow cpu_jb(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_jbe(CPU<T>&, const args_t&);
+	Flow cpu_jbe(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_move(CPU<T>&, const args_t&);
+	Flow cpu_move_reg_reg(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_call(CPU<T>&, const args_t&);
+	Flow cpu_move_imm_reg(CPU<T>&, const Operands<T>&);
 
 	template<typename T>
-	short cpu_ret(CPU<T>&, const args_t&);
+	Flow cpu_call(CPU<T>&, const Operands<T>&);
 
-#pragma endregion 
+	template<typename T>
+	Flow cpu_ret(CPU<T>&, const Operands<T>&);
+
+#pragma endregion
 
 //====================================================================================================================================
 //==============================================================CLASSES===============================================================
 //====================================================================================================================================
 
-	template<typename T>
-	ref struct CPU_COMMANDS final
+	struct CPU_COMMANDS final
 	{
-		static const std::array<Command<T>, static_cast<size_t>(Commands::NUM)> buf;
+		static constexpr std::array<Command, static_cast<size_t>(Commands::NUM)> buf =
+		{
+			Command("push", Commands::push, '1'),
+			Command("pop",  Commands::pop,  '1'),
+			Command("add",  Commands::add,  '0'),
+			Command("sub",  Commands::sub,  '0'),
+			Command("mul",  Commands::mul,  '0'),
+			Command("div",  Commands::div,  '0'),
+			Command("sqrt", Commands::sqrt, '0'),
+			Command("dup",  Commands::dup,  '0'),
+			Command("sin",  Commands::sin,  '0'),
+			Command("cos",  Commands::cos,  '0'),
+			Command("dump", Commands::dump, '0'),
+			Command("cmp",  Commands::cmp,  '2'),
+			Command("jump", Commands::jump, '1'),
+			Command("je",   Commands::je,   '1'),
+			Command("jne",  Commands::jne,  '1'),
+			Command("ja",   Commands::ja,   '1'),
+			Command("jae",  Commands::jae,  '1'),
+			Command("jb",   Commands::jb,   '1'),
+			Command("jbe",  Commands::jbe,  '1'),
+			Command("move", Commands::move, '2'),
+			Command("call", Commands::call, '1'),
+			Command("ret",  Commands::ret,  '0'),
+			Command("end",  Commands::end,  '0')
+		};
+
+		static_assert(InOrder(buf), "Commands must stand at the index of their number");
+
+		static constexpr NPerfectHash::Table<static_cast<size_t>(Commands::NUM)> names{ Names(buf) }; // Built from the same table
 
 		static auto begin() noexcept -> decltype(buf.begin())
 		{
@@ -207,38 +437,71 @@ namespace NCpu::Commands
 		{
 			return buf.cend();
 		}
-	};
 
 //====================================================================================================================================
-//==========================================================STATIC_VARIABLES==========================================================
-//====================================================================================================================================
-
-	template<typename T>
-	const std::array<Command<T>, static_cast<size_t>(Commands::NUM)> CPU_COMMANDS<T>::buf =
-	{
-		Command<T>("push", Commands::push, '1', cpu_push<T>),
-		Command<T>("pop",  Commands::pop,  '1', cpu_pop<T>),
-		Command<T>("add",  Commands::add,  '0', cpu_add<T>),
-		Command<T>("sub",  Commands::sub,  '0', cpu_sub<T>),
-		Command<T>("mul",  Commands::mul,  '0', cpu_mul<T>),
-		Command<T>("div",  Commands::div,  '0', cpu_div<T>),
-		Command<T>("sqrt", Commands::sqrt, '0', cpu_sqrt<T>),
-		Command<T>("dup",  Commands::dup,  '0', cpu_dup<T>),
-		Command<T>("sin",  Commands::sin,  '0', cpu_sin<T>),
-		Command<T>("cos",  Commands::cos,  '0', cpu_cos<T>),
-		Command<T>("dump", Commands::dump, '0', cpu_dump<T>),
-		Command<T>("cmp",  Commands::cmp,  '2', cpu_cmp<T>),
-		Command<T>("jump", Commands::jump, '1', cpu_jump<T>),
-		Command<T>("je",   Commands::je,   '1', cpu_je<T>),
-		Command<T>("jne",  Commands::jne,  '1', cpu_jne<T>),
-		Command<T>("ja",   Commands::ja,   '1', cpu_ja<T>),
-		Command<T>("jae",  Commands::jae,  '1', cpu_jae<T>),
-		Command<T>("jb",   Commands::jb,   '1', cpu_jb<T>),
-		Command<T>("jbe",  Commands::jbe,  '1', cpu_jbe<T>),
-		Command<T>("move", Commands::move, '2', cpu_move<T>),
-		Command<T>("call", Commands::call, '1', cpu_call<T>),
-		Command<T>("ret",  Commands::ret,  '0', cpu_ret<T>),
-		Command<T>("end",  Commands::end,  '0', nullptr)
+//!
+//! \brief	 Finds the command by its name with one hash and one compare
+//!
+//! \return  cend() if there is no such command
+//!
+//====================================================================================================================================
+
+		static auto find(std::string_view name) noexcept -> decltype(buf.cbegin())
+		{
+			return buf.cbegin() + names.find(name);
+		}
+
+//====================================================================================================================================
+//!
+//! \brief	 Finds the command by its number
+//!
+//! \return  cend() if there is no such command
+//!
+//====================================================================================================================================
+
+		static auto find(Commands number) noexcept -> decltype(buf.cbegin())
+		{
+			return (static_cast<unsigned>(number) < buf.size() ? buf.cbegin() + static_cast<size_t>(number) : buf.cend());
+		}
+	};
+
+	template<typename T>
+	struct CPU_OPCODES final
+	{
+		static constexpr std::array<handler_t<T>, static_cast<size_t>(Opcode::NUM)> buf =
+		{
+			cpu_push_imm<T>,
+			cpu_push_reg<T>,
+			cpu_push_mem_imm<T>,
+			cpu_push_mem_reg<T>,
+			cpu_pop<T>,
+			cpu_pop_mem<T>,
+			cpu_add<T>,
+			cpu_sub<T>,
+			cpu_mul<T>,
+			cpu_div<T>,
+			cpu_sqrt<T>,
+			cpu_dup<T>,
+			cpu_sin<T>,
+			cpu_cos<T>,
+			cpu_dump<T>,
+			cpu_cmp_imm_imm<T>,
+			cpu_cmp_imm_reg<T>,
+			cpu_cmp_reg_imm<T>,
+			cpu_cmp_reg_reg<T>,
+			cpu_jump<T>,
+			cpu_je<T>,
+			cpu_jne<T>,
+			cpu_ja<T>,
+			cpu_jae<T>,
+			cpu_jb<T>,
+			cpu_jbe<T>,
+			cpu_move_reg_reg<T>,
+			cpu_move_imm_reg<T>,
+			cpu_call<T>,
+			cpu_ret<T>,
+			nullptr // end
+		};
 	};
 
 //====================================================================================================================================
@@ -247,217 +510,450 @@ namespace NCpu::Commands
 
 #pragma region FUNCTION_DEFINITION
 
+	inline int StackEffect(Commands cmd, std::string_view arg)
+	{
+		switch (cmd)
+		{
+		case Commands::push:
+		case Commands::pop:
+			if (!arg.empty() && arg.front() == '[') return 0; // RAM
+			return (cmd == Commands::push ? 1 : -1);
+
+		case Commands::dup:
+			return 1;
+
+		case Commands::cmp:
+			return 2;
+
+		case Commands::add:
+		case Commands::sub:
+		case Commands::mul:
+		case Commands::div:
+			return -1;
+
+		case Commands::je:
+		case Commands::jne:
+		case Commands::ja:
+		case Commands::jae:
+		case Commands::jb:
+		case Commands::jbe:
+			return -2;
+
+		default:
+			return 0;
+		}
+	}
+
+	inline Operand OperandKind(std::string_view arg) noexcept
+	{
+		if (arg.empty()) return Operand::none;
+
+		if (arg.front() == '[') return (NRegister::IsReg(arg) ? Operand::mem_reg : Operand::mem_imm);
+
+		if (NRegister::IsReg(arg))     return Operand::reg;
+		if (NParser::IsImmediate(arg)) return Operand::imm;
+
+		return Operand::label;
+	}
+
+	inline Opcode Specialize(Commands cmd, Operand arg0, Operand arg1) noexcept
+	{
+		switch (cmd)
+		{
+		case Commands::push:
+			if (arg0 == Operand::imm)     return Opcode::push_imm;
+			if (arg0 == Operand::reg)     return Opcode::push_reg;
+			if (arg0 == Operand::mem_imm) return Opcode::push_mem_imm;
+			if (arg0 == Operand::mem_reg) return Opcode::push_mem_reg;
+			return Opcode::NUM;
+
+		case Commands::pop:
+			return (arg0 == Operand::mem_imm || arg0 == Operand::mem_reg ? Opcode::pop_mem : Opcode::pop);
+
+		case Commands::cmp:
+			if (arg0 == Operand::imm && arg1 == Operand::imm) return Opcode::cmp_imm_imm;
+			if (arg0 == Operand::imm && arg1 == Operand::reg) return Opcode::cmp_imm_reg;
+			if (arg0 == Operand::reg && arg1 == Operand::imm) return Opcode::cmp_reg_imm;
+			if (arg0 == Operand::reg && arg1 == Operand::reg) return Opcode::cmp_reg_reg;
+			return Opcode::NUM;
+
+		case Commands::move:
+			if (arg0 == Operand::reg && arg1 == Operand::reg) return Opcode::move_reg_reg;
+			if (arg0 == Operand::imm && arg1 == Operand::reg) return Opcode::move_imm_reg;
+			return Opcode::NUM;
+
+		case Commands::add:  return Opcode::add;
+		case Commands::sub:  return Opcode::sub;
+		case Commands::mul:  return Opcode::mul;
+		case Commands::div:  return Opcode::div;
+		case Commands::sqrt: return Opcode::sqrt;
+		case Commands::dup:  return Opcode::dup;
+		case Commands::sin:  return Opcode::sin;
+		case Commands::cos:  return Opcode::cos;
+		case Commands::dump: return Opcode::dump;
+		case Commands::jump: return Opcode::jump;
+		case Commands::je:   return Opcode::je;
+		case Commands::jne:  return Opcode::jne;
+		case Commands::ja:   return Opcode::ja;
+		case Commands::jae:  return Opcode::jae;
+		case Commands::jb:   return Opcode::jb;
+		case Commands::jbe:  return Opcode::jbe;
+		case Commands::call: return Opcode::call;
+		case Commands::ret:  return Opcode::ret;
+		case Commands::end:  return Opcode::end;
+
+		default:
+			return Opcode::NUM;
+		}
+	}
+
+	inline Commands Generalize(Opcode opcode) noexcept
+	{
+		switch (opcode)
+		{
+		case Opcode::push_imm:
+		case Opcode::push_reg:
+		case Opcode::push_mem_imm:
+		case Opcode::push_mem_reg:
+			return Commands::push;
+
+		case Opcode::pop:
+		case Opcode::pop_mem:
+			return Commands::pop;
+
+		case Opcode::cmp_imm_imm:
+		case Opcode::cmp_imm_reg:
+		case Opcode::cmp_reg_imm:
+		case Opcode::cmp_reg_reg:
+			return Commands::cmp;
+
+		case Opcode::move_reg_reg:
+		case Opcode::move_imm_reg:
+			return Commands::move;
+
+		case Opcode::add:  return Commands::add;
+		case Opcode::sub:  return Commands::sub;
+		case Opcode::mul:  return Commands::mul;
+		case Opcode::div:  return Commands::div;
+		case Opcode::sqrt: return Commands::sqrt;
+		case Opcode::dup:  return Commands::dup;
+		case Opcode::sin:  return Commands::sin;
+		case Opcode::cos:  return Commands::cos;
+		case Opcode::dump: return Commands::dump;
+		case Opcode::jump: return Commands::jump;
+		case Opcode::je:   return Commands::je;
+		case Opcode::jne:  return Commands::jne;
+		case Opcode::ja:   return Commands::ja;
+		case Opcode::jae:  return Commands::jae;
+		case Opcode::jb:   return Commands::jb;
+		case Opcode::jbe:  return Commands::jbe;
+		case Opcode::call: return Commands::call;
+		case Opcode::ret:  return Commands::ret;
+		case Opcode::end:  return Commands::end;
+
+		default:
+			return Commands::undefined;
+		}
+	}
+
 	template<typename T>
-	T GetValue(std::string_view str)
+	inline Flow Execute(CPU<T> &rCPU, Opcode opcode, const Operands<T> &crOperands)
 	{
-		if (str.front() == '[')
-			str.remove_prefix(1);
+#define HANDLER(op) case Opcode::op: return CPU_OPCODES<T>::buf[static_cast<size_t>(Opcode::op)](rCPU, crOperands);
 
-		std::stringstream sstr(str.data());
+		switch (opcode)
+		{
+		HANDLER(push_imm)
+		HANDLER(push_reg)
+		HANDLER(push_mem_imm)
+		HANDLER(push_mem_reg)
+		HANDLER(pop)
+		HANDLER(pop_mem)
+		HANDLER(add)
+		HANDLER(sub)
+		HANDLER(mul)
+		HANDLER(div)
+		HANDLER(sqrt)
+		HANDLER(dup)
+		HANDLER(sin)
+		HANDLER(cos)
+		HANDLER(dump)
+		HANDLER(cmp_imm_imm)
+		HANDLER(cmp_imm_reg)
+		HANDLER(cmp_reg_imm)
+		HANDLER(cmp_reg_reg)
+		HANDLER(jump)
+		HANDLER(je)
+		HANDLER(jne)
+		HANDLER(ja)
+		HANDLER(jae)
+		HANDLER(jb)
+		HANDLER(jbe)
+		HANDLER(move_reg_reg)
+		HANDLER(move_imm_reg)
+		HANDLER(call)
+		HANDLER(ret)
+
+		default: // end is run by the interpreter
+			return Flow::next;
+		}
+
+#undef HANDLER
+	}
+
+	template<typename T>
+	T GetValue(std::string_view str)
+	{
 		T val = T();
-		sstr >> val;
+		NParser::ParseValue(str, val); // Registers give T()
 
 		return val;
 	}
 
 	template<typename T>
-	short cpu_push(CPU<T> &rCPU, const args_t &crArgs)
+	Flow cpu_push_imm(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		auto val = GetValue<T>(crArgs[0]);
-		REG  reg = NRegister::MakeReg(crArgs[0]);
+		rCPU.push(crOperands.values[0], CPU<T>::MemoryStorage::STACK);
 
-		if (crArgs[0][0] == '[' && reg != REG::NUM)
-			rCPU.push(reg, CPU<>::MemoryStorage::RAM);
-		else if (crArgs[0][0] == '[' && reg == REG::NUM)
-			rCPU.push(val, CPU<>::MemoryStorage::RAM);
-		else if (reg != REG::NUM)
-			rCPU.push(reg, CPU<>::MemoryStorage::STACK);
-		else
-			rCPU.push(val, CPU<>::MemoryStorage::STACK);
+		return Flow::next;
+	}
+
+	template<typename T>
+	Flow cpu_push_reg(CPU<T> &rCPU, const Operands<T> &crOperands)
+	{
+		rCPU.push(crOperands.regs[0], CPU<T>::MemoryStorage::STACK);
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_pop(CPU<T> &rCPU, const args_t &crArgs)
+	Flow cpu_push_mem_imm(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		if (crArgs[0][0] == '[') rCPU.pop(CPU<>::MemoryStorage::RAM);
-		else                     rCPU.pop(CPU<>::MemoryStorage::STACK);
+		rCPU.push(crOperands.values[0], CPU<T>::MemoryStorage::RAM);
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_add(CPU<T> &rCPU, const args_t&)
+	Flow cpu_push_mem_reg(CPU<T> &rCPU, const Operands<T> &crOperands)
+	{
+		rCPU.push(crOperands.regs[0], CPU<T>::MemoryStorage::RAM);
+
+		return Flow::next;
+	}
+
+	template<typename T>
+	Flow cpu_pop(CPU<T> &rCPU, const Operands<T>&)
+	{
+		rCPU.pop(CPU<T>::MemoryStorage::STACK);
+
+		return Flow::next;
+	}
+
+	template<typename T>
+	Flow cpu_pop_mem(CPU<T> &rCPU, const Operands<T>&)
+	{
+		rCPU.pop(CPU<T>::MemoryStorage::RAM);
+
+		return Flow::next;
+	}
+
+	template<typename T>
+	Flow cpu_add(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.add();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_sub(CPU<T> &rCPU, const args_t&)
+	Flow cpu_sub(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.sub();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_mul(CPU<T> &rCPU, const args_t&)
+	Flow cpu_mul(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.mul();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_div(CPU<T> &rCPU, const args_t&)
+	Flow cpu_div(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.div();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_sqrt(CPU<T> &rCPU, const args_t&)
+	Flow cpu_sqrt(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.sqrt();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_dup(CPU<T> &rCPU, const args_t&)
+	Flow cpu_dup(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.dup();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_sin(CPU<T> &rCPU, const args_t&)
+	Flow cpu_sin(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.sin();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_cos(CPU<T> &rCPU, const args_t&)
+	Flow cpu_cos(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.cos();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_dump(CPU<T> &rCPU, const args_t&)
+	Flow cpu_dump(CPU<T> &rCPU, const Operands<T>&)
 	{
 		rCPU.dump();
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_cmp(CPU<T> &rCPU, const args_t &crArgs)
+	Flow cpu_cmp_imm_imm(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		rCPU.push(GetValue<T>(crArgs[0]), CPU<>::MemoryStorage::STACK);
-		rCPU.push(GetValue<T>(crArgs[1]), CPU<>::MemoryStorage::STACK);
+		rCPU.push(crOperands.values[0], CPU<T>::MemoryStorage::STACK);
+		rCPU.push(crOperands.values[1], CPU<T>::MemoryStorage::STACK);
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_jump(CPU<T>&, const args_t&)
+	Flow cpu_cmp_imm_reg(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		return 1;
+		rCPU.push(crOperands.values[0], CPU<T>::MemoryStorage::STACK);
+		rCPU.push(crOperands.regs[1],   CPU<T>::MemoryStorage::STACK);
+
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_je(CPU<T> &rCPU, const args_t&)
+	Flow cpu_cmp_reg_imm(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		if(auto pair = rCPU.getPair(); pair.first == pair.second) 
-			return 1;
+		rCPU.push(crOperands.regs[0],   CPU<T>::MemoryStorage::STACK);
+		rCPU.push(crOperands.values[1], CPU<T>::MemoryStorage::STACK);
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_jne(CPU<T> &rCPU, const args_t&)
+	Flow cpu_cmp_reg_reg(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		if (auto pair = rCPU.getPair(); pair.first != pair.second)
-			return 1;
+		rCPU.push(crOperands.regs[0], CPU<T>::MemoryStorage::STACK);
+		rCPU.push(crOperands.regs[1], CPU<T>::MemoryStorage::STACK);
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_ja(CPU<T> &rCPU, const args_t&)
+	Flow cpu_jump(CPU<T> &rCPU, const Operands<T>&)
 	{
-		if (auto pair = rCPU.getPair(); pair.first > pair.second)
-			return 1;
+		rCPU.branch(true);
 
-		return 0;
+		return Flow::jump;
 	}
 
 	template<typename T>
-	short cpu_jae(CPU<T> &rCPU, const args_t&)
+	Flow cpu_je(CPU<T> &rCPU, const Operands<T>&)
 	{
-		if (auto pair = rCPU.getPair(); pair.first >= pair.second)
-			return 1;
+		if (auto pair = rCPU.getPair(); rCPU.branch(pair.first == pair.second))
+			return Flow::jump;
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_jb(CPU<T> &rCPU, const args_t&)
+	Flow cpu_jne(CPU<T> &rCPU, const Operands<T>&)
 	{
-		if (auto pair = rCPU.getPair(); pair.first < pair.second)
-			return 1;
+		if (auto pair = rCPU.getPair(); rCPU.branch(pair.first != pair.second))
+			return Flow::jump;
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_jbe(CPU<T> &rCPU, const args_t&)
+	Flow cpu_ja(CPU<T> &rCPU, const Operands<T>&)
 	{
-		if (auto pair = rCPU.getPair(); pair.first <= pair.second)
-			return 1;
+		if (auto pair = rCPU.getPair(); rCPU.branch(pair.first > pair.second))
+			return Flow::jump;
+
+		return Flow::next;
+	}
+
+	template<typename T>
+	Flow cpu_jae(CPU<T> &rCPU, const Operands<T>&)
+	{
+		if (auto pair = rCPU.getPair(); rCPU.branch(pair.first >= pair.second))
+			return Flow::jump;
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_move(CPU<T> &rCPU, const args_t &crArgs)
+	Flow cpu_jb(CPU<T> &rCPU, const Operands<T>&)
 	{
-		bool isArg0Reg = NRegister::IsReg(crArgs[0]),
-			isArg1Reg = NRegister::IsReg(crArgs[1]);
+		if (auto pair = rCPU.getPair(); rCPU.branch(pair.first < pair.second))
+			return Flow::jump;
+
+		return Flow::next;
+	}
 
-		if (isArg0Reg && isArg1Reg)
-			rCPU.move(NRegister::MakeReg(crArgs[0]), NRegister::MakeReg(crArgs[1]));
-		else if (!isArg0Reg && isArg1Reg)
-			rCPU.move(GetValue<T>(crArgs[0]), NRegister::MakeReg(crArgs[1]));
-		else
-			std::cerr << "This was not realised yet\n";
+	template<typename T>
+	Flow cpu_jbe(CPU<T> &rCPU, const Operands<T>&)
+	{
+		if (auto pair = rCPU.getPair(); rCPU.branch(pair.first <= pair.second))
+			return Flow::jump;
 
-		return 0;
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_call(CPU<T>&, const args_t&)
+	Flow cpu_move_reg_reg(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		return 2;
+		rCPU.move(crOperands.regs[0], crOperands.regs[1]);
+
+		return Flow::next;
 	}
 
 	template<typename T>
-	short cpu_ret(CPU<T> &rCPU, const args_t&)
+	Flow cpu_move_imm_reg(CPU<T> &rCPU, const Operands<T> &crOperands)
 	{
-		auto ret_val = rCPU.top();
+		rCPU.move(crOperands.values[0], crOperands.regs[1]);
 
-		rCPU.pop(CPU<>::MemoryStorage::STACK_FUNC_RET_ADDR);
+		return Flow::next;
+	}
+
+	template<typename T>
+	Flow cpu_call(CPU<T>&, const Operands<T>&)
+	{
+		return Flow::call;
+	}
 
-		return static_cast<short>(ret_val);
+	template<typename T>
+	Flow cpu_ret(CPU<T>&, const Operands<T>&)
+	{ // The interpreter pops the address, it is a program counter of any size
+		return Flow::ret;
 	}
 
 #pragma endregion
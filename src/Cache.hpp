@@ -0,0 +1,397 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Cache.hpp
+//!
+//! \brief	Persistent cache of the assembled programms: a file per image named by the key, the least recently used are evicted
+//!
+//! \note   Entries are written through NAtomicFile, so processes sharing the directory see a whole entry or none. A hit
+//!         touches the entry, so the time of its last write is the time of its last use. An entry is checked by its digest
+//!         before it is used, a broken or foreign one is a miss.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <algorithm>   // std::sort
+#include <chrono>      // std::chrono::minutes
+#include <cstdint>     // uint64_t
+#include <cstring>     // std::memcpy
+#include <filesystem>  // std::filesystem::path, std::filesystem::directory_iterator
+#include <fstream>     // std::ifstream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+#include "AtomicFile.hpp"
+
+namespace NCache
+{
+
+#pragma region CONSTANTS
+
+	constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL, // Primes of XXH64
+	                   PRIME2 = 0xC2B2AE3D27D4EB4FULL,
+	                   PRIME3 = 0x165667B19E3779F9ULL,
+	                   PRIME4 = 0x85EBCA77C2B2AE63ULL,
+	                   PRIME5 = 0x27D4EB2F165667C5ULL;
+
+	constexpr uint64_t DEFAULT_SIZE = 1ULL << 28; // 256 MiB of images
+
+	constexpr char             MAGIC[8]  = { 'C', 'P', 'U', 'I', 'M', 'A', 'G', 'E' };
+	constexpr std::string_view EXTENSION = ".img";
+
+	constexpr std::chrono::minutes STALE_TEMP(10); // Temporary of a writer which died, removed by the eviction
+
+#pragma endregion
+
+#pragma region STRUCTS
+
+	struct Header
+	{
+		char     magic[sizeof(MAGIC)];
+		uint64_t key;
+		uint64_t size;   // Of the image after the header
+		uint64_t digest; // Of the image
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 XXH64 of the data, eight bytes a step in four independent lanes
+//!
+//! \param   data  Bytes to hash
+//! \param   seed  Start of the lanes, differs for the hashes which must not collide (e.g. of the compilers of different T)
+//!
+//====================================================================================================================================
+
+	inline uint64_t Digest(std::string_view data, uint64_t seed = 0) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	Appends the raw bytes of the value to the image
+//!
+//====================================================================================================================================
+
+	template<typename U>
+	void Put(std::string &rImage, const U &crVal);
+
+	inline void PutString(std::string &rImage, std::string_view str);
+
+//====================================================================================================================================
+//!
+//! \brief	 Takes the value from the front of the image
+//!
+//! \return  False if the image is too short
+//!
+//====================================================================================================================================
+
+	template<typename U>
+	bool Get(std::string_view &rImage, U &rVal) noexcept;
+
+	inline bool GetString(std::string_view &rImage, std::string_view &rStr) noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+	class Cache final
+	{
+	public:
+		explicit Cache(const std::filesystem::path &crDir, uint64_t maxBytes = DEFAULT_SIZE);
+
+		bool is_open() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Reads the image of the key and marks it used
+//!
+//! \return  False on a miss
+//!
+//====================================================================================================================================
+
+		bool load(uint64_t key, std::string &rImage);
+
+//====================================================================================================================================
+//!
+//! \brief	 Writes the image of the key, then evicts the least recently used images over the size of the cache
+//!
+//! \return  False if the image could not be written
+//!
+//====================================================================================================================================
+
+		bool store(uint64_t key, std::string_view image);
+
+		size_t hits()   const noexcept;
+		size_t misses() const noexcept;
+
+	private:
+		std::filesystem::path dir_;
+		uint64_t              maxBytes_;
+		size_t                hits_   = NULL,
+		                      misses_ = NULL;
+		bool                  open_;
+
+		std::filesystem::path entry(uint64_t key) const;
+
+		void evict();
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline uint64_t Rotl(uint64_t val, int shift) noexcept
+	{
+		return ((val << shift) | (val >> (64 - shift)));
+	}
+
+	inline uint64_t Round(uint64_t acc, uint64_t input) noexcept
+	{
+		return Rotl(acc + input * PRIME2, 31) * PRIME1;
+	}
+
+	inline uint64_t Read64(const char *pData) noexcept
+	{
+		uint64_t val = 0;
+		std::memcpy(&val, pData, sizeof(val));
+
+		return val;
+	}
+
+	inline uint64_t Digest(std::string_view data, uint64_t seed /* = 0 */) noexcept
+	{
+		const char *pData = data.data(),
+		           *pEnd  = data.data() + data.length();
+
+		uint64_t hash = 0;
+		if (data.length() >= 32)
+		{
+			uint64_t lanes[4] = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+			for (; pEnd - pData >= 32; pData += 32)
+				for (size_t i = 0; i < 4; i++)
+					lanes[i] = Round(lanes[i], Read64(pData + 8 * i));
+
+			hash = Rotl(lanes[0], 1) + Rotl(lanes[1], 7) + Rotl(lanes[2], 12) + Rotl(lanes[3], 18);
+			for (auto lane : lanes)
+				hash = (hash ^ Round(0, lane)) * PRIME1 + PRIME4;
+		}
+		else
+			hash = seed + PRIME5;
+
+		hash += data.length();
+
+		for (; pEnd - pData >= 8; pData += 8)
+			hash = Rotl(hash ^ Round(0, Read64(pData)), 27) * PRIME1 + PRIME4;
+
+		if (pEnd - pData >= 4)
+		{
+			uint32_t word = 0;
+			std::memcpy(&word, pData, sizeof(word));
+
+			hash   = Rotl(hash ^ (word * PRIME1), 23) * PRIME2 + PRIME3;
+			pData += 4;
+		}
+
+		for (; pData < pEnd; pData++)
+			hash = Rotl(hash ^ (static_cast<unsigned char>(*pData) * PRIME5), 11) * PRIME1;
+
+		hash ^= hash >> 33; // Avalanche
+		hash *= PRIME2;
+		hash ^= hash >> 29;
+		hash *= PRIME3;
+		hash ^= hash >> 32;
+
+		return hash;
+	}
+
+	template<typename U>
+	inline void Put(std::string &rImage, const U &crVal)
+	{
+		static_assert(std::is_trivially_copyable<U>::value, "Only raw bytes are written");
+
+		rImage.append(reinterpret_cast<const char*>(&crVal), sizeof(U));
+	}
+
+	inline void PutString(std::string &rImage, std::string_view str)
+	{
+		Put(rImage, static_cast<uint32_t>(str.length()));
+		rImage.append(str);
+	}
+
+	template<typename U>
+	inline bool Get(std::string_view &rImage, U &rVal) noexcept
+	{
+		static_assert(std::is_trivially_copyable<U>::value, "Only raw bytes are read");
+
+		if (rImage.length() < sizeof(U)) return false;
+
+		std::memcpy(&rVal, rImage.data(), sizeof(U));
+		rImage.remove_prefix(sizeof(U));
+
+		return true;
+	}
+
+	inline bool GetString(std::string_view &rImage, std::string_view &rStr) noexcept
+	{
+		uint32_t length = 0;
+		if (!Get(rImage, length) || rImage.length() < length) return false;
+
+		rStr = rImage.substr(0, length);
+		rImage.remove_prefix(length);
+
+		return true;
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Cache::Cache(const std::filesystem::path &crDir, uint64_t maxBytes /* = DEFAULT_SIZE */) :
+		dir_(crDir),
+		maxBytes_(maxBytes)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(dir_, error); // Another process may create it at the same time
+
+		open_ = std::filesystem::is_directory(dir_, error);
+	}
+
+	inline bool Cache::is_open() const noexcept
+	{
+		return open_;
+	}
+
+	inline bool Cache::load(uint64_t key, std::string &rImage)
+	{
+		auto path = entry(key);
+
+		std::ifstream file(path, std::ios::binary);
+
+		Header header{};
+		if (!open_ || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		    std::string_view(header.magic, sizeof(MAGIC)) != std::string_view(MAGIC, sizeof(MAGIC)) || header.key != key)
+		{
+			misses_++;
+
+			return false;
+		}
+
+		std::error_code error;
+		if (uintmax_t length = std::filesystem::file_size(path, error); error || length < sizeof(header) || header.size != length - sizeof(header))
+		{ // A truncated or broken header must not size the image
+			misses_++;
+
+			return false;
+		}
+
+		rImage.resize(static_cast<size_t>(header.size));
+		if (!file.read(rImage.data(), static_cast<std::streamsize>(header.size)) || Digest(rImage) != header.digest)
+		{
+			misses_++;
+
+			return false;
+		}
+
+		std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error); // Used now
+
+		hits_++;
+
+		return true;
+	}
+
+	inline bool Cache::store(uint64_t key, std::string_view image)
+	{
+		if (!open_) return false;
+
+		Header header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.key    = key;
+		header.size   = image.length();
+		header.digest = Digest(image);
+
+		{
+			NAtomicFile::Output output(entry(key), std::ios::binary);
+			if (!output.is_open()) return false;
+
+			output << std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)) << image;
+			if (!output.commit()) return false; // Writers of the same key write the same image, the last rename wins
+		}
+
+		evict();
+
+		return true;
+	}
+
+	inline size_t Cache::hits() const noexcept
+	{
+		return hits_;
+	}
+
+	inline size_t Cache::misses() const noexcept
+	{
+		return misses_;
+	}
+
+	inline std::filesystem::path Cache::entry(uint64_t key) const
+	{
+		static constexpr char DIGITS[] = "0123456789abcdef";
+
+		std::string name(2 * sizeof(key), '0');
+		for (size_t i = name.length(); i-- > 0; key >>= 4)
+			name[i] = DIGITS[key & 0x0F];
+
+		return (dir_ / (name + std::string(EXTENSION)));
+	}
+
+	inline void Cache::evict()
+	{
+		auto now = std::filesystem::file_time_type::clock::now();
+
+		std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+		uint64_t total = 0;
+
+		std::error_code error;
+		for (auto &&file : std::filesystem::directory_iterator(dir_, error))
+		{
+			auto time = file.last_write_time(error);
+			if (error) continue; // Removed by another process
+
+			auto size = file.file_size(error);
+			if (error) continue;
+
+			if (file.path().extension() == EXTENSION)
+			{
+				entries.emplace_back(time, file.path());
+				total += size;
+			}
+			else if (file.path().filename().string().find(".tmp") != std::string::npos && now - time > STALE_TEMP)
+				std::filesystem::remove(file.path(), error);
+		}
+
+		if (total <= maxBytes_) return;
+
+		std::sort(entries.begin(), entries.end()); // Least recently used first
+		for (auto &&[time, path] : entries)
+		{
+			auto size = std::filesystem::file_size(path, error);
+			if (!error && std::filesystem::remove(path, error)) // Failed if another process did it or reads it (Windows)
+				total -= size;
+
+			if (total <= maxBytes_) break;
+		}
+	}
+
+#pragma endregion
+
+} // namespace NCache
@@ -0,0 +1,362 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   ChromeTrace.hpp
+//!
+//! \brief	Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev): spans of the compile phases, programm runs and calls
+//!
+//! \note   One Sink is the file, shared by all the compilers of the process. Every compiler writes through its own Track,
+//!         which is a separate row of the viewer, buffers the events and hands them to the sink in big chunks,
+//!         so the VMs running on different threads take the lock of the sink rarely.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <atomic>      // std::atomic
+#include <chrono>      // std::chrono::steady_clock
+#include <cstdint>     // uint64_t
+#include <filesystem>  // std::filesystem::path
+#include <fstream>     // std::ofstream
+#include <mutex>       // std::mutex, std::lock_guard
+#include <string>      // std::string
+#include <string_view> // std::string_view
+
+namespace NChromeTrace
+{
+
+#pragma region CONSTANTS
+
+	constexpr size_t BUFFER_SIZE = 1 << 16;
+	constexpr int    PID         = 1;
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 Appends the string as a JSON string literal
+//!
+//! \param   rOut  Where to append
+//! \param   str   String to escape
+//!
+//====================================================================================================================================
+
+	inline void PutString(std::string &rOut, std::string_view str);
+
+//====================================================================================================================================
+//!
+//! \brief	 Appends nanoseconds as microseconds with three decimals, the unit of the ts field
+//!
+//! \param   rOut  Where to append
+//! \param   ns    Nanoseconds
+//!
+//====================================================================================================================================
+
+	inline void PutTime(std::string &rOut, uint64_t ns);
+
+#pragma endregion
+
+#pragma region CLASSES
+
+//====================================================================================================================================
+//!
+//! \brief	Trace file, thread-safe, must outlive all its tracks
+//!
+//====================================================================================================================================
+
+	class Sink final
+	{
+	public:
+		explicit Sink(const std::filesystem::path &path);
+		Sink(const Sink&) = delete;
+		Sink(Sink&&)      = delete;
+		~Sink();
+
+		Sink &operator=(const Sink&) = delete;
+		Sink &operator=(Sink&&)      = delete;
+
+		bool is_open() const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Nanoseconds since the sink was opened
+//!
+//====================================================================================================================================
+
+		uint64_t now() const noexcept;
+
+		unsigned newTrack() noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	Writes the events, every one must start with a comma
+//!
+//! \param  events  Events of one track
+//!
+//====================================================================================================================================
+
+		void append(std::string_view events);
+
+	private:
+		std::ofstream                         file_;
+		std::mutex                            mutex_;
+		std::atomic<unsigned>                 tracks_;
+		std::chrono::steady_clock::time_point start_;
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Events of one VM, used by one thread at a time
+//!
+//====================================================================================================================================
+
+	class Track final
+	{
+	public:
+
+//====================================================================================================================================
+//!
+//! \brief	Takes the next track of the sink and names it
+//!
+//! \param  rSink  Trace file
+//! \param  name   Name of the row in the viewer
+//!
+//====================================================================================================================================
+
+		Track(Sink &rSink, std::string_view name);
+		Track(const Track&) = delete;
+		Track(Track&&)      = delete;
+		~Track();
+
+		Track &operator=(const Track&) = delete;
+		Track &operator=(Track&&)      = delete;
+
+//====================================================================================================================================
+//!
+//! \brief	Begins a span
+//!
+//! \param  name      Name of the span
+//! \param  category  Category, the viewer can filter by it
+//! \param  detail    Shown in the arguments of the span if not empty
+//!
+//====================================================================================================================================
+
+		void begin(std::string_view name, std::string_view category, std::string_view detail = "");
+
+//====================================================================================================================================
+//!
+//! \brief	Ends the innermost span, ends without a begin are ignored
+//!
+//====================================================================================================================================
+
+		void end();
+
+//====================================================================================================================================
+//!
+//! \brief	Ends the spans until depth are left, e.g. the calls which never returned
+//!
+//! \param  depth  Number of the spans to leave
+//!
+//====================================================================================================================================
+
+		void endTo(size_t depth);
+
+		size_t depth() const noexcept;
+
+		void flush();
+
+	private:
+		Sink        &rSink_;
+		unsigned     tid_;
+		size_t       depth_;
+		std::string  buffer_;
+
+		void header(char phase);
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Span ending with the scope, does nothing without a track
+//!
+//====================================================================================================================================
+
+	class Span final
+	{
+	public:
+		Span(Track *pTrack, std::string_view name, std::string_view category, std::string_view detail = "");
+		Span(const Span&) = delete;
+		Span(Span&&)      = delete;
+		~Span();
+
+		Span &operator=(const Span&) = delete;
+		Span &operator=(Span&&)      = delete;
+
+	private:
+		Track  *pTrack_;
+		size_t  depth_;
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline void PutString(std::string &rOut, std::string_view str)
+	{
+		rOut.push_back('"');
+		for (char ch : str)
+		{
+			if (ch == '"' || ch == '\\')                 rOut.push_back('\\'), rOut.push_back(ch);
+			else if (static_cast<unsigned char>(ch) < ' ') rOut.push_back(' ');
+			else                                         rOut.push_back(ch);
+		}
+		rOut.push_back('"');
+	}
+
+	inline void PutTime(std::string &rOut, uint64_t ns)
+	{
+		std::string fraction = std::to_string(ns % 1000);
+
+		rOut += std::to_string(ns / 1000);
+		rOut += '.';
+		rOut.append(3 - fraction.length(), '0');
+		rOut += fraction;
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Sink::Sink(const std::filesystem::path &path) :
+		file_(path, std::ios::binary),
+		mutex_(),
+		tracks_(0),
+		start_(std::chrono::steady_clock::now())
+	{
+		if (file_.is_open()) // Every next event starts with a comma
+			file_ << "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << PID << ",\"args\":{\"name\":\"CPU\"}}";
+	}
+
+	inline Sink::~Sink()
+	{
+		if (file_.is_open()) file_ << "\n]}\n";
+	}
+
+	inline bool Sink::is_open() const
+	{
+		return file_.is_open();
+	}
+
+	inline uint64_t Sink::now() const noexcept
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+	}
+
+	inline unsigned Sink::newTrack() noexcept
+	{
+		return ++tracks_;
+	}
+
+	inline void Sink::append(std::string_view events)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		file_.write(events.data(), static_cast<std::streamsize>(events.length()));
+	}
+
+	inline Track::Track(Sink &rSink, std::string_view name) :
+		rSink_(rSink),
+		tid_(rSink.newTrack()),
+		depth_(NULL),
+		buffer_()
+	{
+		buffer_.reserve(BUFFER_SIZE);
+
+		buffer_ += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + std::to_string(PID) + ",\"tid\":" + std::to_string(tid_) + ",\"args\":{\"name\":";
+		PutString(buffer_, name);
+		buffer_ += "}}";
+	}
+
+	inline Track::~Track()
+	{
+		endTo(0);
+		flush();
+	}
+
+	inline void Track::begin(std::string_view name, std::string_view category, std::string_view detail /* = "" */)
+	{
+		header('B');
+
+		buffer_ += ",\"name\":";
+		PutString(buffer_, name);
+		buffer_ += ",\"cat\":";
+		PutString(buffer_, category);
+		if (!detail.empty())
+		{
+			buffer_ += ",\"args\":{\"detail\":";
+			PutString(buffer_, detail);
+			buffer_ += '}';
+		}
+		buffer_ += '}';
+
+		depth_++;
+	}
+
+	inline void Track::end()
+	{
+		if (!depth_) return;
+
+		header('E');
+		buffer_ += '}';
+
+		depth_--;
+	}
+
+	inline void Track::endTo(size_t depth)
+	{
+		while (depth_ > depth)
+			end();
+	}
+
+	inline size_t Track::depth() const noexcept
+	{
+		return depth_;
+	}
+
+	inline void Track::flush()
+	{
+		rSink_.append(buffer_);
+		buffer_.clear();
+	}
+
+	inline void Track::header(char phase)
+	{
+		if (buffer_.length() >= BUFFER_SIZE) flush();
+
+		buffer_ += ",\n{\"ph\":\"";
+		buffer_ += phase;
+		buffer_ += "\",\"pid\":" + std::to_string(PID) + ",\"tid\":" + std::to_string(tid_) + ",\"ts\":";
+		PutTime(buffer_, rSink_.now());
+	}
+
+	inline Span::Span(Track *pTrack, std::string_view name, std::string_view category, std::string_view detail /* = "" */) :
+		pTrack_(pTrack),
+		depth_(pTrack ? pTrack->depth() : NULL)
+	{
+		if (pTrack_) pTrack_->begin(name, category, detail);
+	}
+
+	inline Span::~Span()
+	{
+		if (pTrack_) pTrack_->endTo(depth_);
+	}
+
+#pragma endregion
+
+} // namespace NChromeTrace
@@ -1,14 +1,29 @@
 #pragma once
 
 #include <fstream>  // std::ifstream, std::ofstream
-#include <map>      // std::map
+#include <map>      // std::pmr::map
 #include <iterator> // std::istream_iterator
-#include <vector>   // std::vector
+#include <vector>   // std::pmr::vector
 #include <filesystem> // std::path
-
+#include <algorithm>  // std::max, std::count
+#include <cctype>     // std::isdigit
+#include <charconv>   // std::from_chars
+#include <memory>     // std::unique_ptr
+#include <string>     // std::string
+#include <exception>  // std::exception_ptr, std::rethrow_exception
+#include <sstream>    // std::ostringstream
+#include <thread>     // std::thread
+
+#include "Arena.hpp"
+#include "AtomicFile.hpp"
+#include "Cache.hpp"
 #include "Parser.hpp"
 #include "Wrap4BinaryIO.hpp"
 #include "CPUCommands.hpp"
+#include "Trace.hpp"
+#include "ChromeTrace.hpp"
+#include "Probes.hpp"
+#include "Profiler.hpp"
 
 namespace NCompiler
 {
@@ -23,6 +38,8 @@ namespace NCompiler
 	using namespace NCpu;
 	using namespace NCpu::Commands;
 
+	typedef NCpu::Commands::Commands Commands; // Hides the namespace of the same name
+
 #pragma endregion
 
 //====================================================================================================================================
@@ -32,29 +49,346 @@ namespace NCompiler
 	template<typename T = int>
 	class Compiler final
 	{
-		std::vector<Operation> load(std::experimental::filesystem::path);
+		enum class Format : unsigned char
+		{
+			com,     // Text to Com
+			binText, // Text to BinText
+			binCom   // Com to BinCom
+		};
+
+//====================================================================================================================================
+//!
+//! \brief	 Statements of a chunk of the source, assembled by one thread and linked to the others by load()
+//!
+//====================================================================================================================================
+
+		struct Part
+		{
+			std::vector<Statement>                           statements;
+			std::vector<Instruction<T>>                      code;
+			std::vector<std::pair<std::string_view, size_t>> labels; // Index of the statement in the part
+			std::string                                      error;  // First error of the part
+		};
+
+//====================================================================================================================================
+//!
+//! \brief	 Key of the image of the source in the cache: the source, IMAGE_VERSION and T
+//!
+//====================================================================================================================================
+
+		static uint64_t imageKey(std::string_view source) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Writes the loaded programm as an image for the cache
+//!
+//! \param   crProgramm  Loaded programm
+//! \param   crCode      Its assembled instructions
+//! \param   crLabels    Labels of the programm and their instructions
+//!
+//====================================================================================================================================
+
+		static std::string makeImage(const std::pmr::vector<Statement>                      &crProgramm,
+		                             const std::pmr::vector<Instruction<T>>                 &crCode,
+		                             const std::vector<std::pair<std::string_view, size_t>> &crLabels);
+
+//====================================================================================================================================
+//!
+//! \brief	 Loads the programm from its image, as load() does from the source
+//!
+//! \note    The statements point into the image, so it must outlive them
+//!
+//! \return  False if the image is broken, nothing is loaded then
+//!
+//====================================================================================================================================
+
+		bool fromImage(std::string_view image, std::pmr::vector<Statement> &rProgramm, std::pmr::vector<Instruction<T>> &rCode);
+
+//====================================================================================================================================
+//!
+//! \brief	 Finds the command by its name or, in the Com files, by its number
+//!
+//====================================================================================================================================
+
+		static auto findCommand(std::string_view cmd) -> decltype(CPU_COMMANDS::cbegin());
+
+//====================================================================================================================================
+//!
+//! \brief	 Parses and classifies the operands, picks the opcode for their kinds, reports a bad operand with its position
+//!
+//! \param   crPath        Source for the message
+//! \param   crStatement   Lexed statement
+//! \param   crCommand     Its command
+//! \param   rInstruction  Where to put the opcode and the operands
+//!
+//====================================================================================================================================
+
+		static bool assemble(const std::filesystem::path &crPath, const Statement &crStatement, const Command &crCommand, Instruction<T> &rInstruction,
+		                     std::string *pError = nullptr); // Where to put the message instead of the output
+
+//====================================================================================================================================
+//!
+//! \brief	 Lexes and assembles a chunk of the source, stops at the first error
+//!
+//! \param   crPath   Source for the messages
+//! \param   crChunk  Chunk of the source
+//! \param   rPart    Where to put the statements, instructions, labels and the error
+//!
+//====================================================================================================================================
+
+		static void parse(const std::filesystem::path &crPath, const Chunk &crChunk, Part &rPart);
+
+//====================================================================================================================================
+//!
+//! \brief	 Converts a chunk of the source to the format, stops at the first error
+//!
+//! \param   crName   Source for the messages
+//! \param   crChunk  Chunk of the source
+//! \param   format   Format to convert to
+//! \param   rOut     Where to write the converted chunk
+//! \param   rError   Where to put the error
+//!
+//====================================================================================================================================
+
+		static bool encode(const std::string &crName, const Chunk &crChunk, Format format, std::ostream &rOut, std::string &rError);
+
+//====================================================================================================================================
+//!
+//! \brief	 Converts the chunks of the file on the threads and writes them in order, so the output is the one of a single pass
+//!
+//====================================================================================================================================
+
+		bool convert(const std::filesystem::path &path, Format format) const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Estimates stack depth of the programm in one pass (jumps are not followed)
+//!
+//! \param   crProgramm  Loaded programm
+//!
+//! \return  Maximum stack depth
+//!
+//====================================================================================================================================
+
+		size_t estimateStackDepth(const std::pmr::vector<Statement> &crProgramm) const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Sets the target of every jump and call to the program counter of its label, and of every label and signature of a
+//!          function to where the run goes on after it, so the run never looks a label up nor compares a command
+//!
+//! \param   crProgramm  Loaded programm
+//! \param   rCode       Its assembled instructions
+//!
+//! \return  Program counter of the first jump or call to an unknown label, the size of the programm if every label is known
+//!
+//====================================================================================================================================
+
+		size_t resolve(const std::pmr::vector<Statement> &crProgramm, std::pmr::vector<Instruction<T>> &rCode) const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Encodes operands of every instruction once, so tracing costs only a copy per executed instruction
+//!
+//! \param   crProgramm  Loaded programm
+//! \param   crCode      Its assembled instructions
+//!
+//! \return  Number and encoded operands of every instruction, empty if there is no trace
+//!
+//====================================================================================================================================
+
+		std::vector<std::pair<unsigned char, std::string>> encodeTrace(const std::pmr::vector<Statement> &crProgramm, const std::pmr::vector<Instruction<T>> &crCode) const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Describes every instruction for the profile report: source line, enclosing label and text
+//!
+//! \param   crProgramm  Loaded programm
+//!
+//====================================================================================================================================
+
+		void describeProfile(const std::pmr::vector<Statement> &crProgramm);
+
+//====================================================================================================================================
+//!
+//! \brief	 Runs the loaded programm, the Text and Com files differ only in how they are loaded
+//!
+//! \param   runId  Id of the run for the probes
+//!
+//! \return  False if an unknown command is met
+//!
+//====================================================================================================================================
+
+		bool execute(unsigned long long runId);
 
 	public:
 		explicit Compiler()       = default;
-		Compiler(const Compiler&) = default;
-		Compiler(Compiler&&)      = default;
+		Compiler(const Compiler&);
+		Compiler(Compiler&&);
 		~Compiler()               = default;        
 
-		Compiler<T> &operator=(const Compiler&) noexcept;
+		Compiler<T> &operator=(const Compiler&);
 		Compiler<T> &operator=(Compiler&&)      noexcept;
 
-		bool text2com(std::experimental::filesystem::path) const;
-		bool text2bin(std::experimental::filesystem::path) const;
-		bool com2bin(std::experimental::filesystem::path)  const;
+		bool text2com(std::filesystem::path) const;
+		bool text2bin(std::filesystem::path) const;
+		bool com2bin(std::filesystem::path)  const;
 
-		bool fromTextFile(std::experimental::filesystem::path);
-		bool fromComFile(std::experimental::filesystem::path);
-		bool fromBinTextFile(std::experimental::filesystem::path);
-		bool fromBinComFile(std::experimental::filesystem::path);
+		bool fromTextFile(std::filesystem::path);
+		bool fromComFile(std::filesystem::path);
+		bool fromBinTextFile(std::filesystem::path);
+		bool fromBinComFile(std::filesystem::path);
+
+//====================================================================================================================================
+//!
+//! \brief	 Loads the programm and assembles every instruction once, so the commands never look at text
+//!
+//! \param   path  Path without the extension, of a Com file too: fromComFile() adds nothing to it either
+//!
+//! \return  False if the source can not be read, is malformed or empty
+//!
+//! \note    Keeps the programm for run(), so that a run can be timed without its load
+//!
+//====================================================================================================================================
+
+		bool load(std::filesystem::path path);
+
+//====================================================================================================================================
+//!
+//! \brief	 Runs the programm of the last load() or fromText/ComFile() from its start
+//!
+//! \return  False if no programm is loaded or an unknown command is met
+//!
+//====================================================================================================================================
+
+		bool run();
+
+//====================================================================================================================================
+//!
+//! \brief	 Sets the number of the threads which lex and assemble the chunks of a big source (toSomeFile() and the text loads)
+//!
+//! \param   threads  1 (the default) is a single pass, 0 is a thread per core
+//!
+//====================================================================================================================================
+
+		void setThreads(size_t threads) noexcept;
+
+		size_t threads() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Starts writing every executed instruction to the binary trace, see TraceDecoder
+//!
+//! \param   path  Trace file
+//!
+//! \return  Is the file opened
+//!
+//====================================================================================================================================
+
+		bool startTrace(const std::filesystem::path &path);
+
+		void stopTrace();
+
+//====================================================================================================================================
+//!
+//! \brief	 Starts writing spans of the compile phases, programm runs and calls as Chrome trace events
+//!
+//! \param   rSink  Trace file, may be shared by the compilers of all the threads and must outlive the track
+//! \param   name   Name of the track of this compiler in the viewer
+//!
+//====================================================================================================================================
+
+		void startChromeTrace(NChromeTrace::Sink &rSink, std::string_view name);
+
+		void stopChromeTrace();
+
+//====================================================================================================================================
+//!
+//! \brief	 Keeps the assembled programms in the directory, so an unchanged source is not lexed and assembled again
+//!
+//! \param   dir       Directory of the cache, may be shared by the processes
+//! \param   maxBytes  Size of the images kept, the least recently used are removed over it
+//!
+//! \return  Is the directory usable
+//!
+//====================================================================================================================================
+
+		bool startCache(const std::filesystem::path &dir, uint64_t maxBytes = NCache::DEFAULT_SIZE);
+
+		void stopCache();
+
+		const NCache::Cache *cache() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Starts counting executions and cycles of fromTextFile() and fromComFile()
+//!
+//! \return  False if the profiler is not compiled in (PROFILE_LVL)
+//!
+//====================================================================================================================================
+
+		bool startProfile();
+
+		void reportProfile(std::ostream& = std::cout) const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Writes the call stacks in the folded format of flame graph tools (PROFILE_LVL >= 2)
+//!
+//! \param   rOstr  Stream to output
+//!
+//====================================================================================================================================
+
+		void foldProfile(std::ostream &rOstr) const;
+
+//====================================================================================================================================
+//!
+//! \brief	 Number of the instructions executed by the last fromSomeFile() call, labels are not counted
+//!
+//====================================================================================================================================
+
+		size_t executed() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Statistics of the CPU over all the fromSomeFile() calls, all zero if STATS_LVL is 0
+//!
+//====================================================================================================================================
+
+		NStats::Stats stats() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns number of bytes the compiler took from the system for the VM and the loaded programm
+//!
+//! \note    Does not grow when the same programm is loaded again, every load() releases the memory of the previous one
+//!
+//====================================================================================================================================
+
+		size_t memory() const noexcept;
 
 	private:
-		std::map<std::string, size_t> labels_;
-		CPU<T>                        cpu_;
+		static constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::Compiler;
+
+		static constexpr uint64_t IMAGE_VERSION = 2; // Must grow when the assembling or the layout of the image changes
+
+		NMemory::Arena                          arena_;     // VM state, must outlive everything allocated from it
+		NMemory::Arena                          loadArena_; // The programm, its code and labels_, released by every load()
+		std::pmr::vector<Statement>             programm_{ &loadArena_ }; // Not copied, as the other state of the last load
+		std::pmr::vector<Instruction<T>>        code_{ &loadArena_ };
+		std::string                             text_;  // Source of the last load, the statements point into it
+		std::string                             image_; // Or its image, if the load came from the cache
+		std::filesystem::path                   path_;
+		std::pmr::map<std::pmr::string, size_t, std::less<>> labels_{ &loadArena_ }; // Looked up by std::string_view
+		CPU<T>                                  cpu_{ &arena_ };
+		std::unique_ptr<NTrace::Writer>         pTrace_;  // Not copied, every compiler writes its own trace
+		std::unique_ptr<NChromeTrace::Track>    pChrome_; // Not copied, every compiler has its own track
+		std::unique_ptr<NCache::Cache>          pCache_;  // Not copied
+		size_t                                  executed_ = NULL;
+		size_t                                  threads_  = 1;
+
+		PROFILE(std::unique_ptr<NProfiler::Profiler> pProfiler_;)
+		PROFILE(std::vector<std::string>             source_;)
 	};
 
 //====================================================================================================================================
@@ -63,6 +397,17 @@ namespace NCompiler
 
 	inline std::string wstr2str(std::wstring_view);
 
+//====================================================================================================================================
+//!
+//! \brief	 Calls func(i) for every i below count, each on its own thread (0 on the calling one)
+//!
+//! \throw   The first exception thrown by func, after all the threads are joined
+//!
+//====================================================================================================================================
+
+	template<typename Func>
+	void ForEachParallel(size_t count, Func func);
+
 //====================================================================================================================================
 //=========================================================METHOD_DEFINITION==========================================================
 //====================================================================================================================================
@@ -70,251 +415,719 @@ namespace NCompiler
 #pragma region METHOD_DEFINITION
 
 	template<typename T>
-	std::vector<Operation> Compiler<T>::load(std::experimental::filesystem::path path)
+	inline Compiler<T>::Compiler(const Compiler &crComp) :
+		arena_(),
+		loadArena_(),
+		programm_(&loadArena_),
+		code_(&loadArena_),
+		text_(),
+		image_(),
+		path_(),
+		labels_(crComp.labels_, &loadArena_),
+		cpu_(&arena_),
+		pTrace_(),
+		pChrome_(),
+		pCache_(),
+		executed_(crComp.executed_),
+		threads_(crComp.threads_)
 	{
-		std::ifstream file(path.generic_string() + ".txt");
-		if (!file.is_open())
-		{
-			NDebugger::Error("Cannot open file: " + path.generic_string());
-	
-			return std::vector<Operation>();
-		}
+		cpu_ = crComp.cpu_;
+	}
 
-		std::vector<Operation> programm;
-		while (!file.eof())
-		{
-			char tmp[MAX_LINE_LENGTH] = {};
-			file.getline(tmp, MAX_LINE_LENGTH, '\n');
+	template<typename T>
+	inline Compiler<T>::Compiler(Compiler &&rrComp) :
+		arena_(),
+		loadArena_(),
+		programm_(&loadArena_),
+		code_(&loadArena_),
+		text_(),
+		image_(),
+		path_(),
+		labels_(std::move(rrComp.labels_), &loadArena_), // Arenas differ, so the labels are copied
+		cpu_(&arena_),
+		pTrace_(std::move(rrComp.pTrace_)),
+		pChrome_(std::move(rrComp.pChrome_)),
+		pCache_(std::move(rrComp.pCache_)),
+		executed_(rrComp.executed_),
+		threads_(rrComp.threads_)
+	{
+		cpu_ = std::move(rrComp.cpu_);
+	}
 
-			if (auto op = std::move(ParseCode(tmp)); op.cmd.length())
-			{
-				if (op.cmd.front() == ':')
-					labels_[std::string(op.cmd.begin() + 1, op.cmd.end())] = programm.size();
-				else if (op.cmd.back() == ':')
-					labels_[std::string(op.cmd.begin(), op.cmd.end() - 1)] = programm.size();
+	template<typename T>
+	bool Compiler<T>::startTrace(const std::filesystem::path &path)
+	{
+		std::vector<std::string_view> opcodes(static_cast<size_t>(Commands::NUM), std::string_view("null"));
+		for (auto &&com : CPU_COMMANDS::buf)
+			opcodes[static_cast<size_t>(com.number)] = com.name;
 
-				programm.push_back(op);
-			}
+		std::vector<std::string_view> regs;
+		for (size_t reg = 0; reg < static_cast<size_t>(REG::NUM); reg++)
+			regs.push_back(NRegister::GetReg(static_cast<REG>(reg)));
+
+		auto kind = (std::is_floating_point<T>::value ? NTrace::ValueKind::Floating : NTrace::ValueKind::Integer);
+
+		pTrace_ = std::make_unique<NTrace::Writer>(path.generic_string(), kind, opcodes, regs);
+		if (!pTrace_->is_open())
+		{
+			NDebugger::Error("Cannot open file: " + path.generic_string(), std::cerr);
+			pTrace_.reset();
+
+			return false;
 		}
 
-		file.close();
+		return true;
+	}
 
-		return programm;
+	template<typename T>
+	inline void Compiler<T>::stopTrace()
+	{
+		pTrace_.reset();
 	}
 
 	template<typename T>
-	inline Compiler<T> &Compiler<T>::operator=(const Compiler &crComp) noexcept
+	inline void Compiler<T>::startChromeTrace(NChromeTrace::Sink &rSink, std::string_view name)
 	{
-		if (this != &crComp) 
-			cpu_ = crComp.cpu_;
+		pChrome_ = std::make_unique<NChromeTrace::Track>(rSink, name);
+	}
 
-		return (*this);
+	template<typename T>
+	inline void Compiler<T>::stopChromeTrace()
+	{
+		pChrome_.reset();
 	}
 
 	template<typename T>
-	inline Compiler<T> &Compiler<T>::operator=(Compiler &&rrComp) noexcept
+	bool Compiler<T>::startCache(const std::filesystem::path &dir, uint64_t maxBytes /* = NCache::DEFAULT_SIZE */)
 	{
-		assert(this != &rrComp);
+		pCache_ = std::make_unique<NCache::Cache>(dir, maxBytes);
+		if (!pCache_->is_open())
+		{
+			NDebugger::Error("Cannot open directory: " + dir.generic_string(), std::cerr);
+			pCache_.reset();
 
-		cpu_ = std::move(rrComp.cpu_);
+			return false;
+		}
 
-		return (*this);
+		return true;
 	}
 
-#pragma region Functions Compiler<>::toSomeFile
+	template<typename T>
+	inline void Compiler<T>::stopCache()
+	{
+		pCache_.reset();
+	}
 
 	template<typename T>
-	bool Compiler<T>::text2com(std::experimental::filesystem::path path) const
+	inline const NCache::Cache *Compiler<T>::cache() const noexcept
 	{
-		std::ifstream input(path.generic_string() + ".txt");
-		if (!input.is_open())
-		{
-			NDebugger::Error("Cannot open file: " + path.generic_string());
+		return pCache_.get();
+	}
+
+	template<typename T>
+	bool Compiler<T>::load(std::filesystem::path path)
+	{
+		LOG_MESSAGE(Info, path.generic_string())
+
+		NChromeTrace::Span span(pChrome_.get(), "load", "compile", path.generic_string());
+		NProbes::Phase     phase("load", path);
+
+		std::pmr::vector<Statement>(&loadArena_).swap(programm_);
+		std::pmr::vector<Instruction<T>>(&loadArena_).swap(code_);
+		labels_.clear();
+		loadArena_.release(); // Nothing of the last load is left in it
+		path_ = path;
 
+		if (!ReadSource(path.generic_string() + ".txt", text_))
+		{
+			NDebugger::Error("Cannot open file: " + path.generic_string(), std::cerr);
+	
 			return false;
 		}
 
-		std::ofstream output(path.generic_string() + "Com.txt");
-		if (!output.is_open())
+		uint64_t key = NULL;
+		if (pCache_)
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string() + "Com");
+			key = imageKey(text_);
 
-			input.close();
+			if (pCache_->load(key, image_) && fromImage(image_, programm_, code_))
+			{
+				if (resolve(programm_, code_) == programm_.size())
+					return !programm_.empty();
 
-			return false;
+				programm_.clear(); // A stale image, the source reports the label
+				code_.clear();
+				labels_.clear();
+			}
 		}
 
-		while (!input.eof())
+		std::vector<Chunk> chunks = SplitSource(text_, threads_);
+		std::vector<Part>  parts(chunks.size());
+		ForEachParallel(chunks.size(), [&](size_t i) { parse(path, chunks[i], parts[i]); });
+
+		size_t size = 0;
+		for (auto &&part : parts)
 		{
-			char tmp[MAX_LINE_LENGTH] = { };
-			input.getline(tmp, MAX_LINE_LENGTH, '\n'); // Get the line from input file
+			if (!part.error.empty()) // The first error of the source, a single pass stops at it too
+			{
+				NDebugger::Error(part.error, std::cerr);
 
-			Operation op(std::move(ParseCode(tmp))); // Parse the line
-			if (!op.cmd.length()) // Skip the empty line
-				continue;  
+				code_.clear();
 
-			else if (op.cmd[0] == ':' || op.cmd[op.cmd.length() - 1] == ':') // Write the label or signature of the function
-				output << op.cmd;
+				return false;
+			}
 
-			else if (auto it = std::find_if(CPU_COMMANDS<T>::cbegin(), CPU_COMMANDS<T>::cend(), [&] (auto &&com) -> bool { return (com.name == op.cmd); }); it != CPU_COMMANDS<T>::cend()) // Search the cmd in cgTable
-			{
-				output << static_cast<unsigned>(it->number); // Write command number
+			size += part.statements.size();
+		}
 
-				if (char num = it->numOfArgs; num != '0')
-					for (auto i = '0'; i < num; ++i)
-						output << " " << op.args[i - '0']; // Write args
+		programm_.reserve(size);
+		code_.reserve(size);
+
+		std::vector<std::pair<std::string_view, size_t>> labels; // For the image
+		for (auto &&part : parts) // Links the parts: their labels are moved by the statements of the parts before them
+		{
+			size_t base = programm_.size();
+			for (auto &&[label, index] : part.labels)
+			{
+				labels_[std::pmr::string(label, &loadArena_)] = base + index;
+				if (pCache_) labels.emplace_back(label, base + index);
 			}
-			
-			else // Unknown command
+
+			programm_.insert(programm_.end(), part.statements.begin(), part.statements.end()); // Views into text_, nothing is copied but them
+			code_.insert(code_.end(), part.code.begin(), part.code.end());
+		}
+
+		if (size_t pc = resolve(programm_, code_); pc != programm_.size())
+		{
+			for (auto &&part : parts) // Finds the statement of the pc to tell where the label is
 			{
-				NDebugger::Error("Unknown command: " + op.cmd);
+				if (pc < part.statements.size())
+				{
+					auto &&statement = part.statements[pc];
+					NDebugger::Error(path.generic_string() + ": Unknown label " + std::string(statement.args[0]) + " at " + Position(statement.line, Column(statement, statement.args[0])), std::cerr);
 
-				output.close();
-				input.close();
+					break;
+				}
 
-				return false;
+				pc -= part.statements.size();
 			}
 
-			output << std::endl;
+			programm_.clear();
+			code_.clear();
+
+			return false;
 		}
 
-		output.close();
-		input.close();
+		if (pCache_ && !programm_.empty())
+			pCache_->store(key, makeImage(programm_, code_, labels)); // A failed store only costs the next run a parse
 
-		return true;
+		return !programm_.empty();
+	}
+
+	template<typename T>
+	uint64_t Compiler<T>::imageKey(std::string_view source) noexcept
+	{
+		static_assert(std::is_trivially_copyable<Instruction<T>>::value, "Instructions are kept as raw bytes");
+
+		uint64_t type = (sizeof(T) << 2) | (std::is_floating_point<T>::value << 1) | std::is_signed<T>::value;
+
+		return NCache::Digest(source, NCache::Digest(std::string_view(reinterpret_cast<const char*>(&type), sizeof(type)), IMAGE_VERSION));
 	}
 
 	template<typename T>
-	bool Compiler<T>::text2bin(std::experimental::filesystem::path path) const
+	std::string Compiler<T>::makeImage(const std::pmr::vector<Statement>                      &crProgramm,
+	                                   const std::pmr::vector<Instruction<T>>                 &crCode,
+	                                   const std::vector<std::pair<std::string_view, size_t>> &crLabels)
 	{
-		std::ifstream input(path.generic_string() + ".txt");
-		if (!input.is_open())
+		std::string image;
+
+		NCache::Put(image, static_cast<uint64_t>(crProgramm.size()));
+		for (size_t i = 0; i < crProgramm.size(); i++)
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string());
+			NCache::PutString(image, crProgramm[i].cmd);
+			for (auto &&arg : crProgramm[i].args)
+				NCache::PutString(image, arg);
+
+			NCache::Put(image, crCode[i]);
+			NCache::Put(image, static_cast<uint64_t>(crProgramm[i].line));
+		}
+
+		NCache::Put(image, static_cast<uint64_t>(crLabels.size()));
+		for (auto &&[label, pc] : crLabels)
+		{
+			NCache::PutString(image, label);
+			NCache::Put(image, static_cast<uint64_t>(pc));
+		}
+
+		return image;
+	}
+
+	template<typename T>
+	bool Compiler<T>::fromImage(std::string_view image, std::pmr::vector<Statement> &rProgramm, std::pmr::vector<Instruction<T>> &rCode)
+	{
+		uint64_t size = NULL;
+		if (!NCache::Get(image, size)) return false;
+
+		rProgramm.reserve(static_cast<size_t>(std::min<uint64_t>(size, image.length())));
+		rCode.reserve(rProgramm.capacity());
+
+		bool ok = true;
+		for (uint64_t i = 0; i < size && ok; i++)
+		{
+			auto &&statement = rProgramm.emplace_back(Statement{});
+
+			ok = NCache::GetString(image, statement.cmd);
+			for (auto &&arg : statement.args)
+				ok = ok && NCache::GetString(image, arg);
+
+			uint64_t line = NULL;
+			ok = ok && NCache::Get(image, rCode.emplace_back()) && NCache::Get(image, line);
+			statement.line = static_cast<size_t>(line);
+		}
+
+		uint64_t labels = NULL;
+		ok = ok && NCache::Get(image, labels);
+
+		std::vector<std::pair<std::string_view, uint64_t>> entries; // Put to labels_ only when the whole image is read
+		for (uint64_t i = 0; i < labels && ok; i++)
+		{
+			auto &&[label, pc] = entries.emplace_back();
+			ok = NCache::GetString(image, label) && NCache::Get(image, pc) && pc <= size;
+		}
+
+		if (!ok || !image.empty())
+		{
+			rProgramm.clear();
+			rCode.clear();
 
 			return false;
 		}
 
-		std::ofstream output(path.generic_string() + "BinText.txt", std::ios::binary);
-		if (!output.is_open())
+		for (auto &&[label, pc] : entries)
+			labels_[std::pmr::string(label, &loadArena_)] = static_cast<size_t>(pc);
+
+		return true;
+	}
+
+	template<typename T>
+	void Compiler<T>::parse(const std::filesystem::path &crPath, const Chunk &crChunk, Part &rPart)
+	{
+		size_t lines = static_cast<size_t>(std::count(crChunk.text.cbegin(), crChunk.text.cend(), '\n')) + 1; // Blank lines make it an upper bound
+		rPart.statements.reserve(lines);
+		rPart.code.reserve(lines);
+
+		Lexer     lexer(crChunk.text, crChunk.line);
+		Statement statement{};
+		while (lexer.next(statement))
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string() + "BinText");
+			if (statement.cmd.front() == ':')
+				rPart.labels.emplace_back(statement.cmd.substr(1), rPart.statements.size());
+			else if (statement.cmd.back() == ':')
+				rPart.labels.emplace_back(statement.cmd.substr(0, statement.cmd.length() - 1), rPart.statements.size());
+
+			auto &&instruction = rPart.code.emplace_back(Instruction<T>{ Opcode::NUM, {}, 0 }); // Labels and unknown commands are not assembled
+			if (auto it = findCommand(statement.cmd); it != CPU_COMMANDS::cend() && !assemble(crPath, statement, *it, instruction, &rPart.error))
+				return;
+
+			rPart.statements.push_back(statement);
+		}
+
+		if (lexer.failed())
+			rPart.error = crPath.generic_string() + ": " + lexer.error();
+	}
+
+	template<typename T>
+	auto Compiler<T>::findCommand(std::string_view cmd) -> decltype(CPU_COMMANDS::cbegin())
+	{
+		if (cmd.empty() || !std::isdigit(static_cast<unsigned char>(cmd.front())))
+			return CPU_COMMANDS::find(cmd);
+
+		unsigned number = static_cast<unsigned>(Commands::NUM);
+		std::from_chars(cmd.data(), cmd.data() + cmd.length(), number);
 
-			input.close();
+		return CPU_COMMANDS::find(static_cast<Commands>(number));
+	}
+
+	template<typename T>
+	bool Compiler<T>::assemble(const std::filesystem::path &crPath, const Statement &crStatement, const Command &crCommand, Instruction<T> &rInstruction,
+	                           std::string *pError /* = nullptr */)
+	{
+		auto fail = [&](const std::string &crMessage)
+		{
+			if (pError) *pError = crMessage;
+			else        NDebugger::Error(crMessage, std::cerr);
 
 			return false;
+		};
+
+		std::array<Operand, MAX_ARGS> kinds{};
+		for (size_t i = 0; i < static_cast<size_t>(crCommand.numOfArgs - '0'); i++)
+		{
+			auto arg = crStatement.args[i];
+
+			kinds[i]                        = OperandKind(arg);
+			rInstruction.operands.values[i] = T();
+			rInstruction.operands.regs[i]   = NRegister::MakeReg(arg);
+
+			if ((kinds[i] == Operand::imm || (kinds[i] == Operand::mem_imm && arg != "[]")) && !ParseValue(arg, rInstruction.operands.values[i])) // [] is the address T()
+				return fail(crPath.generic_string() + ": Malformed literal " + std::string(arg) + " at " + Position(crStatement.line, Column(crStatement, arg)));
 		}
 
-#define WRITE_STRING(str) Wrap4BinaryIO<std::string>(str)
-#define ARG(index)        WRITE_STRING(op.args[index])
+		rInstruction.opcode = Specialize(crCommand.number, kinds[0], kinds[1]);
+		if (rInstruction.opcode == Opcode::NUM)
+			return fail(crPath.generic_string() + ": Invalid operands of " + std::string(crCommand.name) + " at " + Position(crStatement.line, crStatement.column));
 
-		while (!input.eof())
+		return true;
+	}
+
+	template<typename T>
+	size_t Compiler<T>::estimateStackDepth(const std::pmr::vector<Statement> &crProgramm) const
+	{
+		long long depth    = 0,
+		          maxDepth = 0;
+		for (auto &&op : crProgramm)
 		{
-			char tmp[MAX_LINE_LENGTH] = { };
-			input.getline(tmp, MAX_LINE_LENGTH, '\n'); // Get the line from input file
+			if (op.cmd.front() == ':' || op.cmd.back() == ':') // Skip the label or signature of the function
+				continue;
 
-			Operation op(std::move(ParseCode(tmp))); // Parse the line
-			if (!op.cmd.length()) // Skip the empty line
-				continue;		
+			auto it = findCommand(op.cmd);
+			if (it == CPU_COMMANDS::cend())
+				continue;
 
-			else if (op.cmd[0] == ':' || op.cmd[op.cmd.length() - 1] == ':') // Write the label or signature of the function
-				output << WRITE_STRING(op.cmd);
+			depth    = std::max(depth + StackEffect(it->number, op.args[0]), 0LL);
+			maxDepth = std::max(maxDepth, depth);
+		}
 
-			else if (auto it = std::find_if(CPU_COMMANDS<T>::cbegin(), CPU_COMMANDS<T>::cend(), [&](auto &&com) -> bool { return (com.name == op.cmd); }); it != CPU_COMMANDS<T>::cend()) // Search the cmd in cgTable
-			{
-				output << WRITE_STRING(op.cmd); // Write command name
+		return static_cast<size_t>(maxDepth);
+	}
 
-				if (char num = it->numOfArgs; num != '0')
-					for (auto i = '0'; i < num; ++i)
-						output << ARG(i - '0'); // Write args
+	template<typename T>
+	size_t Compiler<T>::resolve(const std::pmr::vector<Statement> &crProgramm, std::pmr::vector<Instruction<T>> &rCode) const
+	{
+		size_t unknown = crProgramm.size(),
+		       after   = crProgramm.size(); // After the nearest ret below
+		for (size_t pc = crProgramm.size(); pc-- > 0;) // Backwards, so the ret of a function is met before its signature
+		{
+			auto &&instruction = rCode[pc];
+			auto &&cmd         = crProgramm[pc].cmd;
+			if (instruction.opcode == Opcode::ret)
+				after = pc + 1;
+			else if (instruction.opcode == Opcode::call || (instruction.opcode >= Opcode::jump && instruction.opcode <= Opcode::jbe))
+			{
+				if (auto it = labels_.find(crProgramm[pc].args[0]); it != labels_.cend()) instruction.target = it->second;
+				else                                                                       unknown = pc;
 			}
+			else if (instruction.opcode == Opcode::NUM && cmd.front() == ':') // Skip the label
+				instruction.target = pc + 1;
+			else if (instruction.opcode == Opcode::NUM && cmd.back() == ':')  // Skip the function
+				instruction.target = after;
+		}
+
+		return unknown;
+	}
+
+	template<typename T>
+	std::vector<std::pair<unsigned char, std::string>> Compiler<T>::encodeTrace(const std::pmr::vector<Statement> &crProgramm, const std::pmr::vector<Instruction<T>> &crCode) const
+	{
+		if (!pTrace_) return { }; // Nothing is traced, so nothing is allocated
 
-			else // Unknown command
+		std::vector<std::pair<unsigned char, std::string>> trace(crProgramm.size());
+
+		for (size_t i = 0; i < crProgramm.size(); i++)
+		{
+			auto &&[num, args] = trace[i];
+			for (size_t j = 0; j < MAX_ARGS; j++)
 			{
-				NDebugger::Error("Unknown command: " + op.cmd);
+				auto &&arg = crProgramm[i].args[j];
+				if (arg.empty()) break;
 
-				output.close();
-				input.close();
+				bool ram = (arg.front() == '[');
 
-				return false;
+				if (REG reg = NRegister::MakeReg(arg); reg != REG::NUM)
+					NTrace::PutArg(args, (ram ? NTrace::ArgKind::RamRegister : NTrace::ArgKind::Register), static_cast<size_t>(reg));
+				else if (IsImmediate(arg))
+					NTrace::PutArg(args, (ram ? NTrace::ArgKind::RamValue : NTrace::ArgKind::Value), crCode[i].operands.values[j]);
+				else
+					NTrace::PutLabel(args, arg);
+
+				num++;
 			}
 		}
 
-#undef ARG
-#undef WRITE_STRING
+		return trace;
+	}
+
+	template<typename T>
+	void Compiler<T>::describeProfile(const std::pmr::vector<Statement> &crProgramm)
+	{
+#if PROFILE_LVL >= 1
+		if (!pProfiler_) return;
+
+		pProfiler_->start(crProgramm.size());
+
+		std::vector<std::string_view> labels(crProgramm.size());
+		for (auto &&[label, pc] : labels_)
+			if (pc < labels.size()) labels[pc] = label;
 
-		output.close();
-		input.close();
+		source_.assign(crProgramm.size(), std::string());
+
+		std::string_view label = "";
+		for (size_t pc = 0; pc < crProgramm.size(); pc++)
+		{
+			if (!labels[pc].empty()) label = labels[pc];
+
+			auto &&op   = crProgramm[pc];
+			auto &&text = source_[pc];
+
+			text = "line " + std::to_string(op.line) + " [" + std::string(label) + "] " + std::string(op.cmd);
+			for (auto &&arg : op.args)
+				if (!arg.empty()) text += " " + std::string(arg);
+		}
+#else
+		(void)crProgramm;
+#endif // PROFILE_LVL
+	}
+
+	template<typename T>
+	bool Compiler<T>::startProfile()
+	{
+#if PROFILE_LVL >= 1
+		pProfiler_ = std::make_unique<NProfiler::Profiler>(static_cast<size_t>(Commands::NUM));
 
 		return true;
+#else
+		return false;
+#endif // PROFILE_LVL
 	}
 
 	template<typename T>
-	bool Compiler<T>::com2bin(std::experimental::filesystem::path path) const
+	void Compiler<T>::reportProfile(std::ostream &rOstr /* = std::cout */) const
 	{
-		std::ifstream input(path.generic_string() + "Com.txt");
-		if (!input.is_open())
+#if PROFILE_LVL >= 1
+		if (!pProfiler_) return;
+
+		std::vector<std::string_view> opcodes(static_cast<size_t>(Commands::NUM), std::string_view("null"));
+		for (auto &&com : CPU_COMMANDS::buf)
+			opcodes[static_cast<size_t>(com.number)] = com.name;
+
+		pProfiler_->report(rOstr, opcodes, source_);
+		if (!pProfiler_->calls().empty())
+			pProfiler_->calls().report(rOstr);
+#else
+		(void)rOstr;
+#endif // PROFILE_LVL
+	}
+
+	template<typename T>
+	void Compiler<T>::foldProfile(std::ostream &rOstr) const
+	{
+#if PROFILE_LVL >= 2
+		if (pProfiler_) pProfiler_->calls().fold(rOstr);
+#else
+		(void)rOstr;
+#endif // PROFILE_LVL
+	}
+
+	template<typename T>
+	inline size_t Compiler<T>::executed() const noexcept
+	{
+		return executed_;
+	}
+
+	template<typename T>
+	inline void Compiler<T>::setThreads(size_t threads) noexcept
+	{
+		threads_ = (threads ? threads : std::max<size_t>(std::thread::hardware_concurrency(), 1));
+	}
+
+	template<typename T>
+	inline size_t Compiler<T>::threads() const noexcept
+	{
+		return threads_;
+	}
+
+	template<typename T>
+	inline NStats::Stats Compiler<T>::stats() const noexcept
+	{
+		return cpu_.stats();
+	}
+
+	template<typename T>
+	inline size_t Compiler<T>::memory() const noexcept
+	{
+		return arena_.reserved() + loadArena_.reserved();
+	}
+
+	template<typename T>
+	inline Compiler<T> &Compiler<T>::operator=(const Compiler &crComp)
+	{
+		if (this != &crComp) 
+			cpu_ = crComp.cpu_;
+
+		return (*this);
+	}
+
+	template<typename T>
+	inline Compiler<T> &Compiler<T>::operator=(Compiler &&rrComp) noexcept
+	{
+		assert(this != &rrComp);
+
+		cpu_     = std::move(rrComp.cpu_);
+		pTrace_  = std::move(rrComp.pTrace_);
+		pChrome_ = std::move(rrComp.pChrome_);
+		pCache_  = std::move(rrComp.pCache_);
+		threads_ = rrComp.threads_;
+
+		return (*this);
+	}
+
+#pragma region Functions Compiler<>::toSomeFile
+
+	template<typename T>
+	bool Compiler<T>::text2com(std::filesystem::path path) const
+	{
+		NChromeTrace::Span span(pChrome_.get(), "text2com", "compile", path.generic_string());
+		NProbes::Phase     phase("text2com", path);
+
+		return convert(path, Format::com);
+	}
+
+	template<typename T>
+	bool Compiler<T>::text2bin(std::filesystem::path path) const
+	{
+		NChromeTrace::Span span(pChrome_.get(), "text2bin", "compile", path.generic_string());
+		NProbes::Phase     phase("text2bin", path);
+
+		return convert(path, Format::binText);
+	}
+
+	template<typename T>
+	bool Compiler<T>::com2bin(std::filesystem::path path) const
+	{
+		NChromeTrace::Span span(pChrome_.get(), "com2bin", "compile", path.generic_string());
+		NProbes::Phase     phase("com2bin", path);
+
+		return convert(path, Format::binCom);
+	}
+
+	template<typename T>
+	bool Compiler<T>::convert(const std::filesystem::path &path, Format format) const
+	{
+		static constexpr const char *SUFFIXES[] = { "Com", "BinText", "BinCom" };
+
+		std::string name   = path.generic_string() + (format == Format::binCom ? "Com" : ""),
+		            target = path.generic_string() + SUFFIXES[static_cast<size_t>(format)];
+
+		std::string source;
+		if (!ReadSource(name + ".txt", source))
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string() + "Com");
+			NDebugger::Error("Cannot open file: " + name, std::cerr);
 
 			return false;
 		}
 
-		std::ofstream output(path.generic_string() + "BinCom.txt", std::ios::binary);
+		NAtomicFile::Output output(target + ".txt", format == Format::com ? std::ios::out : std::ios::binary); // Appears only when the whole programm is converted
 		if (!output.is_open())
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string() + "BinCom");
+			NDebugger::Error("Cannot open file: " + target, std::cerr);
+
+			return false;
+		}
+
+		std::vector<Chunk>              chunks = SplitSource(source, threads_);
+		std::vector<std::ostringstream> outs(chunks.size());
+		std::vector<std::string>        errors(chunks.size());
+		ForEachParallel(chunks.size(), [&](size_t i) { encode(name, chunks[i], format, outs[i], errors[i]); });
+
+		for (auto &&error : errors)
+			if (!error.empty()) // The first error of the source, the output is removed
+			{
+				NDebugger::Error(error, std::cerr);
+
+				return false;
+			}
 
-			input.close();
+		for (auto &&out : outs)
+			output << out.str();
+
+		if (!output.commit())
+		{
+			NDebugger::Error("Cannot write file: " + target, std::cerr);
 
 			return false;
 		}
 
-#define WRITE_STRING(str) Wrap4BinaryIO<std::string>(str)
+		return true;
+	}
+
+	template<typename T>
+	bool Compiler<T>::encode(const std::string &crName, const Chunk &crChunk, Format format, std::ostream &rOut, std::string &rError)
+	{
+#define WRITE_STRING(str) Wrap4BinaryIO<std::string_view>(str)
 #define ARG(index)        WRITE_STRING(op.args[index])
 
-		while (!input.eof())
+		Lexer     lexer(crChunk.text, crChunk.line);
+		Statement op{}; // Points into the source, nothing is copied
+		while (lexer.next(op))
 		{
-			char tmp[MAX_LINE_LENGTH] = { };
-			input.getline(tmp, MAX_LINE_LENGTH, '\n'); // Get the line from input file
+			if (op.cmd[0] == ':' || op.cmd[op.cmd.length() - 1] == ':') // Write the label or signature of the function
+			{
+				if (format == Format::com) rOut << op.cmd << '\n';
+				else                       rOut << WRITE_STRING(op.cmd);
 
-			Operation op(std::move(ParseCode(tmp))); // Parse the line
-			if (!op.cmd.length()) // Skip the empty line
 				continue;
+			}
 
-			else if (op.cmd[0] == ':' || op.cmd[op.cmd.length() - 1] == ':') // Write the label or signature of the function
+			auto it = CPU_COMMANDS::cend();
+			if (format == Format::binCom)
 			{
-				output << WRITE_STRING(op.cmd);
+				unsigned number = static_cast<unsigned>(Commands::NUM);
+				std::from_chars(op.cmd.data(), op.cmd.data() + op.cmd.length(), number); // Not a number is an unknown command
 
-				continue;
+				it = CPU_COMMANDS::find(static_cast<Commands>(number));
 			}
+			else
+				it = CPU_COMMANDS::find(op.cmd); // Search the cmd in cgTable
 
-			Commands cmd = static_cast<Commands>(std::stoi(op.cmd));
-			if (auto it = std::find_if(CPU_COMMANDS<T>::cbegin(), CPU_COMMANDS<T>::cend(), [&](const Command &com) -> bool { return (com.number == cmd); }); it != CPU_COMMANDS<T>::cend()) // Search the cmd in cgTable
+			if (it == CPU_COMMANDS::cend()) // Unknown command
 			{
-				output << WRITE_STRING(op.cmd); // Write command number
+				rError = crName + ": Unknown command: " + std::string(op.cmd) + " at " + Position(op.line, op.column);
 
-				if (char num = it->numOfArgs; num != '0')
-					for (auto i = '0'; i < num; ++i)
-						output << ARG(i - '0'); // Write args
+				return false;
 			}
 
-			else // Unknown command
+			if (Instruction<T> instruction{}; !assemble(crName, op, *it, instruction, &rError))
+				return false;
+
+			if (format == Format::com)
 			{
-				NDebugger::Error("Unknown command: " + op.cmd);
+				rOut << static_cast<unsigned>(it->number); // Write command number
 
-				input.close();
-				output.close();
+				if (char num = it->numOfArgs; num != '0')
+					for (auto i = '0'; i < num; ++i)
+						rOut << " " << op.args[i - '0']; // Write args
 
-				return false;
+				rOut << '\n';
+			}
+			else
+			{
+				rOut << WRITE_STRING(op.cmd); // Write command name (number for BinCom)
+
+				if (char num = it->numOfArgs; num != '0')
+					for (auto i = '0'; i < num; ++i)
+						rOut << ARG(i - '0'); // Write args
 			}
 		}
 
 #undef ARG
 #undef WRITE_STRING
 
-		output.close();
-		input.close();
+		if (lexer.failed())
+		{
+			rError = crName + ": " + lexer.error();
+
+			return false;
+		}
 
 		return true;
 	}
@@ -324,53 +1137,76 @@ namespace NCompiler
 #pragma region Functions Compiler<>::fromSomeFile
 
 	template<typename T>
-	bool Compiler<T>::fromTextFile(std::experimental::filesystem::path path)
+	bool Compiler<T>::execute([[maybe_unused]] unsigned long long runId)
 	{
-		auto programm = std::move(load(path));
-		for(auto op = programm.begin(); op != programm.end(); op++)
+		cpu_.reserve(estimateStackDepth(programm_));
+		executed_ = NULL;
+
+		auto trace = encodeTrace(programm_, code_);
+		PROFILE(describeProfile(programm_);)
+		for (size_t pc = 0; pc < code_.size(); pc++)
 		{
-			if (op->cmd.front() == ':')  // Skip the label
-				continue;
-			else if (op->cmd.back() == ':') // Skip the function
+			auto &&instruction = code_[pc];
+			if (instruction.opcode == Opcode::NUM) // Skip the label or the function, the targets are set by resolve()
 			{
-				do
+				if (instruction.target == 0)
 				{
-					op++;
-				} while (op->cmd != "ret" && op != programm.cend());
+					NDebugger::Error("Unknown command: " + std::string(programm_[pc].cmd), std::cerr);
+
+					return false;
+				}
+
+				pc = instruction.target - 1;
 
 				continue;
 			}
-			else if (op->cmd == "end")
+			else if (instruction.opcode == Opcode::end)
+			{
+				executed_++;
+				cpu_.retire();
+
 				break;
-	
-			if (auto it = std::find_if(CPU_COMMANDS<T>::cbegin(), CPU_COMMANDS<T>::cend(), [&](auto &&com) -> bool { return (com.name == op->cmd); }); it != CPU_COMMANDS<T>::cend())
+			}
+
+			if (pTrace_)
+				pTrace_->write(static_cast<unsigned>(Generalize(instruction.opcode)), pc, trace[pc].first, trace[pc].second);
+
+			PROFILE(auto start = NProfiler::Now();)
+
+			Flow flow = Execute(cpu_, instruction.opcode, instruction.operands);
+			executed_++;
+			cpu_.retire();
+
+			PROFILE(if (pProfiler_) pProfiler_->record(static_cast<unsigned>(Generalize(instruction.opcode)), pc, NProfiler::Now() - start);)
+			CALL_GRAPH(if (pProfiler_) pProfiler_->calls().count();)
+			CALL_GRAPH(if (pProfiler_ && instruction.opcode == Opcode::ret) pProfiler_->calls().leave();)
+			if (pChrome_ && instruction.opcode == Opcode::ret) pChrome_->end();
+			switch (flow)
 			{
-				short code = it->func(cpu_, op->args);
-				switch(code)
-				{
-				case 0:
-					break;
+			case Flow::next:
+				break;
 
-				case 1:
-					op = programm.begin() + labels_[op->args[0]];
-					break;
+			case Flow::jump:
+				pc = instruction.target;
+				break;
 
-				case 2:
-					cpu_.push(std::distance(programm.begin(), op));
-					op = programm.begin() + labels_[op->args[0]];
-					break;
-					
-				default:
-					op = programm.begin() + code;
-					break;
-				}
+			case Flow::call:
+				CALL_GRAPH(if (pProfiler_) pProfiler_->calls().enter(programm_[pc].args[0]);)
+				if (pChrome_) pChrome_->begin(programm_[pc].args[0], "call");
+				USDT(call, runId, pc, cpu_.depth());
+				cpu_.push(pc);
+				pc = instruction.target;
+				break;
 
-			}
-			else
+			case Flow::ret:
 			{
-				NDebugger::Error("Unknown command: " + op->cmd);
+				auto caller = static_cast<size_t>(static_cast<std::streamoff>(cpu_.top())); // Program counter of the call
 
-				return false;
+				cpu_.pop(CPU<T>::MemoryStorage::STACK_FUNC_RET_ADDR);
+				USDT(ret, runId, pc, cpu_.depth());
+				pc = caller;
+				break;
+			}
 			}
 		}
 
@@ -378,87 +1214,71 @@ namespace NCompiler
 	}
 
 	template<typename T>
-	bool Compiler<T>::fromComFile(std::experimental::filesystem::path path)
+	bool Compiler<T>::run()
 	{
-		auto programm = std::move(load(path));
-		for each (auto x in labels_)
-		{
-			std::cout << x.first << " " << x.second << std::endl;
-		}
-		for (auto op = programm.begin(); op != programm.end(); op++)
-		{
-			op->dump();
-			if (op->cmd.front() == ':')  // Skip the label
-				continue;
-			else if (op->cmd.back() == ':') // Skip the function
-			{
-				do
-				{
-					op++;
-				} while (std::stoi(op->cmd) == static_cast<unsigned>(NCpu::Commands::Commands::ret) && op != programm.cend());
+		NChromeTrace::Span span(pChrome_.get(), "run", "run", path_.generic_string()); // Calls which never returned end with it
+		NProbes::Run       run(NProbes::NextRunId(), path_, executed_);
 
-				continue;
-			}
-			else if (std::stoi(op->cmd) == static_cast<unsigned>(NCpu::Commands::Commands::end))
-				break;
-
-			unsigned cmd = std::stoi(op->cmd);
-			if (auto it = std::find_if(CPU_COMMANDS<T>::cbegin(), CPU_COMMANDS<T>::cend(), [&](auto &&com) -> bool { return (static_cast<unsigned>(com.number) == cmd); }); it != CPU_COMMANDS<T>::cend())
-			{
-				short code = it->func(cpu_, op->args);
-				switch (code)
-				{
-				case 0:
-					break;
+		if (programm_.empty()) return false;
 
-				case 1:
-					op = programm.begin() + labels_[op->args[0]];
-					break; 
+		return execute(run.id());
+	}
 
-				case 2:
-					cpu_.push(std::distance(programm.begin(), op));
-					op = programm.begin() + labels_[op->args[0]];
-					break;
-			
-				default:
-					op = programm.begin() + code;
-					break;
-				
-				}
+	template<typename T>
+	bool Compiler<T>::fromTextFile(std::filesystem::path path)
+	{
+		NChromeTrace::Span span(pChrome_.get(), "fromTextFile", "run", path.generic_string()); // Calls which never returned end with it
+		NProbes::Run       run(NProbes::NextRunId(), path, executed_);
 
-			}
-			else
-			{
-				NDebugger::Error("Unknown command: " + op->cmd, std::cerr);
+		return (load(path) && execute(run.id()));
+	}
 
-				return false;
-			}
-		}
+	template<typename T>
+	bool Compiler<T>::fromComFile(std::filesystem::path path)
+	{
+		NChromeTrace::Span span(pChrome_.get(), "fromComFile", "run", path.generic_string()); // Calls which never returned end with it
+		NProbes::Run       run(NProbes::NextRunId(), path, executed_);
 
-		return true;
+		return (load(path) && execute(run.id()));
 	}
 
 	template<typename T>
-	bool Compiler<T>::fromBinTextFile(std::experimental::filesystem::path path)
+	bool Compiler<T>::fromBinTextFile(std::filesystem::path path)
 	{
+		NChromeTrace::Span span(pChrome_.get(), "fromBinTextFile", "run", path.generic_string()); // Calls which never returned end with it
+		NProbes::Run       run(NProbes::NextRunId(), path, executed_);
+
 		std::ifstream file(path.generic_string() + "BinText.txt", std::ios::binary);
 		if (!file.is_open())
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string() + "BinText");
+			NDebugger::Error("Cannot open file: " + path.generic_string() + "BinText", std::cerr);
 
 			return false;
 		}
 
 #define COMMAND command.operator const std::string&()
 
+		executed_ = NULL;
+
 		bool skipCommand = false;
 		while (!file.eof())
 		{
 			Wrap4BinaryIO<std::string> command;
+			auto pc = file.tellg();
 			file >> command;
 
-			std::cout << command << std::endl;
-			
+			if (pTrace_ && !skipCommand) // Labels are not commands, so they are not traced
+			{
+				if (auto it = CPU_COMMANDS::find(std::string_view(COMMAND)); it != CPU_COMMANDS::cend())
+					pTrace_->write(static_cast<unsigned>(it->number), static_cast<uint64_t>(pc));
+			}
+
+			if (!skipCommand && COMMAND.length() && COMMAND.front() != ':' && COMMAND.back() != ':')
+			{
+				executed_++;
+				cpu_.retire();
+			}
+
 			if (!COMMAND.length() || COMMAND[0] == ':') continue; // Skip the label
 
 			else if (COMMAND[COMMAND.length() - 1] == ':') skipCommand = true; // Skip the function
@@ -469,13 +1289,13 @@ namespace NCompiler
 
 				if (skipCommand) continue;
 
-				auto val = getValue(command.operator const std::string&());
-				auto reg = makeReg(command.operator const std::string&());
+				auto val = GetValue<T>(command.operator const std::string&());
+				auto reg = NRegister::MakeReg(command.operator const std::string&());
 
-				if      (COMMAND[0] == '[' && reg != REG::NUM) cpu_.push(reg, CPU<>::MemoryStorage::RAM);
-				else if (COMMAND[0] == '[' && reg == REG::NUM) cpu_.push(val, CPU<>::MemoryStorage::RAM);
-				else if (                     reg != REG::NUM) cpu_.push(reg, CPU<>::MemoryStorage::STACK);
-				else		                                   cpu_.push(val, CPU<>::MemoryStorage::STACK);
+				if      (COMMAND[0] == '[' && reg != REG::NUM) cpu_.push(reg, CPU<T>::MemoryStorage::RAM);
+				else if (COMMAND[0] == '[' && reg == REG::NUM) cpu_.push(val, CPU<T>::MemoryStorage::RAM);
+				else if (                     reg != REG::NUM) cpu_.push(reg, CPU<T>::MemoryStorage::STACK);
+				else		                                   cpu_.push(val, CPU<T>::MemoryStorage::STACK);
 			}
 			else if (COMMAND == "pop")
 			{
@@ -483,10 +1303,10 @@ namespace NCompiler
 
 				file >> command;
 
-				if (COMMAND[0] == '[') { if (!skipCommand) cpu_.pop(CPU<>::MemoryStorage::RAM); }
+				if (COMMAND[0] == '[') { if (!skipCommand) cpu_.pop(CPU<T>::MemoryStorage::RAM); }
 				else
 				{
-					if (!skipCommand) cpu_.pop(CPU<>::MemoryStorage::STACK);
+					if (!skipCommand) cpu_.pop(CPU<T>::MemoryStorage::STACK);
 
 					file.seekg(oldPos);
 				}
@@ -511,24 +1331,24 @@ namespace NCompiler
 					file >> command;
 					if (!skipCommand)
 					{
-						auto reg = makeReg(command.operator const std::string&());
+						auto reg = NRegister::MakeReg(command.operator const std::string&());
 
-						if (reg != REG::NUM) cpu_.push(reg, CPU<>::MemoryStorage::STACK);
-						else                 cpu_.push(getValue(command.operator const std::string&()), CPU<>::MemoryStorage::STACK);
+						if (reg != REG::NUM) cpu_.push(reg, CPU<T>::MemoryStorage::STACK);
+						else                 cpu_.push(GetValue<T>(command.operator const std::string&()), CPU<T>::MemoryStorage::STACK);
 					}
 				};
 
 				pushVal();
 				pushVal();
 			}
-			else if (COMMAND == "jump") { file >> command; if (skipCommand) continue; Move2LabelBin(file, command.operator const std::string&()); }
+			else if (COMMAND == "jump") { file >> command; if (skipCommand) continue; cpu_.branch(true); Move2LabelBin(file, ':' + COMMAND); }
 
-			else if (COMMAND == "je")  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first == pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (COMMAND == "jne") { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first != pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (COMMAND == "ja")  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first  > pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (COMMAND == "jae") { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first >= pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (COMMAND == "jb")  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first  < pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (COMMAND == "jbe") { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first <= pair.second) Move2LabelBin(file, command.operator const std::string&()); }
+			else if (COMMAND == "je")  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first == pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (COMMAND == "jne") { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first != pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (COMMAND == "ja")  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first  > pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (COMMAND == "jae") { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first >= pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (COMMAND == "jb")  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first  < pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (COMMAND == "jbe") { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first <= pair.second)) Move2LabelBin(file, ':' + COMMAND); }
 
 			else if (COMMAND == "move")
 			{
@@ -538,11 +1358,11 @@ namespace NCompiler
 
 				if (skipCommand) continue;
 
-				bool isArg0Reg = isReg(arg0.operator const std::string&()),
-					 isArg1Reg = isReg(arg1.operator const std::string&());
+				bool isArg0Reg = NRegister::IsReg(arg0.operator const std::string&()),
+					 isArg1Reg = NRegister::IsReg(arg1.operator const std::string&());
 
-				if (isArg0Reg &&  isArg1Reg) cpu_.move(makeReg(arg0.operator const std::string&()), makeReg(arg1.operator const std::string&()));
-				else if (!isArg0Reg &&  isArg1Reg) cpu_.move(getValue(arg0.operator const std::string&()), makeReg(arg1.operator const std::string&()));
+				if (isArg0Reg &&  isArg1Reg) cpu_.move(NRegister::MakeReg(arg0.operator const std::string&()), NRegister::MakeReg(arg1.operator const std::string&()));
+				else if (!isArg0Reg &&  isArg1Reg) cpu_.move(GetValue<T>(arg0.operator const std::string&()), NRegister::MakeReg(arg1.operator const std::string&()));
 			}
 
 			else if (COMMAND == "call")
@@ -551,6 +1371,8 @@ namespace NCompiler
 
 				if (skipCommand) continue;
 
+				if (pChrome_) pChrome_->begin(COMMAND, "call");
+				USDT(call, run.id(), static_cast<long long>(pc), cpu_.depth());
 				cpu_.push(file.tellg());
 				Move2LabelBin(file, COMMAND + ':');
 			}
@@ -563,15 +1385,17 @@ namespace NCompiler
 					continue;
 				}
 
+				if (pChrome_) pChrome_->end();
+				USDT(ret, run.id(), static_cast<long long>(pc), cpu_.depth());
 				file.seekg(cpu_.top());
-				cpu_.pop(CPU<>::MemoryStorage::STACK_FUNC_RET_ADDR);
+				cpu_.pop(CPU<T>::MemoryStorage::STACK_FUNC_RET_ADDR);
 			}
 
 			else if (COMMAND == "end") if (!skipCommand) break;
 
 			else
 			{
-				NDebugger::Error("Unknown command: " + COMMAND);
+				NDebugger::Error("Unknown command: " + COMMAND, std::cerr);
 
 				file.close();
 
@@ -587,44 +1411,56 @@ namespace NCompiler
 	}
 
 	template<typename T>
-	bool Compiler<T>::fromBinComFile(std::experimental::filesystem::path path)
+	bool Compiler<T>::fromBinComFile(std::filesystem::path path)
 	{
+		NChromeTrace::Span span(pChrome_.get(), "fromBinComFile", "run", path.generic_string()); // Calls which never returned end with it
+		NProbes::Run       run(NProbes::NextRunId(), path, executed_);
+
 		std::ifstream file(path.generic_string() + "BinCom.txt", std::ios::binary);
 		if (!file.is_open())
 		{
-			NDebugger::Error("Cannot open file: " + path.generic_string() + "BinCom");
+			NDebugger::Error("Cannot open file: " + path.generic_string() + "BinCom", std::cerr);
 
 			return false;
 		}
 
 #define COMMAND command.operator const std::string&()
 
+		executed_ = NULL;
+
 		bool skipCommand = false;
 		while (!file.eof())
 		{
 			Wrap4BinaryIO<std::string> command;
+			auto pc = file.tellg();
 			file >> command;
-			
-			std::cout << command << std::endl;
 
 			if (!COMMAND.length() || COMMAND[0] == ':') continue; // Skip the label
 
 			else if (COMMAND[COMMAND.length() - 1] == ':') { skipCommand = true; continue; }
 
 			int comInNum = std::stoi(COMMAND);
+			if (!skipCommand)
+			{
+				executed_++;
+				cpu_.retire();
+			}
+
+			if (pTrace_ && !skipCommand)
+				pTrace_->write(static_cast<unsigned>(comInNum), static_cast<uint64_t>(pc));
 			if      (comInNum == static_cast<int>(Commands::push))
 			{
 				file >> command;
 				
 				if (skipCommand) continue;
 
-				auto val = getValue(COMMAND);
-				auto reg = makeReg(COMMAND);
+				auto val = GetValue<T>(COMMAND);
+				auto reg = NRegister::MakeReg(COMMAND);
 
-				if      (COMMAND[0] == '[' && reg != REG::NUM) cpu_.push(reg, CPU<>::MemoryStorage::RAM);
-				else if (COMMAND[0] == '[' && reg == REG::NUM) cpu_.push(val, CPU<>::MemoryStorage::RAM);
-				else if (                     reg != REG::NUM) cpu_.push(reg, CPU<>::MemoryStorage::STACK);
-				else		                                   cpu_.push(val, CPU<>::MemoryStorage::STACK);
+				if      (COMMAND[0] == '[' && reg != REG::NUM) cpu_.push(reg, CPU<T>::MemoryStorage::RAM);
+				else if (COMMAND[0] == '[' && reg == REG::NUM) cpu_.push(val, CPU<T>::MemoryStorage::RAM);
+				else if (                     reg != REG::NUM) cpu_.push(reg, CPU<T>::MemoryStorage::STACK);
+				else		                                   cpu_.push(val, CPU<T>::MemoryStorage::STACK);
 			}
 			else if (comInNum == static_cast<int>(Commands::pop))
 			{
@@ -632,10 +1468,10 @@ namespace NCompiler
 
 				file >> command;
 				
-				if (COMMAND[0] == '[') { if (!skipCommand) cpu_.pop(CPU<>::MemoryStorage::RAM); }
+				if (COMMAND[0] == '[') { if (!skipCommand) cpu_.pop(CPU<T>::MemoryStorage::RAM); }
 				else
 				{
-					if (!skipCommand) cpu_.pop(CPU<>::MemoryStorage::STACK), file.seekg(std::ios::cur - COMMAND.length());
+					if (!skipCommand) cpu_.pop(CPU<T>::MemoryStorage::STACK), file.seekg(std::ios::cur - COMMAND.length());
 
 					file.seekg(oldPos);
 				}
@@ -659,24 +1495,24 @@ namespace NCompiler
 					file >> command;
 					if (!skipCommand)
 					{
-						auto reg = makeReg(command.operator const std::string&());
+						auto reg = NRegister::MakeReg(command.operator const std::string&());
 
-						if (reg != REG::NUM) cpu_.push(reg, CPU<>::MemoryStorage::STACK);
-						else                 cpu_.push(getValue(command.operator const std::string&()), CPU<>::MemoryStorage::STACK);
+						if (reg != REG::NUM) cpu_.push(reg, CPU<T>::MemoryStorage::STACK);
+						else                 cpu_.push(GetValue<T>(command.operator const std::string&()), CPU<T>::MemoryStorage::STACK);
 					}
 				};
 
 				pushVal();
 				pushVal();
 			}
-			else if (comInNum == static_cast<int>(Commands::jump)) { file >> command; if (skipCommand) continue; Move2LabelBin(file, command.operator const std::string&()); }
+			else if (comInNum == static_cast<int>(Commands::jump)) { file >> command; if (skipCommand) continue; cpu_.branch(true); Move2LabelBin(file, ':' + COMMAND); }
 
-			else if (comInNum == static_cast<int>(Commands::je))  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first == pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (comInNum == static_cast<int>(Commands::jne)) { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first != pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (comInNum == static_cast<int>(Commands::ja))  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first  > pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (comInNum == static_cast<int>(Commands::jae)) { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first >= pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (comInNum == static_cast<int>(Commands::jb))  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first  < pair.second) Move2LabelBin(file, command.operator const std::string&()); }
-			else if (comInNum == static_cast<int>(Commands::jbe)) { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (pair.first <= pair.second) Move2LabelBin(file, command.operator const std::string&()); }
+			else if (comInNum == static_cast<int>(Commands::je))  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first == pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (comInNum == static_cast<int>(Commands::jne)) { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first != pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (comInNum == static_cast<int>(Commands::ja))  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first  > pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (comInNum == static_cast<int>(Commands::jae)) { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first >= pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (comInNum == static_cast<int>(Commands::jb))  { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first  < pair.second)) Move2LabelBin(file, ':' + COMMAND); }
+			else if (comInNum == static_cast<int>(Commands::jbe)) { file >> command; if (skipCommand) continue; auto pair = cpu_.getPair(); if (cpu_.branch(pair.first <= pair.second)) Move2LabelBin(file, ':' + COMMAND); }
 
 			else if (comInNum == static_cast<int>(Commands::move))
 			{
@@ -686,11 +1522,11 @@ namespace NCompiler
 
 				if (skipCommand) continue;
 
-				bool isArg0Reg = isReg(arg0.operator const std::string&()),
-					 isArg1Reg = isReg(arg1.operator const std::string&());
+				bool isArg0Reg = NRegister::IsReg(arg0.operator const std::string&()),
+					 isArg1Reg = NRegister::IsReg(arg1.operator const std::string&());
 
-				if      ( isArg0Reg &&  isArg1Reg) cpu_.move(makeReg(arg0.operator const std::string&()), makeReg(arg1.operator const std::string&()));
-				else if (!isArg0Reg &&  isArg1Reg) cpu_.move(getValue(arg0.operator const std::string&()), makeReg(arg1.operator const std::string&()));
+				if      ( isArg0Reg &&  isArg1Reg) cpu_.move(NRegister::MakeReg(arg0.operator const std::string&()), NRegister::MakeReg(arg1.operator const std::string&()));
+				else if (!isArg0Reg &&  isArg1Reg) cpu_.move(GetValue<T>(arg0.operator const std::string&()), NRegister::MakeReg(arg1.operator const std::string&()));
 			}
 
 			else if (comInNum == static_cast<int>(Commands::call))
@@ -699,6 +1535,8 @@ namespace NCompiler
 	
 				if (skipCommand) continue;
 
+				if (pChrome_) pChrome_->begin(COMMAND, "call");
+				USDT(call, run.id(), static_cast<long long>(pc), cpu_.depth());
 				cpu_.push(file.tellg());
 				Move2LabelBin(file, COMMAND + ':');
 			}
@@ -711,15 +1549,17 @@ namespace NCompiler
 					continue;
 				}
 
+				if (pChrome_) pChrome_->end();
+				USDT(ret, run.id(), static_cast<long long>(pc), cpu_.depth());
 				file.seekg(cpu_.top());
-				cpu_.pop(CPU<>::MemoryStorage::STACK_FUNC_RET_ADDR);
+				cpu_.pop(CPU<T>::MemoryStorage::STACK_FUNC_RET_ADDR);
 			}
 
 			else if (comInNum == static_cast<int>(Commands::end)) { if (!skipCommand) break; }
 
 			else
 			{
-				NDebugger::Error("Unknown command: " + comInNum);
+				NDebugger::Error("Unknown command: " + std::to_string(comInNum), std::cerr);
 
 				file.close();
 
@@ -747,4 +1587,33 @@ namespace NCompiler
 		return std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>>().to_bytes(str.data());
 	}
 
+	template<typename Func>
+	void ForEachParallel(size_t count, Func func)
+	{
+		std::vector<std::exception_ptr> errors(count);
+		auto run = [&](size_t i)
+		{
+			try
+			{
+				func(i);
+			}
+			catch (...) // Must not leave the thread
+			{
+				errors[i] = std::current_exception();
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < count; i++)
+			threads.emplace_back(run, i);
+
+		if (count) run(0);
+
+		for (auto &&thread : threads)
+			thread.join();
+
+		for (auto &&error : errors)
+			if (error) std::rethrow_exception(error);
+	}
+
 } // NCompiler
@@ -3,11 +3,49 @@
 
 #include "Debugger.hpp"
 
+#if !defined (WIN32) && !defined (__WIN32__) && !defined(_WIN32) && !defined(_WIN32_WINNT)
+	#include <cstdio>   // stdout
+	#include <unistd.h> // isatty
+
+	#define NDEBUGGER_ANSI
+#endif /* !defined (WIN32) && !defined (__WIN32__) && !defined(_WIN32) && !defined(_WIN32_WINNT) */
+
 namespace NDebugger
 {
 
 #pragma region FUNCTION_DEFINITION
 
+#ifdef NDEBUGGER_ANSI
+
+	static WORD consoleColor = static_cast<WORD>(Colors::LightGray);
+
+	WORD GetConsoleColor()
+	{
+		return consoleColor;
+	}
+
+	WORD SetConsoleColor(WORD color)
+	{
+		static const bool IS_TERMINAL = isatty(fileno(stdout));
+		static const int  ANSI[]      = { 0, 4, 2, 6, 1, 5, 3, 7 }; // Windows color order to ANSI order
+
+		WORD old = consoleColor;
+		consoleColor = color;
+
+		if (IS_TERMINAL)
+		{
+			int text = color & 0x0F,
+			    bckg = (color >> 4) & 0x0F;
+
+			std::cout << "\x1b[" << (text & 0x08 ? 90 : 30) + ANSI[text & 0x07] << ';' << (bckg & 0x08 ? 100 : 40) + ANSI[bckg & 0x07] << 'm';
+			if (color == static_cast<WORD>(Colors::LightGray)) std::cout << "\x1b[0m";
+		}
+
+		return old;
+	}
+
+#else
+
 	WORD GetConsoleColor()
 	{
 		CONSOLE_SCREEN_BUFFER_INFO csbf;
@@ -28,11 +66,20 @@ namespace NDebugger
 		return old;
 	}
 
+#endif // NDEBUGGER_ANSI
+
 	WORD SetConsoleColor(Colors color, Colors background /* = TextColor::Black */)
 	{
 		return SetConsoleColor((static_cast<WORD>(background) << 4) | static_cast<WORD>(color));
 	}
 
+	std::mutex &ConsoleMutex()
+	{
+		static std::mutex mutex;
+
+		return mutex;
+	}
+
 #pragma endregion
 
 } // namespace NDebugger
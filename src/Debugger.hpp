@@ -6,6 +6,8 @@
 //!
 //! \brief	Header file for displaying information in a stream in different colors for Windows 
 //!
+//! \note   Other systems get the same colors through ANSI escape sequences if the standard output is a terminal
+//!
 //====================================================================================================================================
 
 #ifndef __cplusplus
@@ -14,14 +16,15 @@
 	#error
 #endif /* __cplusplus */
 
-#if !defined (WIN32) && !defined (__WIN32__) && !defined(_WIN32) && !defined(_WIN32_WINNT)
-	#error
-	#error  Windows is the only supported system.
-	#error
-#endif /* !defined (WIN32) && !defined (__WIN32__) && !defined(_WIN32) && !defined(_WIN32_WINNT) */
+#if defined (WIN32) || defined (__WIN32__) || defined(_WIN32) || defined(_WIN32_WINNT)
+	#include <Windows.h> // GetStdHandle, SetConsoleTextAttribute
+#else
+	typedef unsigned short WORD;
+#endif /* defined (WIN32) || defined (__WIN32__) || defined(_WIN32) || defined(_WIN32_WINNT) */
 
-#include <Windows.h>   // GetStdHandle, SetConsoleTextAttribute
 #include <iostream>    // std::basic_ostream
+#include <mutex>       // std::mutex, std::lock_guard
+#include <string>      // std::basic_string
 #include <string_view> // std::basic_string_view
 
 namespace NDebugger
@@ -100,6 +103,16 @@ namespace NDebugger
 
 	WORD SetConsoleColor(Colors text, Colors background = Colors::Black);
 
+//====================================================================================================================================
+//!
+//! \brief	 Mutex of the console, held by the output functions below while they change the color and write the message
+//!
+//! \note    Keeps the messages of the threads (e.g. of the parallel assembler) whole and their colors right
+//! 
+//====================================================================================================================================
+
+	std::mutex &ConsoleMutex();
+
 //====================================================================================================================================
 //!
 //! \brief	Outputs message as '[ERROR] message\n' ([ERROR] in red)
@@ -233,6 +246,8 @@ namespace NDebugger
 	template<typename Char, typename Traits>
 	void Error(std::basic_string_view<Char, Traits> message, std::basic_ostream<Char, Traits> &rOstr)
 	{
+		std::lock_guard<std::mutex> lock(ConsoleMutex());
+
 		auto old = SetConsoleColor(Colors::Red);
 
 		rOstr << "[ERROR] ";
@@ -251,6 +266,8 @@ namespace NDebugger
 	template<typename Char, typename Traits>
 	void Log(std::basic_string_view<Char, Traits> message, std::basic_ostream<Char, Traits> &rOstr)
 	{
+		std::lock_guard<std::mutex> lock(ConsoleMutex());
+
 		auto old = SetConsoleColor(Colors::LightBlue);
 
 		rOstr << "[LOG] ";
@@ -269,6 +286,8 @@ namespace NDebugger
 	template<typename Char, typename Traits>
 	void Debug(std::basic_string_view<Char, Traits> message, std::basic_ostream<Char, Traits> &rOstr)
 	{
+		std::lock_guard<std::mutex> lock(ConsoleMutex());
+
 		auto old = SetConsoleColor(Colors::Brown);
 
 		rOstr << "[DEBUG] ";
@@ -291,6 +310,8 @@ namespace NDebugger
 		      Colors                                bckg  /* = Colors::Black */, 
 		      bool                                  endl  /* = true */)
 	{
+		std::lock_guard<std::mutex> lock(ConsoleMutex());
+
 		auto old = SetConsoleColor(color, bckg);
 
 		rOstr << message.data(); 
@@ -1,23 +1,118 @@
 #pragma once
 
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::string
+#include <string_view>     // std::string_view
+
 #include "Hash.hpp"
+#include "Probes.hpp"
+#include "Stats.hpp"
 
 #if   GUARD_LVL == 3
 	#define   HASH_GUARD(...) __VA_ARGS__
 	#define CANARY_GUARD(...) __VA_ARGS__
-	#define  GUARD_CHECK(   ) if(!this->ok()) std::cerr << "[ERROR] "<< __FUNCTION__ << std::endl, this->dump();
+	#define  GUARD_CHECK(   ) STATS(NStats::guardChecks++;) if(!this->ok()) { USDT(guard__fail, this, __FUNCTION__); std::cerr << "[ERROR] "<< __FUNCTION__ << std::endl, this->dump(); }
 #elif GUARD_LVL == 2
 	#define   HASH_GUARD(...) 
 	#define CANARY_GUARD(...) __VA_ARGS__
-	#define  GUARD_CHECK(   ) if(!this->ok()) std::cerr << "[ERROR] "<< __FUNCTION__ << std::endl, this->dump();
+	#define  GUARD_CHECK(   ) STATS(NStats::guardChecks++;) if(!this->ok()) { USDT(guard__fail, this, __FUNCTION__); std::cerr << "[ERROR] "<< __FUNCTION__ << std::endl, this->dump(); }
 #elif GUARD_LVL == 1
 	#define   HASH_GUARD(...) 
 	#define CANARY_GUARD(...) 
-	#define  GUARD_CHECK(   ) if(!this->ok()) std::cerr << "[ERROR] "<< __FUNCTION__ << std::endl, this->dump();
+	#define  GUARD_CHECK(   ) STATS(NStats::guardChecks++;) if(!this->ok()) { USDT(guard__fail, this, __FUNCTION__); std::cerr << "[ERROR] "<< __FUNCTION__ << std::endl, this->dump(); }
 #else
 	#define   HASH_GUARD(...)
 	#define CANARY_GUARD(...) 
 	#define  GUARD_CHECK(   )
 #endif // GUARD_LVL
 
+#if GUARD_LVL >= 2
+
+namespace NGuard
+{
+
+#pragma region CLASSES
+
+//====================================================================================================================================
+//!
+//! \brief	Guard metadata of one object, kept out of line so that it does not share cache lines with the guarded data
+//!
+//====================================================================================================================================
+
+	struct Cold final
+	{
+		Cold(std::string_view canary, std::pmr::memory_resource *pResource);
+
+		const std::pmr::string CANARY_VALUE;
+		std::pmr::string       canaryStart,
+		                       canaryFinish;
+		HASH_GUARD(std::pmr::string hash;)
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Owns a Cold block allocated from a memory resource, takes one pointer in the guarded object
+//!
+//====================================================================================================================================
+
+	class ColdPtr final
+	{
+	public:
+		ColdPtr(std::string_view canary, std::pmr::memory_resource *pResource);
+		ColdPtr(const ColdPtr&) = delete;
+		ColdPtr(ColdPtr&&)      = delete;
+		~ColdPtr();
+
+		ColdPtr &operator=(const ColdPtr&) = delete;
+		ColdPtr &operator=(ColdPtr&&)      = delete;
+
+		Cold *operator->() const noexcept;
+
+		std::pmr::memory_resource *resource() const noexcept;
+
+	private:
+		Cold *pCold_;
+	};
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Cold::Cold(std::string_view canary, std::pmr::memory_resource *pResource) :
+		CANARY_VALUE(canary, pResource),
+		canaryStart(canary, pResource),
+		canaryFinish(canary, pResource)
+		HASH_GUARD(, hash(pResource))
+	{ }
+
+	inline ColdPtr::ColdPtr(std::string_view canary, std::pmr::memory_resource *pResource) :
+		pCold_(nullptr)
+	{
+		std::pmr::polymorphic_allocator<Cold> alloc(pResource);
+
+		pCold_ = alloc.allocate(1);
+		alloc.construct(pCold_, canary, pResource);
+	}
+
+	inline ColdPtr::~ColdPtr()
+	{
+		std::pmr::polymorphic_allocator<Cold> alloc(resource());
+
+		alloc.destroy(pCold_);
+		alloc.deallocate(pCold_, 1);
+	}
+
+	inline Cold *ColdPtr::operator->() const noexcept
+	{
+		return pCold_;
+	}
+
+	inline std::pmr::memory_resource *ColdPtr::resource() const noexcept
+	{
+		return pCold_->CANARY_VALUE.get_allocator().resource();
+	}
+
+#pragma endregion
+
+} // namespace NGuard
 
+#endif // GUARD_LVL >= 2
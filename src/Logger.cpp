@@ -23,6 +23,10 @@ std::ofstream Logger::log_;
 
 bool Logger::init_ = false;
 
+NLog::AsyncBackend Logger::backend_(Logger::log_);
+
+std::atomic<unsigned char> Logger::levels_[static_cast<size_t>(Subsystem::NUM)] = {}; // Everything compiled in is written
+
 #pragma endregion
 
 //====================================================================================================================================
@@ -50,6 +54,8 @@ bool Logger::init()
 
 	log_ << "[DEBUG][" << __TIME__ << "][" << std::setw(LOG_FUNC_SIZE) << "Logger" << "] Logging started\n";
 
+	backend_.start();
+
 	return true;
 }
 
@@ -58,7 +64,10 @@ bool Logger::close()
 	if (!init_) return false;
 	
 	init_ = false;
-	write("Logger", "Logging finished");
+	backend_.stop();
+
+	stdPack("Logger");
+	log_ << "Logging finished" << std::endl;
 
 	log_.close();
 
@@ -70,33 +79,37 @@ std::ofstream &Logger::getOfstream()
 	return log_;
 }
 
-bool Logger::stdPack(std::string_view func, Type type /* = Type::Debug */)
+std::unique_lock<std::recursive_mutex> Logger::lock()
+{
+	return backend_.lock();
+}
+
+void Logger::setLevel(Subsystem subsystem, Level level) noexcept
+{
+	levels_[static_cast<size_t>(subsystem)].store(static_cast<unsigned char>(level), std::memory_order_relaxed);
+}
+
+bool Logger::stdPack(std::string_view func, Level level /* = Level::Debug */)
 {
 	if (!log_.is_open()) return false;
 
+	auto lock = backend_.lock();
+
 	using std::chrono::system_clock;
 	auto tt = system_clock::to_time_t(system_clock::now());
 
-	std::tm *ptm = new tm;
-	localtime_s(ptm, &tt);
+	std::tm tm = NLog::LocalTime(tt);
 
-	log_ << "[" << (type == Type::Debug ? "DEBUG]" : "RELEASE]") << "["
-		 << std::put_time(ptm, "%X")
-		 << "][" << std::setw(LOG_FUNC_SIZE) << func.data() << "] ";
-
-	delete ptm;
+	log_ << "[" << NLog::LevelName(level) << "]["
+		 << std::put_time(&tm, "%X")
+		 << "][" << std::setw(LOG_FUNC_SIZE) << func << "] ";
 
 	return true;
 }
 
-bool Logger::write(std::string_view func, std::string_view info, Type type)
+bool Logger::write(std::string_view func, std::string_view info, Level level /* = Level::Debug */)
 {
-	if (!stdPack(func, type))
-		return false;
-
-	log_ << info.data() << std::endl;
-
-	return false;
+	return backend_.push(level, func, info);
 }
 
 #pragma endregion
\ No newline at end of file
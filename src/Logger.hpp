@@ -1,9 +1,35 @@
 #pragma once
 
-#include <vector>  // std::vector
-#include <fstream> // std::ofstream
+#include <algorithm>   // std::min
+#include <array>       // std::array
+#include <atomic>      // std::atomic
+#include <charconv>    // std::to_chars
+#include <cstdio>      // std::snprintf
+#include <cstdint>     // uintptr_t
+#include <cstring>     // std::memcpy
+#include <fstream>     // std::ofstream
+#include <mutex>       // std::unique_lock, std::recursive_mutex
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_integral, std::is_floating_point
 
 #include "Debugger.hpp"
+#include "AsyncLog.hpp"
+
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+// Records below this level are removed at compile time (0 - Trace, ..., 4 - Error, 5 - Off)
+#ifndef LOG_MIN_LEVEL
+	#ifdef _DEBUG
+		#define LOG_MIN_LEVEL 0
+	#else
+		#define LOG_MIN_LEVEL 4
+	#endif // _DEBUG
+#endif // LOG_MIN_LEVEL
+
+// Classes and namespaces declare their own LOG_SUBSYSTEM, this one is found for the rest
+constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::General;
 
 //====================================================================================================================================
 //==============================================================CLASSES===============================================================
@@ -12,11 +38,8 @@
 class Logger
 {
 public:
-	enum class Type
-	{
-		Debug,
-		Release
-	};
+	typedef NLog::Level     Level;
+	typedef NLog::Subsystem Subsystem;
 
 	Logger();
 	~Logger() = default;
@@ -24,28 +47,95 @@ public:
 	static bool init();
 	static bool close();
 
+//====================================================================================================================================
+//!
+//! \brief	 Returns the log file, it may be written directly only while lock() is held
+//!
+//! \return  Log file
+//!
+//====================================================================================================================================
+
 	static std::ofstream &getOfstream();
 
-	template<typename... T>
-	static void printData(std::string_view func, const T &...data)
+//====================================================================================================================================
+//!
+//! \brief	 Writes all the pending records and keeps the background writer off the log file
+//!
+//! \return  Lock, hold it while writing to getOfstream() directly
+//!
+//====================================================================================================================================
+
+	static std::unique_lock<std::recursive_mutex> lock();
+
+//====================================================================================================================================
+//!
+//! \brief	 Checks the runtime filter, the only cost of a disabled record which is compiled in
+//!
+//! \param   level      Level of the record
+//! \param   subsystem  Where the record comes from
+//!
+//! \return  Should the record be written
+//!
+//====================================================================================================================================
+
+	static bool enabled(Level level, Subsystem subsystem) noexcept
 	{
-		stdPack(func);
+		return (static_cast<unsigned char>(level) >= levels_[static_cast<size_t>(subsystem)].load(std::memory_order_relaxed));
+	}
+
+	static void setLevel(Subsystem, Level) noexcept;
 
-		std::vector<typename std::common_type<T...>::type> vec{ static_cast<typename std::common_type<T...>::type>(data)... };
+//====================================================================================================================================
+//!
+//! \brief	 Writes "ARG1: data1, ARG2: data2, ..." without touching the heap, the text is truncated to the record size
+//!
+//! \param   level  Level of the record
+//! \param   func   Where the record comes from
+//! \param   data   Numbers, enums, pointers or strings
+//!
+//====================================================================================================================================
 
-		auto size = vec.size();
-		for (size_t i = 0; i < size; ++i)
-		{		
-			log_ << "ARG" << i + 1 << ": " << static_cast<typename std::common_type<T...>::type>(vec[i]) << (i + 1 == size ? "\n" : ", ");
-		}
+	template<typename... T>
+	static void printData(Level level, std::string_view func, const T &...data)
+	{
+		std::array<char, NLog::INFO_SIZE> buf;
+
+		size_t length = 0,
+		       i      = 0;
+		auto put = [&](const auto &crVal) noexcept
+		{
+			++i;
+			length = append(buf, length, (i > 1 ? ", ARG" : "ARG"), i, ": ", crVal);
+		};
+		(put(data), ...);
+
+		write(func, std::string_view(buf.data(), length), level);
 	}
 
-	static bool stdPack(std::string_view, Type = Type::Debug);
-	static bool write(std::string_view, std::string_view, Type = Type::Debug);
+	static bool stdPack(std::string_view, Level = Level::Debug);
+
+//====================================================================================================================================
+//!
+//! \brief	 Queues the record, the calling thread never waits for the disk
+//!
+//! \param   func   Where the record comes from
+//! \param   info   Message
+//! \param   level  Level of the record
+//!
+//! \return  False if logging is not started or the record was dropped
+//!
+//====================================================================================================================================
+
+	static bool write(std::string_view, std::string_view, Level = Level::Debug);
 
 private:
-	static std::ofstream log_;
-	static bool          init_;
+	static std::ofstream              log_;
+	static bool                       init_;
+	static NLog::AsyncBackend         backend_; // Must be destroyed before log_
+	static std::atomic<unsigned char> levels_[static_cast<size_t>(Subsystem::NUM)]; // Minimum level of every subsystem
+
+	template<typename U, typename... Rest>
+	static size_t append(std::array<char, NLog::INFO_SIZE> &rBuf, size_t length, const U &crVal, const Rest &...rest) noexcept;
 };
 
 //====================================================================================================================================
@@ -55,6 +145,54 @@ private:
 template<typename T>
 inline Logger &operator<<(Logger&, const T&);
 
+//====================================================================================================================================
+//=========================================================METHOD_DEFINITION==========================================================
+//====================================================================================================================================
+
+template<typename U, typename... Rest>
+inline size_t Logger::append(std::array<char, NLog::INFO_SIZE> &rBuf, size_t length, const U &crVal, const Rest &...rest) noexcept
+{
+	char *pFirst = rBuf.data() + length,
+	     *pLast  = rBuf.data() + rBuf.size();
+
+	if constexpr (std::is_same_v<U, bool>)
+		return append(rBuf, length, (crVal ? "true" : "false"), rest...);
+
+	else if constexpr (std::is_enum_v<U>)
+		return append(rBuf, length, static_cast<std::underlying_type_t<U>>(crVal), rest...);
+
+	else if constexpr (std::is_integral_v<U>)
+	{
+		auto res = std::to_chars(pFirst, pLast, crVal);
+		if (res.ec == std::errc()) length = static_cast<size_t>(res.ptr - rBuf.data());
+	}
+	else if constexpr (std::is_floating_point_v<U>)
+	{
+		int num = std::snprintf(pFirst, static_cast<size_t>(pLast - pFirst), "%g", static_cast<double>(crVal));
+		if (num > 0) length = std::min(length + static_cast<size_t>(num), rBuf.size() - 1); // snprintf keeps place for '\0'
+	}
+	else if constexpr (std::is_convertible_v<const U&, std::string_view>)
+	{
+		std::string_view str(crVal);
+		size_t           num = std::min(str.length(), rBuf.size() - length);
+
+		std::memcpy(pFirst, str.data(), num);
+		length += num;
+	}
+	else if constexpr (std::is_pointer_v<U>)
+	{
+		auto res = std::to_chars(pFirst, pLast, reinterpret_cast<uintptr_t>(crVal), 1 << 4);
+		if (res.ec == std::errc()) length = static_cast<size_t>(res.ptr - rBuf.data());
+	}
+	else
+		static_assert(std::is_pointer_v<U>, "Logger cannot format this type without the heap\n");
+
+	if constexpr (sizeof...(Rest) != 0)
+		return append(rBuf, length, rest...);
+	else
+		return length;
+}
+
 //====================================================================================================================================
 //========================================================FUNCTION_DEFINITION=========================================================
 //====================================================================================================================================
@@ -62,7 +200,8 @@ inline Logger &operator<<(Logger&, const T&);
 template<typename T>
 inline Logger &operator<<(Logger &rLog, const T &crVal)
 {
-	rLog.log_ << crVal;
+	auto lock = Logger::lock();
+	rLog.getOfstream() << crVal;
 
 	return rLog;
 }
@@ -71,19 +210,20 @@ inline Logger &operator<<(Logger &rLog, const T &crVal)
 //==============================================================DEFINES===============================================================
 //====================================================================================================================================
 
-#ifdef _DEBUG
-	#define LOG_DUMP()			Logger a; a << *this;
-	#define LOG_CONSTRUCTING()  Logger::write(__FUNCTION__, "Constructing");
-	#define LOG_DESTRUCTING()   Logger::write(__FUNCTION__, "Destructing");
-	#define LOG_ERROR(error)    Logger::write(__FUNCTION__ + "\t[ERROR]", error);
-	#define LOG_ARGS(type, ...) Logger::printData<type>(__FUNCTION__, __VA_ARGS__);
-	#define LOG_FUNC()          Logger::write(__FUNCTION__, "");
-#else
-	#define LOG_DUMP()      
-	#define LOG_CONSTRUCTING()  
-	#define LOG_DESTRUCTING()
-	#define LOG_ERROR(error)    Logger::write(__FUNCTION__ + std::string("\t[ERROR]"), error);
-	#define LOG_ARGS()      
-	#define LOG_FUNC()
-#endif // _DEBUG
+// Statement runs only if the level is compiled in and passes the filter of LOG_SUBSYSTEM
+#define LOG_AT(level, ...)                                                                      \
+	{                                                                                           \
+		if constexpr (static_cast<int>(Logger::Level::level) >= LOG_MIN_LEVEL)                 \
+		{                                                                                       \
+			if (Logger::enabled(Logger::Level::level, LOG_SUBSYSTEM)) { __VA_ARGS__; }          \
+		}                                                                                       \
+	}
+
+#define LOG_DUMP()                LOG_AT(Debug, Logger a; a << *this)
+#define LOG_CONSTRUCTING()        LOG_AT(Trace, Logger::write(__FUNCTION__, "Constructing", Logger::Level::Trace))
+#define LOG_DESTRUCTING()         LOG_AT(Trace, Logger::write(__FUNCTION__, "Destructing",  Logger::Level::Trace))
+#define LOG_ERROR(error)          LOG_AT(Error, Logger::write(__FUNCTION__, error,          Logger::Level::Error))
+#define LOG_MESSAGE(level, info)  LOG_AT(level, Logger::write(__FUNCTION__, info,           Logger::Level::level))
+#define LOG_ARGS(...)             LOG_AT(Trace, Logger::printData(Logger::Level::Trace, __FUNCTION__, __VA_ARGS__))
+#define LOG_FUNC()                LOG_AT(Trace, Logger::write(__FUNCTION__, "",             Logger::Level::Trace))
 
@@ -1,13 +1,13 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
-#include <iostream> // std::cout
-#include <iomanip>  // std::setw
-#include <sstream>  // std::stringstream
-#include <fstream>  // std::ifstream
-#include <string>   // std::to_string
-#include <cassert>  // assert
-#include <memory>   // std::unique_ptr
+#include <algorithm> // std::min, std::max, std::copy, std::fill, std::count
+#include <iostream>  // std::cout
+#include <iomanip>   // std::setw
+#include <fstream>   // std::ifstream
+#include <string>    // std::to_string
+#include <cassert>   // assert
+#include <memory>    // std::unique_ptr
 
 #include "Parser.hpp"
 #include "Logger.hpp"
@@ -15,12 +15,40 @@
 namespace NParser
 {
 
+//====================================================================================================================================
+//=============================================================CONSTANTS==============================================================
+//====================================================================================================================================
+
+	constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::Parser;
+
 //====================================================================================================================================
 //=========================================================METHOD_DEFINITION==========================================================
 //====================================================================================================================================
 
 #pragma region METHOD_DEFINITION
 
+	static_assert(Operation::MAX_ARGS == 3, "Update Operation constructors\n");
+
+	Operation::Operation(const allocator_type &crAlloc /* = allocator_type() */) :
+		cmd(crAlloc),
+		args({ std::pmr::string(crAlloc), std::pmr::string(crAlloc), std::pmr::string(crAlloc) })
+	{ }
+
+	Operation::Operation(const Statement &crStatement, const allocator_type &crAlloc /* = allocator_type() */) :
+		cmd(crStatement.cmd, crAlloc),
+		args({ std::pmr::string(crStatement.args[0], crAlloc), std::pmr::string(crStatement.args[1], crAlloc), std::pmr::string(crStatement.args[2], crAlloc) })
+	{ }
+
+	Operation::Operation(const Operation &crOp, const allocator_type &crAlloc) :
+		cmd(crOp.cmd, crAlloc),
+		args({ std::pmr::string(crOp.args[0], crAlloc), std::pmr::string(crOp.args[1], crAlloc), std::pmr::string(crOp.args[2], crAlloc) })
+	{ }
+
+	Operation::Operation(Operation &&rrOp, const allocator_type &crAlloc) :
+		cmd(std::move(rrOp.cmd), crAlloc),
+		args({ std::pmr::string(std::move(rrOp.args[0]), crAlloc), std::pmr::string(std::move(rrOp.args[1]), crAlloc), std::pmr::string(std::move(rrOp.args[2]), crAlloc) })
+	{ }
+
 	Operation &Operation::operator=(const Operation &crOp) noexcept
 	{
 		if (this != &crOp)
@@ -65,6 +93,125 @@ namespace NParser
 		rOstr << std::endl;
 	}
 
+	Lexer::Lexer(std::string_view source, size_t firstLine /* = 1 */) noexcept :
+		source_(source),
+		pos_(NULL),
+		line_(firstLine),
+		lineStart_(NULL),
+		pError_(nullptr),
+		errorLine_(NULL),
+		errorColumn_(NULL),
+		chunk_(std::string_view::npos),
+		masks_()
+	{ }
+
+	bool Lexer::next(Statement &rStatement)
+	{
+		if (pError_) return false;
+
+		size_t tokens = 0,
+		       first  = 0, // Where the line of the statement starts and ends
+		       last   = 0;
+		while (pos_ < source_.length())
+		{
+			size_t start = find(pos_, false);
+			if (start == source_.length())
+			{
+				pos_ = start;
+				break;
+			}
+
+			if (source_[start] == '\n')
+			{
+				pos_ = lineStart_ = start + 1;
+				line_++;
+
+				if (tokens) break;
+				continue;
+			}
+
+			size_t end = find(start, true);
+			if (!tokens)
+			{
+				rStatement.cmd    = source_.substr(start, end - start);
+				rStatement.args   = { };
+				rStatement.line   = line_;
+				rStatement.column = start - lineStart_ + 1;
+
+				first = lineStart_;
+			}
+			else if (tokens <= Operation::MAX_ARGS)
+				rStatement.args[tokens - 1] = source_.substr(start, end - start);
+			else
+			{
+				pError_      = "Too many operands";
+				errorLine_   = line_;
+				errorColumn_ = start - lineStart_ + 1;
+
+				return false;
+			}
+
+			tokens++;
+			pos_ = last = end;
+		}
+
+		if (!tokens) return false;
+
+		LOG_MESSAGE(Debug, source_.substr(first, last - first))
+
+		return true;
+	}
+
+	size_t Lexer::find(size_t pos, bool inToken) noexcept
+	{
+		while (pos < source_.length())
+		{
+			if (pos < chunk_ || pos >= chunk_ + LEXER_CHUNK) classify(pos - pos % LEXER_CHUNK);
+
+			auto &&masks = masks_[(pos - chunk_) / NScanner::BLOCK];
+			size_t bit   = pos % NScanner::BLOCK;
+
+			uint64_t stops = (inToken ? ~masks.tokens : (masks.tokens | masks.newlines)) >> bit << bit;
+			if (stops) return std::min(pos - bit + NScanner::FirstBit(stops), source_.length());
+
+			pos += NScanner::BLOCK - bit;
+		}
+
+		return source_.length();
+	}
+
+	void Lexer::classify(size_t chunk) noexcept
+	{
+		chunk_ = chunk;
+
+		for (auto &&masks : masks_)
+		{
+			if (chunk + NScanner::BLOCK <= source_.length())
+				masks = NScanner::Classify(source_.data() + chunk);
+			else if (chunk < source_.length())
+			{ // The tail is copied, so the vectors do not read past the source
+				char tail[NScanner::BLOCK];
+				std::fill(std::copy(source_.data() + chunk, source_.data() + source_.length(), tail), tail + NScanner::BLOCK, '\n');
+
+				masks = NScanner::Classify(tail);
+			}
+			else
+				masks = { 0, ~uint64_t(0) };
+
+			chunk += NScanner::BLOCK;
+		}
+	}
+
+	bool Lexer::failed() const noexcept
+	{
+		return pError_;
+	}
+
+	std::string Lexer::error() const
+	{
+		return (pError_ ? std::string(pError_) + " at " + Position(errorLine_, errorColumn_) : std::string());
+	}
+
 #pragma endregion
 
 //====================================================================================================================================
@@ -75,6 +222,8 @@ namespace NParser
 
 	Logger &operator<<(Logger &rLogger, const Operation &crOp)
 	{
+		auto lock = Logger::lock(); // The dump goes to the file directly
+
 		if(crOp.cmd.length()) Logger::stdPack("Parser");
 
 		crOp.dump(Logger::getOfstream());
@@ -82,31 +231,75 @@ namespace NParser
 		return rLogger;
 	}
 
-	static inline bool IsCommaExist(std::string_view line) 
-	{ 
-		return (line.empty() ? false : (line.back() == ','));
+	Operation ParseCode(std::string_view line, const Operation::allocator_type &crAlloc /* = Operation::allocator_type() */)
+	{
+		Lexer     lexer(line);
+		Statement statement{};
+		lexer.next(statement); // Too many operands leave the first ones, the extra are dropped as before
+
+		Operation op(statement, crAlloc);
+
+		LOG_AT(Trace, op.dump())
+
+		return op;
+	}
+
+	bool ReadSource(const std::filesystem::path &crPath, std::string &rSource)
+	{
+		std::ifstream file(crPath, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) return false;
+
+		auto size = file.tellg();
+		if (size < 0) return false;
+
+		rSource.resize(static_cast<size_t>(size));
+		file.seekg(0);
+
+		return static_cast<bool>(file.read(rSource.data(), size));
 	}
 
-	Operation ParseCode(std::string_view line)
+	std::vector<Chunk> SplitSource(std::string_view source, size_t parts)
 	{
-		Operation op;
-		std::stringstream sstr(line.data());
-		sstr >> op.cmd;
+		parts = std::max<size_t>(std::min(parts, source.length() / MIN_CHUNK), 1);
 
-		for (auto&& word : op.args)
+		std::vector<Chunk> chunks;
+		size_t             start = 0,
+		                   line  = 1;
+		for (size_t i = 1; i <= parts && start < source.length(); i++)
 		{
-			sstr >> word;
-			if (IsCommaExist(word)) word.pop_back();
+			size_t end = (i == parts ? source.length() : source.find('\n', std::max(start, source.length() / parts * i)));
+			end = (end == std::string_view::npos ? source.length() : end + 1); // The newline stays in its line
+
+			chunks.push_back({ source.substr(start, end - start), line });
+			line += static_cast<size_t>(std::count(source.data() + start, source.data() + end, '\n'));
+
+			start = end;
 		}
 
-		if (op.cmd.length()) Logger::stdPack("Parser");
-		op.dump(Logger::getOfstream());
+		if (chunks.empty())
+			chunks.push_back({ source, 1 });
 
-#ifdef _DEBUG
-		op.dump();
-#endif // DEBUG
+		return chunks;
+	}
 
-		return op;
+	std::string Position(size_t line, size_t column)
+	{
+		return ("line " + std::to_string(line) + ", column " + std::to_string(column));
+	}
+
+	size_t Column(const Statement &crStatement, std::string_view token) noexcept
+	{ // Tokens of a statement point into the same line
+		return crStatement.column + static_cast<size_t>(token.data() - crStatement.cmd.data());
+	}
+
+	bool IsImmediate(std::string_view arg) noexcept
+	{
+		if (!arg.empty() && arg.front() == '[') arg.remove_prefix(1);
+		if (arg.empty()) return false;
+
+		char ch = arg.front();
+
+		return ((ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.');
 	}
 
 	bool Move2Label(std::ifstream &rCode, std::string_view label, std::streampos startFrom /* = std::ios::beg */)
@@ -1,8 +1,17 @@
- #pragma once
+#pragma once
 
-#include <array> // std::array
+#include <array>           // std::array
+#include <charconv>        // std::from_chars
+#include <filesystem>      // std::filesystem::path
+#include <limits>          // std::numeric_limits
+#include <memory_resource> // std::pmr::string, std::pmr::polymorphic_allocator
+#include <string>          // std::string
+#include <string_view>     // std::string_view
+#include <type_traits>     // std::is_integral_v, std::is_floating_point_v, std::is_signed_v
+#include <vector>          // std::vector
 
 #include "Debugger.hpp"
+#include "Scanner.hpp"
 
 class Logger;
 
@@ -13,22 +22,30 @@ namespace NParser
 //=============================================================CONSTANTS==============================================================
 //====================================================================================================================================
 
-	constexpr size_t MAX_LINE_LENGTH = 1 << 8;
+	constexpr size_t LEXER_CHUNK = 1 << 12; // Bytes classified at once
+	constexpr size_t MIN_CHUNK   = 1 << 18; // Smaller parts of the source are not worth a thread
 
 //====================================================================================================================================
 //==============================================================CLASSES===============================================================
 //====================================================================================================================================
 
+	struct Statement;
+
 	struct Operation
 	{
+		typedef std::pmr::polymorphic_allocator<char> allocator_type; // Lets std::pmr containers pass their resource down
+
 		static constexpr unsigned short MAX_ARGS = (1 << 2) - 1;
 
-		std::string                       cmd;
-		std::array<std::string, MAX_ARGS> args;
+		std::pmr::string                       cmd;
+		std::array<std::pmr::string, MAX_ARGS> args;
 
-		explicit Operation()        = default;
+		explicit Operation(const allocator_type& = allocator_type());
+		explicit Operation(const Statement&, const allocator_type& = allocator_type());
 		Operation(const Operation&) = default;
+		Operation(const Operation&, const allocator_type&);
 		Operation(Operation&&)      = default;
+		Operation(Operation&&, const allocator_type&);
 		~Operation()                = default;
 
 		Operation &operator=(const Operation&) noexcept;
@@ -37,6 +54,96 @@ namespace NParser
 		void dump(std::ostream& = std::cout) const;
 	};
 
+//====================================================================================================================================
+//!
+//! \brief	Non-empty line of the source, the tokens point into the source and are valid as long as it is
+//!
+//====================================================================================================================================
+
+	struct Statement
+	{
+		std::string_view                                  cmd;
+		std::array<std::string_view, Operation::MAX_ARGS> args;
+		size_t                                            line,   // From 1
+		                                                  column; // Of the cmd, from 1
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Part of the source made of whole lines, lexed on its own by a thread
+//!
+//====================================================================================================================================
+
+	struct Chunk
+	{
+		std::string_view text;
+		size_t           line; // Of the first byte, from 1
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Splits the whole source into statements without allocations, lines may be of any length
+//!
+//! \note   Bytes are classified by NScanner a chunk at a time, tokens and lines are then found by the bits of the masks.
+//!         Commas between the operands are optional.
+//!
+//====================================================================================================================================
+
+	class Lexer final
+	{
+	public:
+		explicit Lexer(std::string_view source, size_t firstLine = 1) noexcept; // Line of the first byte, for a Chunk
+
+//====================================================================================================================================
+//!
+//! \brief	 Takes the next statement, empty lines are skipped
+//!
+//! \param   rStatement  Where to put the statement
+//!
+//! \return  False at the end of the source or on an error, see failed()
+//!
+//====================================================================================================================================
+
+		bool next(Statement &rStatement);
+
+		bool failed() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Describes the error with its position, empty if there is none
+//!
+//====================================================================================================================================
+
+		std::string error() const;
+
+	private:
+		std::string_view source_;
+		size_t           pos_,
+		                 line_,
+		                 lineStart_;
+		const char      *pError_;
+		size_t           errorLine_,
+		                 errorColumn_;
+		size_t           chunk_; // Offset of the classified chunk
+
+		std::array<NScanner::Masks, LEXER_CHUNK / NScanner::BLOCK> masks_;
+
+//====================================================================================================================================
+//!
+//! \brief	 Finds the first byte from pos which ends the token or, out of a token, starts a token or a line
+//!
+//! \param   pos      Where to start
+//! \param   inToken  Is pos in a token
+//!
+//! \return  Offset of the byte, the length of the source if there is none
+//!
+//====================================================================================================================================
+
+		size_t find(size_t pos, bool inToken) noexcept;
+
+		void classify(size_t chunk) noexcept;
+	};
+
 //====================================================================================================================================
 //========================================================FUNCTION_DECLARATION========================================================
 //====================================================================================================================================
@@ -45,7 +152,69 @@ namespace NParser
 
 	Logger &operator<<(Logger&, const Operation&);
 
-	Operation ParseCode(std::string_view);
+	Operation ParseCode(std::string_view, const Operation::allocator_type& = Operation::allocator_type());
+
+//====================================================================================================================================
+//!
+//! \brief	 Reads the whole file with one allocation
+//!
+//! \param   crPath   File to read
+//! \param   rSource  Where to put the content
+//!
+//! \return  False if the file cannot be read
+//!
+//====================================================================================================================================
+
+	bool ReadSource(const std::filesystem::path &crPath, std::string &rSource);
+
+//====================================================================================================================================
+//!
+//! \brief	 Splits the source at line boundaries into about equal chunks
+//!
+//! \param   source  Whole source
+//! \param   parts   Number of the chunks wanted
+//!
+//! \return  At most parts non-empty chunks in the order of the source, one if the source is too short to split
+//!
+//====================================================================================================================================
+
+	std::vector<Chunk> SplitSource(std::string_view source, size_t parts);
+
+	std::string Position(size_t line, size_t column);
+
+//====================================================================================================================================
+//!
+//! \brief	 Column of the token of the statement
+//!
+//====================================================================================================================================
+
+	size_t Column(const Statement &crStatement, std::string_view token) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Tells the immediates from the registers and the labels, which start with a letter
+//!
+//! \param   arg  Operand, may be a RAM address in brackets
+//!
+//====================================================================================================================================
+
+	bool IsImmediate(std::string_view arg) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Parses the immediate without the locale: 42, -7, +3, 0x1F, -0b101, 2.5, 1e-6, [16]
+//!
+//! \param   arg   Operand, may be a RAM address in brackets
+//! \param   rVal  Where to put the value
+//!
+//! \return  False if the literal is malformed or out of the range of T
+//!
+//! \note    A decimal fraction given to an integer T is truncated towards zero, as the stream did
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	bool ParseValue(std::string_view arg, T &rVal) noexcept;
 
 	bool Move2Label(std::ifstream&, std::string_view, std::streampos = std::ios::beg);
 
@@ -53,4 +222,77 @@ namespace NParser
 	
 #pragma endregion
 
+//====================================================================================================================================
+//========================================================FUNCTION_DEFINITION=========================================================
+//====================================================================================================================================
+
+#pragma region FUNCTION_DEFINITION
+
+	template<typename T>
+	bool ParseValue(std::string_view arg, T &rVal) noexcept
+	{
+		static_assert(std::is_integral_v<T> || std::is_floating_point_v<T>, "Immediates are numbers");
+
+		if (!arg.empty() && arg.front() == '[')
+		{
+			arg.remove_prefix(1);
+			if (!arg.empty() && arg.back() == ']') arg.remove_suffix(1);
+		}
+
+		bool negative = (!arg.empty() && arg.front() == '-');
+		if (!arg.empty() && (arg.front() == '-' || arg.front() == '+')) arg.remove_prefix(1);
+
+		const char *pFirst = arg.data(),
+		           *pLast  = arg.data() + arg.length();
+
+		int base = 10;
+		if (arg.length() > 2 && arg[0] == '0' && (arg[1] == 'x' || arg[1] == 'X' || arg[1] == 'b' || arg[1] == 'B'))
+		{
+			base    = (arg[1] == 'x' || arg[1] == 'X' ? 16 : 2);
+			pFirst += 2;
+		}
+
+		if (base != 10 || std::is_integral_v<T>)
+		{
+			unsigned long long magnitude = 0;
+			auto [pEnd, ec] = std::from_chars(pFirst, pLast, magnitude, base);
+
+			if (ec == std::errc() && pEnd == pLast)
+			{
+				if constexpr (std::is_integral_v<T>)
+				{
+					auto max = static_cast<unsigned long long>(std::numeric_limits<T>::max());
+					if (negative) max = (std::is_signed_v<T> ? max + 1 : 0);
+					if (magnitude > max) return false;
+
+					rVal = (negative && magnitude ? static_cast<T>(-static_cast<long long>(magnitude - 1) - 1) : static_cast<T>(magnitude));
+				}
+				else
+					rVal = (negative ? -static_cast<T>(magnitude) : static_cast<T>(magnitude));
+
+				return true;
+			}
+
+			if (base != 10 || ec == std::errc::result_out_of_range || pEnd == pLast || (*pEnd != '.' && *pEnd != 'e' && *pEnd != 'E'))
+				return false; // .5 has no integer part, it is a fraction too
+		}
+
+		double val = 0.; // Floating T or a fraction given to an integer one
+		auto [pEnd, ec] = std::from_chars(pFirst, pLast, val);
+		if (ec != std::errc() || pEnd != pLast || pFirst == pLast) return false;
+
+		if (negative) val = -val;
+
+		if constexpr (std::is_integral_v<T>)
+		{
+			if (!(val > static_cast<double>(std::numeric_limits<T>::min()) - 1. && val < static_cast<double>(std::numeric_limits<T>::max()) + 1.)) return false;
+		}
+
+		rVal = static_cast<T>(val);
+
+		return true;
+	}
+
+#pragma endregion
+
 } // namespace NParser
\ No newline at end of file
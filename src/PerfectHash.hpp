@@ -0,0 +1,161 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   PerfectHash.hpp
+//!
+//! \brief	Perfect hash of a fixed set of names built at compile time, a lookup is one hash and one compare
+//!
+//! \note   The constexpr constructor searches the seed, so a set without one (e.g. a repeated name) does not compile.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <array>       // std::array
+#include <cstdint>     // uint64_t
+#include <string_view> // std::string_view
+
+namespace NPerfectHash
+{
+
+#pragma region CONSTANTS
+
+	constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL,
+	                   FNV_PRIME  = 1099511628211ULL;
+
+	constexpr uint64_t MAX_SEEDS = 1 << 16;
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 FNV-1a of the key started from the seed
+//!
+//====================================================================================================================================
+
+	constexpr uint64_t Hash(std::string_view key, uint64_t seed) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Power of two with at most a quarter of the slots taken by n keys, so a seed is found in a few tries
+//!
+//====================================================================================================================================
+
+	constexpr size_t SlotsFor(size_t n) noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+	template<size_t N>
+	class Table final
+	{
+		static_assert(N < 255, "Slots hold the index of the key in a byte");
+
+	public:
+		static constexpr size_t SIZE = SlotsFor(N);
+
+		constexpr explicit Table(const std::array<std::string_view, N> &crKeys);
+
+//====================================================================================================================================
+//!
+//! \brief	 Finds the key
+//!
+//! \return  Index of the key in the array given to the constructor, N if there is no such key
+//!
+//====================================================================================================================================
+
+		constexpr size_t find(std::string_view key) const noexcept;
+
+		constexpr uint64_t seed() const noexcept;
+
+	private:
+		std::array<std::string_view, N> keys_;
+		std::array<unsigned char, SIZE> slots_; // Index of the key plus one, 0 for the empty slots
+		uint64_t                        seed_;
+
+		constexpr size_t slot(std::string_view key) const noexcept;
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	constexpr uint64_t Hash(std::string_view key, uint64_t seed) noexcept
+	{
+		uint64_t hash = FNV_OFFSET ^ (seed * FNV_PRIME);
+		for (char ch : key)
+			hash = (hash ^ static_cast<unsigned char>(ch)) * FNV_PRIME;
+
+		return (hash ^ (hash >> 29));
+	}
+
+	constexpr size_t SlotsFor(size_t n) noexcept
+	{
+		size_t size = 8;
+		while (size < 4 * n)
+			size <<= 1;
+
+		return size;
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	template<size_t N>
+	constexpr Table<N>::Table(const std::array<std::string_view, N> &crKeys) :
+		keys_(crKeys),
+		slots_{},
+		seed_(0)
+	{
+		for (; seed_ < MAX_SEEDS; seed_++)
+		{
+			for (auto &&entry : slots_)
+				entry = 0;
+
+			bool perfect = true;
+			for (size_t i = 0; i < N && perfect; i++)
+			{
+				auto &&entry = slots_[slot(keys_[i])];
+
+				if (entry) perfect = false;
+				else       entry   = static_cast<unsigned char>(i + 1);
+			}
+
+			if (perfect) return;
+		}
+
+		throw "No perfect seed for the keys"; // Not a constant expression, so the build fails
+	}
+
+	template<size_t N>
+	constexpr size_t Table<N>::find(std::string_view key) const noexcept
+	{
+		size_t index = slots_[slot(key)];
+
+		return (index && keys_[index - 1] == key ? index - 1 : N);
+	}
+
+	template<size_t N>
+	constexpr uint64_t Table<N>::seed() const noexcept
+	{
+		return seed_;
+	}
+
+	template<size_t N>
+	constexpr size_t Table<N>::slot(std::string_view key) const noexcept
+	{
+		return static_cast<size_t>(Hash(key, seed_) & (SIZE - 1));
+	}
+
+#pragma endregion
+
+} // namespace NPerfectHash
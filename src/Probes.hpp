@@ -0,0 +1,150 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Probes.hpp
+//!
+//! \brief	Statically defined tracepoints (USDT) for perf, bpftrace and SystemTap attached to a running process
+//!
+//! \note   A probe is one nop and a note in the ELF file, so it costs nothing until a tracer is attached.
+//!         Built in on Linux when <sys/sdt.h> (systemtap-sdt-dev) is installed, define NO_USDT to leave them out.
+//!         Provider "cpu", probes and arguments:
+//!           run__start    (run id, path)                        run__end     (run id, path, instructions executed)
+//!           call          (run id, pc, stack depth)             ret          (run id, pc, stack depth)
+//!           compile__start(phase, path)                         compile__end (phase, path)
+//!           stack__grow   (stack, old capacity, new capacity)   guard__fail  (object, function)
+//!         pc is the index of the instruction in fromTextFile() and fromComFile(), the offset in the file in the binary ones.
+//!         E.g. bpftrace -e 'usdt:./CPU:cpu:call { @[arg0] = count(); }' -p PID
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <atomic>     // std::atomic
+#include <filesystem> // std::filesystem::path
+
+#if !defined(NO_USDT) && defined(__linux__) && defined(__has_include)
+	#if __has_include(<sys/sdt.h>)
+		#include <sys/sdt.h>
+		#define USDT_ENABLED
+	#endif
+#endif
+
+#ifdef USDT_ENABLED
+	#define USDT(name, ...) STAP_PROBEV(cpu, name, __VA_ARGS__)
+#else
+	#define USDT(name, ...)
+#endif // USDT_ENABLED
+
+namespace NProbes
+{
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns the id of the next programm run, unique in the process, so that probes of different VMs can be told apart
+//!
+//====================================================================================================================================
+
+	inline unsigned long long NextRunId() noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+//====================================================================================================================================
+//!
+//! \brief	Fires run__start when constructed and run__end with the number of executed instructions when destroyed
+//!
+//====================================================================================================================================
+
+	class Run final
+	{
+	public:
+		Run(unsigned long long id, const std::filesystem::path &crPath, const size_t &crExecuted) noexcept;
+		Run(const Run&) = delete;
+		~Run();
+
+		Run &operator=(const Run&) = delete;
+
+		unsigned long long id() const noexcept;
+
+	private:
+		unsigned long long           id_;
+		const std::filesystem::path &crPath_; // Native strings are char only where there are probes
+		const size_t                &crExecuted_;
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Fires compile__start when constructed and compile__end when destroyed
+//!
+//====================================================================================================================================
+
+	class Phase final
+	{
+	public:
+		Phase(const char *pPhase, const std::filesystem::path &crPath) noexcept;
+		Phase(const Phase&) = delete;
+		~Phase();
+
+		Phase &operator=(const Phase&) = delete;
+
+	private:
+		const char                  *pPhase_;
+		const std::filesystem::path &crPath_;
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline unsigned long long NextRunId() noexcept
+	{
+		static std::atomic<unsigned long long> lastId(0);
+
+		return ++lastId;
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Run::Run(unsigned long long id, const std::filesystem::path &crPath, const size_t &crExecuted) noexcept :
+		id_(id),
+		crPath_(crPath),
+		crExecuted_(crExecuted)
+	{
+		USDT(run__start, id_, crPath_.c_str());
+	}
+
+	inline Run::~Run()
+	{
+		USDT(run__end, id_, crPath_.c_str(), crExecuted_);
+	}
+
+	inline unsigned long long Run::id() const noexcept
+	{
+		return id_;
+	}
+
+	inline Phase::Phase(const char *pPhase, const std::filesystem::path &crPath) noexcept :
+		pPhase_(pPhase),
+		crPath_(crPath)
+	{
+		USDT(compile__start, pPhase_, crPath_.c_str());
+	}
+
+	inline Phase::~Phase()
+	{
+		USDT(compile__end, pPhase_, crPath_.c_str());
+	}
+
+#pragma endregion
+
+} // namespace NProbes
@@ -0,0 +1,426 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Profiler.hpp
+//!
+//! \brief	Opt-in execution profiler: executions and cycles per opcode and per instruction (PROFILE_LVL >= 1),
+//!         instruction counts per function with folded stacks for flame graphs (PROFILE_LVL >= 2)
+//!
+//! \note   Compiled in only if PROFILE_LVL >= 1, otherwise the executors contain no profiling code at all
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <algorithm>     // std::sort, std::min, std::unique
+#include <chrono>        // std::chrono::steady_clock
+#include <iomanip>       // std::setw, std::setprecision
+#include <numeric>       // std::iota
+#include <ostream>       // std::ostream
+#include <string>        // std::string
+#include <string_view>   // std::string_view
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#if defined(_MSC_VER)
+	#include <intrin.h>    // __rdtsc
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h> // __rdtsc
+#endif
+
+#if   PROFILE_LVL >= 2
+	#define    PROFILE(...) __VA_ARGS__
+	#define CALL_GRAPH(...) __VA_ARGS__
+#elif PROFILE_LVL == 1
+	#define    PROFILE(...) __VA_ARGS__
+	#define CALL_GRAPH(...)
+#else
+	#define    PROFILE(...)
+	#define CALL_GRAPH(...)
+#endif // PROFILE_LVL
+
+namespace NProfiler
+{
+
+#pragma region TYPEDEFS
+
+	typedef unsigned long long ticks_t;
+
+#pragma endregion
+
+#pragma region STRUCTS
+
+	struct Counter
+	{
+		unsigned long long count;
+		ticks_t            ticks;
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 Reads the time stamp counter, steady_clock nanoseconds where there is none
+//!
+//! \return  Ticks
+//!
+//====================================================================================================================================
+
+	inline ticks_t Now() noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+//====================================================================================================================================
+//!
+//! \brief	Tree of the call stacks seen while running, every node counts instructions executed right in it
+//!
+//====================================================================================================================================
+
+	class CallGraph final
+	{
+	public:
+		static constexpr std::string_view ROOT = "main";
+
+		explicit CallGraph();
+
+		void count() noexcept;
+
+		void enter(std::string_view func);
+
+//====================================================================================================================================
+//!
+//! \brief	Returns to the caller, unbalanced returns are ignored
+//!
+//====================================================================================================================================
+
+		void leave() noexcept;
+
+		void reset();
+
+		bool empty() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	Prints inclusive and exclusive instruction counts of every function sorted by inclusive count
+//!
+//! \param  rOstr  Stream to output
+//!
+//====================================================================================================================================
+
+		void report(std::ostream &rOstr) const;
+
+//====================================================================================================================================
+//!
+//! \brief	Prints one "main;caller;callee count" line per stack, the input format of flamegraph.pl and speedscope
+//!
+//! \param  rOstr  Stream to output
+//!
+//====================================================================================================================================
+
+		void fold(std::ostream &rOstr) const;
+
+	private:
+		struct Node
+		{
+			size_t                                 func,
+			                                       parent;
+			unsigned long long                     self;
+			std::vector<std::pair<size_t, size_t>> children; // Function and node, there are few of them
+		};
+
+		std::vector<Node>                       nodes_;
+		std::vector<std::string>                funcs_;
+		std::unordered_map<std::string, size_t> ids_;
+		size_t                                  cur_;
+
+		size_t id(std::string_view func);
+		std::vector<size_t> path(size_t node) const;
+	};
+
+	class Profiler final
+	{
+	public:
+		explicit Profiler(size_t numOfOpcodes);
+
+//====================================================================================================================================
+//!
+//! \brief	Resets the counters of the instructions, opcode counters are kept across programms
+//!
+//! \param  programmSize  Number of the instructions
+//!
+//====================================================================================================================================
+
+		void start(size_t programmSize);
+
+		void record(unsigned opcode, size_t pc, ticks_t ticks) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	Prints opcodes and the hottest instructions sorted by ticks
+//!
+//! \param  rOstr      Stream to output
+//! \param  crOpcodes  Names of the opcodes, the index is the opcode
+//! \param  crSource   Description of every instruction (source line, label, text)
+//! \param  top        Number of the instructions to print
+//!
+//====================================================================================================================================
+
+		void report(std::ostream &rOstr, const std::vector<std::string_view> &crOpcodes, const std::vector<std::string> &crSource, size_t top = 1 << 4) const;
+
+		const std::vector<Counter> &opcodes()      const noexcept;
+		const std::vector<Counter> &instructions() const noexcept;
+
+		CallGraph       &calls()       noexcept;
+		const CallGraph &calls() const noexcept;
+
+	private:
+		std::vector<Counter> opcodes_,
+		                     instructions_;
+		CallGraph            calls_;
+
+		static std::vector<size_t> sortByTicks(const std::vector<Counter> &crCounters);
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline ticks_t Now() noexcept
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return static_cast<ticks_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline CallGraph::CallGraph() :
+		nodes_(),
+		funcs_(),
+		ids_(),
+		cur_(NULL)
+	{
+		reset();
+	}
+
+	inline void CallGraph::count() noexcept
+	{
+		nodes_[cur_].self++;
+	}
+
+	inline void CallGraph::enter(std::string_view func)
+	{
+		size_t f = id(func);
+		for (auto &&[child, node] : nodes_[cur_].children)
+			if (child == f)
+			{
+				cur_ = node;
+
+				return;
+			}
+
+		nodes_.push_back(Node{ f, cur_, 0, { } });
+		nodes_[cur_].children.emplace_back(f, nodes_.size() - 1);
+
+		cur_ = nodes_.size() - 1;
+	}
+
+	inline void CallGraph::leave() noexcept
+	{
+		if (cur_) cur_ = nodes_[cur_].parent;
+	}
+
+	inline void CallGraph::reset()
+	{
+		nodes_.clear();
+		funcs_.clear();
+		ids_.clear();
+
+		nodes_.push_back(Node{ id(ROOT), 0, 0, { } });
+		cur_ = 0;
+	}
+
+	inline bool CallGraph::empty() const noexcept
+	{
+		return (nodes_.size() == 1 && !nodes_.front().self);
+	}
+
+	inline void CallGraph::report(std::ostream &rOstr) const
+	{
+		std::vector<unsigned long long> inclusive(funcs_.size(), 0),
+		                                exclusive(funcs_.size(), 0);
+		for (size_t node = 0; node < nodes_.size(); node++)
+		{
+			exclusive[nodes_[node].func] += nodes_[node].self;
+
+			auto funcs = path(node);
+			std::sort(funcs.begin(), funcs.end());
+			funcs.erase(std::unique(funcs.begin(), funcs.end()), funcs.end()); // Recursive frames are counted once
+
+			for (auto func : funcs)
+				inclusive[func] += nodes_[node].self;
+		}
+
+		std::vector<size_t> order(funcs_.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return (inclusive[a] > inclusive[b]); });
+
+		std::streamsize width = 1 << 4;
+
+		rOstr << "[PROFILE] Functions\n"
+		      << std::setw(width) << "function" << std::setw(width) << "inclusive" << std::setw(width) << "exclusive" << '\n';
+		for (auto func : order)
+			rOstr << std::setw(width) << funcs_[func] << std::setw(width) << inclusive[func] << std::setw(width) << exclusive[func] << '\n';
+
+		rOstr.flush();
+	}
+
+	inline void CallGraph::fold(std::ostream &rOstr) const
+	{
+		for (size_t node = 0; node < nodes_.size(); node++)
+		{
+			if (!nodes_[node].self) continue;
+
+			auto funcs = path(node);
+			for (auto it = funcs.crbegin(); it != funcs.crend(); ++it)
+				rOstr << (it == funcs.crbegin() ? "" : ";") << funcs_[*it];
+
+			rOstr << ' ' << nodes_[node].self << '\n';
+		}
+
+		rOstr.flush();
+	}
+
+	inline size_t CallGraph::id(std::string_view func)
+	{
+		auto [it, added] = ids_.try_emplace(std::string(func), funcs_.size());
+		if (added) funcs_.emplace_back(func);
+
+		return it->second;
+	}
+
+	inline std::vector<size_t> CallGraph::path(size_t node) const
+	{ // From the node up to the root
+		std::vector<size_t> funcs = { nodes_[node].func };
+		for (; node; node = nodes_[node].parent)
+			funcs.push_back(nodes_[nodes_[node].parent].func);
+
+		return funcs;
+	}
+
+	inline Profiler::Profiler(size_t numOfOpcodes) :
+		opcodes_(numOfOpcodes, Counter{ }),
+		instructions_(),
+		calls_()
+	{ }
+
+	inline void Profiler::start(size_t programmSize)
+	{
+		instructions_.assign(programmSize, Counter{ });
+		calls_.reset();
+	}
+
+	inline void Profiler::record(unsigned opcode, size_t pc, ticks_t ticks) noexcept
+	{
+		if (opcode < opcodes_.size())
+		{
+			opcodes_[opcode].count++;
+			opcodes_[opcode].ticks += ticks;
+		}
+
+		if (pc < instructions_.size())
+		{
+			instructions_[pc].count++;
+			instructions_[pc].ticks += ticks;
+		}
+	}
+
+	inline void Profiler::report(std::ostream &rOstr, const std::vector<std::string_view> &crOpcodes, const std::vector<std::string> &crSource, size_t top /* = 1 << 4 */) const
+	{
+		ticks_t total = 0;
+		for (auto &&counter : opcodes_)
+			total += counter.ticks;
+
+		auto percent = [&](ticks_t ticks) { return (total ? 100. * ticks / total : 0.); };
+
+		std::streamsize width = 1 << 3;
+
+		rOstr << "[PROFILE] Opcodes\n"
+		      << std::setw(width) << "opcode" << std::setw(width << 1) << "count" << std::setw(width << 1) << "ticks" << std::setw(width) << "%" << std::setw(width << 1) << "ticks/op" << '\n';
+		for (auto i : sortByTicks(opcodes_))
+		{
+			auto &&counter = opcodes_[i];
+			if (!counter.count) break;
+
+			rOstr << std::setw(width)      << (i < crOpcodes.size() ? crOpcodes[i] : std::string_view("null"))
+			      << std::setw(width << 1) << counter.count
+			      << std::setw(width << 1) << counter.ticks
+			      << std::setw(width)      << std::fixed << std::setprecision(2) << percent(counter.ticks)
+			      << std::setw(width << 1) << counter.ticks / counter.count << '\n';
+		}
+
+		rOstr << "[PROFILE] Hottest instructions\n"
+		      << std::setw(width) << "pc" << std::setw(width << 1) << "count" << std::setw(width << 1) << "ticks" << std::setw(width) << "%" << "  source\n";
+		auto order = sortByTicks(instructions_);
+		for (size_t n = 0; n < std::min(top, order.size()); n++)
+		{
+			size_t pc      = order[n];
+			auto &&counter = instructions_[pc];
+			if (!counter.count) break;
+
+			rOstr << std::setw(width)      << pc
+			      << std::setw(width << 1) << counter.count
+			      << std::setw(width << 1) << counter.ticks
+			      << std::setw(width)      << std::fixed << std::setprecision(2) << percent(counter.ticks)
+			      << "  " << (pc < crSource.size() ? crSource[pc] : std::string("null")) << '\n';
+		}
+
+		rOstr.flush();
+	}
+
+	inline const std::vector<Counter> &Profiler::opcodes() const noexcept
+	{
+		return opcodes_;
+	}
+
+	inline const std::vector<Counter> &Profiler::instructions() const noexcept
+	{
+		return instructions_;
+	}
+
+	inline CallGraph &Profiler::calls() noexcept
+	{
+		return calls_;
+	}
+
+	inline const CallGraph &Profiler::calls() const noexcept
+	{
+		return calls_;
+	}
+
+	inline std::vector<size_t> Profiler::sortByTicks(const std::vector<Counter> &crCounters)
+	{
+		std::vector<size_t> order(crCounters.size());
+		std::iota(order.begin(), order.end(), 0);
+
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return (crCounters[a].ticks > crCounters[b].ticks); });
+
+		return order;
+	}
+
+#pragma endregion
+
+} // namespace NProfiler
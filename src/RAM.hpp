@@ -17,10 +17,13 @@ namespace NRam
 //====================================================================================================================================
 
 	template<typename T = int>
-	class Ram final : public Storage<T, RAM_SIZE>
+	class Ram final : public Storage<T, RAM_SIZE, Ram<T>>
 	{
 	public:
-		explicit Ram()     noexcept;
+		typedef typename Storage<T, RAM_SIZE, Ram<T>>::crVal_ crVal_;
+		typedef typename Storage<T, RAM_SIZE, Ram<T>>::rrVal_ rrVal_;
+
+		explicit Ram(std::pmr::memory_resource *pResource = std::pmr::get_default_resource()) noexcept;
 		Ram(const Ram<T>&) noexcept;
 		Ram(Ram<T>&&)      noexcept;
 		~Ram();
@@ -28,20 +31,42 @@ namespace NRam
 		Ram<T> &operator=(const Ram&) noexcept;
 		Ram<T> &operator=(Ram&&)      noexcept;
 
-		virtual rVal_  operator[](size_t)       override;
-		virtual crVal_ operator[](size_t) const override;
+//====================================================================================================================================
+//!
+//! \brief   Checks if the element at index was put
+//! 
+//! \param   index  Position of the element
+//!
+//! \return  Is index in range
+//!
+//====================================================================================================================================
+
+		bool inRange(size_t index) const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief   Returnes maximum number of cells put at once (STATS_LVL >= 1)
+//! 
+//! \return  High-water mark
+//!
+//====================================================================================================================================
+
+		STATS(size_t highWater() const noexcept;)
 
 		size_t put(crVal_);
 		size_t put(rrVal_);
 		void pop();
 
-		void swap(Ram&) noexcept(std::_Is_nothrow_swappable<T>::value); //-V762
+		void swap(Ram&) noexcept(std::is_nothrow_swappable_v<T>);
 
-		bool ok() const noexcept override;
+		bool ok() const noexcept;
 		void dump(std::ostream& = std::cout) const;
 
 	private:
+		static constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::Ram;
+
 		size_t counter_;
+		STATS(size_t highWater_ = NULL;)
 	};
 
 //====================================================================================================================================
@@ -58,8 +83,8 @@ namespace NRam
 #pragma region METHOD_DEFINITION
 
 	template<typename T>
-	inline Ram<T>::Ram() noexcept :
-		Storage(),
+	inline Ram<T>::Ram(std::pmr::memory_resource *pResource /* = std::pmr::get_default_resource() */) noexcept :
+		Storage<T, RAM_SIZE, Ram<T>>(pResource),
 		counter_(NULL)
 	{ 
 		LOG_CONSTRUCTING()
@@ -67,7 +92,7 @@ namespace NRam
 
 	template<typename T>
 	inline Ram<T>::Ram(const Ram &crRam) noexcept :
-		Storage(crRam),
+		Storage<T, RAM_SIZE, Ram<T>>(crRam),
 		counter_(crRam.counter_)
 	{ 	
 		LOG_CONSTRUCTING()
@@ -75,7 +100,7 @@ namespace NRam
 		
 	template<typename T>
 	inline Ram<T>::Ram(Ram &&rrRam) noexcept :
-		Storage(rrRam),
+		Storage<T, RAM_SIZE, Ram<T>>(std::move(rrRam)),
 		counter_(rrRam.counter_)
 	{
 		LOG_CONSTRUCTING()
@@ -94,7 +119,7 @@ namespace NRam
 	{
 		if (this != &crRam)
 		{
-			*static_cast<Storage*>(this) = crRam;
+			*static_cast<Storage<T, RAM_SIZE, Ram<T>>*>(this) = crRam;
 			counter_                     = crRam.counter_;
 		}
 
@@ -106,7 +131,7 @@ namespace NRam
 	{
 		assert(this != &rrRam);
 
-		*static_cast<Storage*>(this) = std::move(rrRam);
+		*static_cast<Storage<T, RAM_SIZE, Ram<T>>*>(this) = std::move(rrRam);
 		counter_                     = std::move(rrRam.counter_);
 
 		rrRam.counter_ = NULL;
@@ -115,29 +140,30 @@ namespace NRam
 	}
 	
 	template<typename T>
-	inline typename Ram<T>::rVal_ Ram<T>::operator[](size_t index)
+	inline bool Ram<T>::inRange(size_t index) const noexcept
 	{
-		if (index >= counter_) throw std::out_of_range(std::string("[") + __FUNCTION__ + "] Ram out of range\n");
-
-		return buf_[index];
+		return (index < counter_);
 	}
 
+#if STATS_LVL >= 1
+
 	template<typename T>
-	inline typename Ram<T>::crVal_ Ram<T>::operator[](size_t index) const
+	inline size_t Ram<T>::highWater() const noexcept
 	{
-		if (index >= counter_) throw std::out_of_range(std::string("[") + __FUNCTION__ + "] Ram out of range\n");
-
-		return buf_[index];
+		return highWater_;
 	}
 
+#endif // STATS_LVL
+
 	template<typename T>
 	inline size_t Ram<T>::put(crVal_ val)
 	{
 		if (counter_ == RAM_SIZE) throw std::length_error(std::string("[") + __FUNCTION__ + "] Ram length error\n");
 
-		buf_[counter_] = val;
+		this->buf_[counter_] = val;
 		counter_++;
-		HASH_GUARD(rehash();)
+		STATS(if (counter_ > highWater_) highWater_ = counter_;)
+		HASH_GUARD(this->rehash();)
 
 		return counter_ - 1;
 	}
@@ -147,9 +173,10 @@ namespace NRam
 	{
 		if (counter_ == RAM_SIZE) throw std::length_error(std::string("[") + __FUNCTION__ + "] Ram length error\n");
 
-		buf_[counter_] = std::move(val);
+		this->buf_[counter_] = std::move(val);
 		counter_++;
-		HASH_GUARD(rehash();)
+		STATS(if (counter_ > highWater_) highWater_ = counter_;)
+		HASH_GUARD(this->rehash();)
 
 		return counter_ - 1;
 	}
@@ -160,35 +187,35 @@ namespace NRam
 		if (!counter_) throw std::length_error(std::string("[") + __FUNCTION__ + "] Ram length error\n");
 
 		counter_--;
-		HASH_GUARD(rehash();)
+		HASH_GUARD(this->rehash();)
 	}
 
 	template<typename T>
-	inline void Ram<T>::swap(Ram<T> &rRam) noexcept(std::_Is_nothrow_swappable<T>::value)
+	inline void Ram<T>::swap(Ram<T> &rRam) noexcept(std::is_nothrow_swappable_v<T>)
 	{
 		using std::swap; // To have all possible swaps
 
-		Storage::swap(rRam);
+		Storage<T, RAM_SIZE, Ram<T>>::swap(rRam);
 		swap(counter_, rRam.counter_);
 	}
 
 	template<typename T>
 	inline bool Ram<T>::ok() const noexcept
 	{
-		return (Storage::ok() && (counter_ < RAM_SIZE));
+		return (Storage<T, RAM_SIZE, Ram<T>>::ok() && (counter_ < RAM_SIZE));
 	}
 
 	template<typename T>
 	void Ram<T>::dump(std::ostream &rOstr /* = std::cout */) const
 	{
-		NDebugger::Text("\t[RAM DUMP]", rOstr, NDebugger::Colors::LightCyan);
+		NDebugger::Text(std::string_view("\t[RAM DUMP]"), rOstr, NDebugger::Colors::LightCyan);
 		
 		rOstr << "Ram <" << typeid(T).name() << "> [0x" << this << "]\n{\n"
-			  << "\tram [" << counter_ << " of " << RAM_SIZE << "] = 0x" << &buf_ << "\n\t{\n\t\t";
+			  << "\tram [" << counter_ << " of " << RAM_SIZE << "] = 0x" << &this->buf_ << "\n\t{\n\t\t";
 
 		for (size_t i = 0; i < counter_; ++i)
 		{
-			rOstr << "[" << std::setw(3) << i << "] = " << buf_[i] << (i + 1 == counter_ ? " " : ", ") << "  ";
+			rOstr << "[" << std::setw(3) << i << "] = " << this->buf_[i] << (i + 1 == counter_ ? " " : ", ") << "  ";
 
 			rOstr << "\n\t\t";
 		}
@@ -197,27 +224,27 @@ namespace NRam
 
 		CANARY_GUARD
 		(
-			rOstr << "\tCANARY_VALUE  = " << CANARY_VALUE << std::endl;
+			rOstr << "\tCANARY_VALUE  = " << this->cold_->CANARY_VALUE << std::endl;
 
-			rOstr << "\tCANARY_START  = " << canaryStart_;
-			if (canaryStart_ == CANARY_VALUE) NDebugger::Text(" TRUE ", rOstr, NDebugger::Colors::Green);
-			else                              NDebugger::Text(" FALSE", rOstr, NDebugger::Colors::Red);
+			rOstr << "\tCANARY_START  = " << this->cold_->canaryStart;
+			if (this->cold_->canaryStart == this->cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			else                              NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 
-			rOstr << "\tCANARY_FINISH = " << canaryFinish_;
-			if (canaryFinish_ == CANARY_VALUE) NDebugger::Text(" TRUE ", rOstr, NDebugger::Colors::Green);
-			else                               NDebugger::Text(" FALSE", rOstr, NDebugger::Colors::Red);
+			rOstr << "\tCANARY_FINISH = " << this->cold_->canaryFinish;
+			if (this->cold_->canaryFinish == this->cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			else                               NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 		)
 
 		HASH_GUARD
 		(
-			rOstr << "\n\tHASH = " << getHash().data();
-			if (getHash() == makeHash()) NDebugger::Text(" TRUE ", rOstr, NDebugger::Colors::Green);
-			else                         NDebugger::Text(" FALSE", rOstr, NDebugger::Colors::Red);
+			rOstr << "\n\tHASH = " << this->getHash().data();
+			if (this->getHash() == this->makeHash()) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			else                         NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 		)
 
 		rOstr << "}\n";
 
-		NDebugger::Text("\t[  END   ]\n", rOstr, NDebugger::Colors::LightCyan);
+		NDebugger::Text(std::string_view("\t[  END   ]\n"), rOstr, NDebugger::Colors::LightCyan);
 	}
 
 #pragma endregion
@@ -229,7 +256,9 @@ namespace NRam
 	template<typename T>
 	Logger& operator<<(Logger &rLogger, const Ram<T> &crRam)
 	{
-		std::string_view func("Ram<" + typeid(T).name() + ">");
+		std::string func = std::string("Ram<") + typeid(T).name() + ">";
+
+		auto lock = rLogger.lock(); // The dump goes to the file directly
 
 		rLogger.stdPack(func);
 
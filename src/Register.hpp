@@ -1,8 +1,12 @@
 #pragma once
 
+#include <array>       // std::array
+#include <string_view> // std::string_view
+
 #include "Debugger.hpp"
 #include "Storage.hpp"
 #include "Logger.hpp"
+#include "PerfectHash.hpp"
 
 namespace NRegister
 {
@@ -30,13 +34,29 @@ namespace NRegister
 
 #pragma endregion
 
+#pragma region CONSTANTS
+
+	constexpr std::array<std::string_view, static_cast<size_t>(REG::NUM)> REG_NAMES
+	{
+		"ax",
+		"bx",
+		"cx",
+		"dx",
+		"ex",
+		"sp"
+	};
+
+	constexpr NPerfectHash::Table<static_cast<size_t>(REG::NUM)> REG_TABLE(REG_NAMES);
+
+#pragma endregion
+
 #pragma region CLASSES
 
 	template<typename T = int>
-	class Register final : public Storage<T, static_cast<size_t>(REG::NUM)>
+	class Register final : public Storage<T, static_cast<size_t>(REG::NUM), Register<T>>
 	{
 	public:
-		explicit Register()       noexcept;
+		explicit Register(std::pmr::memory_resource *pResource = std::pmr::get_default_resource()) noexcept;
 		Register(const Register&) noexcept;
 		Register(Register&&)      noexcept;
 		~Register();
@@ -53,6 +73,9 @@ namespace NRegister
 
 		template<typename Char, typename Traits = std::char_traits<Char>>
 		void dump(std::basic_ostream<Char, Traits>& rOstr) const;
+
+	private:
+		static constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::Register;
 	};
 
 #pragma endregion
@@ -64,7 +87,7 @@ namespace NRegister
 
 	inline std::string_view GetReg(REG);
 
-	REG MakeReg(std::string_view);
+	inline REG MakeReg(std::string_view);
 
 	inline bool IsReg(std::string_view);
 
@@ -73,22 +96,22 @@ namespace NRegister
 #pragma region METHOD_DEFINITION
 
 	template<typename T>
-	inline Register<T>::Register() noexcept :
-		Storage<T, static_cast<size_t>(REG::NUM)>()
+	inline Register<T>::Register(std::pmr::memory_resource *pResource /* = std::pmr::get_default_resource() */) noexcept :
+		Storage<T, static_cast<size_t>(REG::NUM), Register<T>>(pResource)
 	{
 		LOG_CONSTRUCTING()
 	}
 
 	template<typename T>
 	inline Register<T>::Register(const Register &crRegister) noexcept :
-		Storage<T, static_cast<size_t>(REG::NUM)>(crRegister)
+		Storage<T, static_cast<size_t>(REG::NUM), Register<T>>(crRegister)
 	{
 		LOG_CONSTRUCTING()
 	}
 
 	template<typename T>
 	inline Register<T>::Register(Register &&rrRegister) noexcept :
-		Storage<T, static_cast<size_t>(REG::NUM)>(std::move(rrRegister))
+		Storage<T, static_cast<size_t>(REG::NUM), Register<T>>(std::move(rrRegister))
 	{
 		LOG_CONSTRUCTING()
 	}
@@ -114,21 +137,21 @@ namespace NRegister
 
 		CANARY_GUARD
 		(
-			rOstr << "\tCANARY_VALUE  = " << CANARY_VALUE << std::endl;
+			rOstr << "\tCANARY_VALUE  = " << this->cold_->CANARY_VALUE << std::endl;
 
-			rOstr << "\tCANARY_START  = " << canaryStart_;
-			if (canaryStart_ == CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			rOstr << "\tCANARY_START  = " << this->cold_->canaryStart;
+			if (this->cold_->canaryStart == this->cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
 			else                              NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 
-			rOstr << "\tCANARY_FINISH = " << canaryFinish_;
-			if (canaryFinish_ == CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			rOstr << "\tCANARY_FINISH = " << this->cold_->canaryFinish;
+			if (this->cold_->canaryFinish == this->cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
 			else                               NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 		)
 
 		HASH_GUARD
 		(
-			rOstr << "\n\tHASH = " << getHash().data();
-			if (getHash() == makeHash()) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			rOstr << "\n\tHASH = " << this->getHash().data();
+			if (this->getHash() == this->makeHash()) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
 			else                         NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 		)
 
@@ -148,6 +171,8 @@ namespace NRegister
 		func += typeid(T).name();
 		func += ">";
 
+		auto lock = rLogger.lock(); // The dump goes to the file directly
+
 		rLogger.stdPack(func);
 
 		crRegister.dump(rLogger.getOfstream());
@@ -166,16 +191,12 @@ namespace NRegister
 		else                     return std::string_view("null");
 	}
 
-	REG MakeReg(std::string_view str)
+	inline REG MakeReg(std::string_view str)
 	{
-		if (str == "ax" || str == "[ax]") return REG::AX;
-		else if (str == "bx" || str == "[bx]") return REG::BX;
-		else if (str == "cx" || str == "[cx]") return REG::CX;
-		else if (str == "dx" || str == "[dx]") return REG::DX;
-		else if (str == "ex" || str == "[ex]") return REG::EX;
-		else if (str == "sp" || str == "[sp]") return REG::SP;
-
-		else                                   return REG::NUM;
+		if (str.length() > 2 && str.front() == '[' && str.back() == ']') // RAM
+			str = str.substr(1, str.length() - 2);
+
+		return static_cast<REG>(REG_TABLE.find(str));
 	}
 
 	inline bool IsReg(std::string_view val)
@@ -0,0 +1,218 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Scanner.hpp
+//!
+//! \brief	Classifies bytes of the source 64 at a time: separators, newlines and the bytes of tokens, see NParser::Lexer
+//!
+//! \note   AVX2 if the compiler targets it (-mavx2, /arch:AVX2), SSE2 on every x86-64, a table otherwise or with NO_SIMD.
+//!         Separators are ' ', '\t', '\r', '\v', '\f' and ','; ':' and '[' are parts of tokens, so they need no class.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <array>       // std::array
+#include <cstdint>     // uint64_t, uint32_t
+#include <string_view> // std::string_view
+
+#if defined(_MSC_VER)
+	#include <intrin.h> // _BitScanForward64
+#endif
+
+#if !defined(NO_SIMD)
+	#if defined(__AVX2__)
+		#include <immintrin.h> // _mm256_cmpeq_epi8, _mm256_movemask_epi8
+		#define SCANNER_AVX2
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#include <emmintrin.h> // _mm_cmpeq_epi8, _mm_movemask_epi8
+		#define SCANNER_SSE2
+	#endif
+#endif // NO_SIMD
+
+namespace NScanner
+{
+
+#pragma region CONSTANTS
+
+	constexpr size_t BLOCK = 64; // Bytes of one mask
+
+	constexpr std::string_view ISA =
+#if   defined(SCANNER_AVX2)
+		"AVX2";
+#elif defined(SCANNER_SSE2)
+		"SSE2";
+#else
+		"scalar";
+#endif
+
+#pragma endregion
+
+#pragma region ENUMS
+
+	enum class Class : unsigned char
+	{
+		Token,
+		Separator,
+		Newline
+	};
+
+#pragma endregion
+
+#pragma region STRUCTS
+
+//====================================================================================================================================
+//!
+//! \brief	Bit i describes byte i of the block
+//!
+//====================================================================================================================================
+
+	struct Masks
+	{
+		uint64_t tokens,
+		         newlines;
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+	constexpr std::array<Class, 256> MakeClasses() noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Classifies the block byte by byte, the reference for the vector versions
+//!
+//! \param   pBlock  BLOCK bytes
+//!
+//====================================================================================================================================
+
+	inline Masks ClassifyScalar(const char *pBlock) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Classifies the block with the widest vectors available
+//!
+//! \param   pBlock  BLOCK bytes, no alignment needed
+//!
+//====================================================================================================================================
+
+	inline Masks Classify(const char *pBlock) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Index of the lowest set bit, mask must not be zero
+//!
+//====================================================================================================================================
+
+	inline unsigned FirstBit(uint64_t mask) noexcept;
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	constexpr std::array<Class, 256> MakeClasses() noexcept
+	{
+		std::array<Class, 256> classes{};
+		for (auto &&cls : classes)
+			cls = Class::Token;
+
+		for (unsigned char ch : { ' ', '\t', '\r', '\v', '\f', ',' })
+			classes[ch] = Class::Separator;
+
+		classes[static_cast<unsigned char>('\n')] = Class::Newline;
+
+		return classes;
+	}
+
+	constexpr std::array<Class, 256> CLASSES = MakeClasses();
+
+	inline Masks ClassifyScalar(const char *pBlock) noexcept
+	{
+		Masks masks{ 0, 0 };
+		for (size_t i = 0; i < BLOCK; i++)
+		{
+			Class cls = CLASSES[static_cast<unsigned char>(pBlock[i])];
+
+			masks.tokens   |= uint64_t(cls == Class::Token)   << i;
+			masks.newlines |= uint64_t(cls == Class::Newline) << i;
+		}
+
+		return masks;
+	}
+
+	inline Masks Classify(const char *pBlock) noexcept
+	{
+#if defined(SCANNER_AVX2)
+		Masks masks{ 0, 0 };
+		for (size_t i = 0; i < BLOCK; i += 32)
+		{
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBlock + i));
+
+			__m256i separators = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+			                                                     _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))),
+			                                     _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')),
+			                                                                     _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'))),
+			                                                     _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\v')),
+			                                                                     _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\f')))));
+			__m256i newlines   = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'));
+
+			auto stops = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(separators, newlines)));
+
+			masks.tokens   |= uint64_t(~stops) << i;
+			masks.newlines |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(newlines))) << i;
+		}
+
+		return masks;
+#elif defined(SCANNER_SSE2)
+		Masks masks{ 0, 0 };
+		for (size_t i = 0; i < BLOCK; i += 16)
+		{
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + i));
+
+			__m128i separators = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+			                                               _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))),
+			                                  _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')),
+			                                                            _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))),
+			                                               _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\v')),
+			                                                            _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\f')))));
+			__m128i newlines   = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'));
+
+			auto stops = static_cast<uint64_t>(_mm_movemask_epi8(_mm_or_si128(separators, newlines)));
+
+			masks.tokens   |= (~stops & 0xFFFF) << i;
+			masks.newlines |= static_cast<uint64_t>(_mm_movemask_epi8(newlines)) << i;
+		}
+
+		return masks;
+#else
+		return ClassifyScalar(pBlock);
+#endif // SCANNER_AVX2
+	}
+
+	inline unsigned FirstBit(uint64_t mask) noexcept
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+		unsigned long index = 0;
+		_BitScanForward64(&index, mask);
+
+		return static_cast<unsigned>(index);
+#elif defined(__GNUC__)
+		return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+		unsigned index = 0;
+		for (; !(mask & 1); mask >>= 1)
+			index++;
+
+		return index;
+#endif // _MSC_VER
+	}
+
+#pragma endregion
+
+} // namespace NScanner
@@ -14,47 +14,100 @@
 	#error
 #endif /* __cplusplus */
 
-#include <memory>      // std::unique_ptr
+#include <algorithm>   // std::copy, std::min, std::max
 #include <cassert>     // assert
+#include <stdexcept>   // std::overflow_error
 #include <iomanip>     // std::setw
 #include <string_view> // std::string_view
+#include <array>       // std::array
+
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::string
 
 #include "Debugger.hpp"
 #include "Guard.hpp"
 #include "Logger.hpp"
+#include "VirtualBuffer.hpp"
 
 namespace NStack
 {
+
+#pragma region CONSTANTS
+
+	constexpr size_t DEFAULT_INLINE_SIZE = 1 << 4;
+
+#pragma endregion
 	
 #pragma region CLASSES
 
-	template<typename T = int>
+	template<typename T = int, size_t INLINE_SIZE = DEFAULT_INLINE_SIZE>
 	class Stack final
 	{
 
 //====================================================================================================================================
 //!
-//! \brief	Reallocs memory for stack(increases by a power of two)
+//! \brief	Commits more memory for stack(increases by a power of two), elements are never moved
 //!
-//! \throw  std::bad_alloc
+//! \throw  std::bad_alloc, std::overflow_error
+//!
+//! \note   The first call moves elements from the inline buffer to the reserved memory
 //!
 //====================================================================================================================================
 
 		void reallocMemory();
 
+//====================================================================================================================================
+//!
+//! \brief	Moves elements from the inline buffer to the reserved memory
+//!
+//! \param  size  Number of elements to commit
+//!
+//! \throw  std::bad_alloc
+//!
+//====================================================================================================================================
+
+		void spill(size_t size);
+
+		T       *data()       noexcept;
+		const T *data() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	Returns committed memory to the system when the stack has shrunk after a spike
+//!
+//====================================================================================================================================
+
+		void shrinkMemory() noexcept;
+
 	public:
-		static constexpr size_t DEFAULT_SIZE = 1;
+		static constexpr size_t DEFAULT_SIZE     = 1;
+		static constexpr size_t DEFAULT_MAX_SIZE = 1 << 20;
+		static constexpr size_t SHRINK_FACTOR    = 1 << 2; // Memory is returned when less than 1 / SHRINK_FACTOR is used
+		static constexpr size_t HOT_SIZE         = 3 * sizeof(size_t) + sizeof(NMemory::VirtualBuffer<T>); // Fields at the start of the stack touched by every push and pop
 
 		typedef       T &&rrVal_;
 		typedef const T  &crVal_;
 
-		explicit Stack(size_t = DEFAULT_SIZE) noexcept;
-		Stack(const Stack<T>&)                noexcept;
-		Stack(Stack&&)                        noexcept;
+//====================================================================================================================================
+//!
+//! \brief	Constructs stack, memory is taken from the system only if size does not fit the inline buffer
+//!
+//! \param  size       Expected stack depth (e.g. from static analysis of the program)
+//! \param  maxSize    Hard limit of the stack, exceeding it is reported as stack overflow
+//! \param  pResource  Memory resource for the guard metadata
+//!
+//! \throw  std::bad_alloc (as the copy, if the elements do not fit the inline buffer)
+//!
+//====================================================================================================================================
+
+		explicit Stack(size_t                      size      = DEFAULT_SIZE, 
+		               size_t                      maxSize   = DEFAULT_MAX_SIZE, 
+		               std::pmr::memory_resource *pResource = std::pmr::get_default_resource());
+		Stack(const Stack&);
+		Stack(Stack&&)      noexcept;
 		~Stack();
 
-		Stack<T> &operator=(const Stack&) noexcept;
-		Stack<T> &operator=(Stack&&)      noexcept;
+		Stack &operator=(const Stack&);
+		Stack &operator=(Stack&&)      noexcept;
 
 		bool operator==(const Stack&) const;
 		bool operator!=(const Stack&) const;
@@ -79,13 +132,65 @@ namespace NStack
 
 		bool empty() const noexcept;
 
+//====================================================================================================================================
+//!
+//! \brief   Returnes number of elements backed by committed memory
+//! 
+//! \return  Stack capacity
+//!
+//====================================================================================================================================
+
+		size_t capacity() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief   Returnes maximum number of elements in stack
+//! 
+//! \return  Stack limit
+//!
+//====================================================================================================================================
+
+		size_t limit() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief   Returnes maximum number of elements the stack has had (STATS_LVL >= 1)
+//! 
+//! \return  High-water mark
+//!
+//====================================================================================================================================
+
+		STATS(size_t highWater() const noexcept;)
+
+//====================================================================================================================================
+//!
+//! \brief   Returnes number of reallocMemory() calls (STATS_LVL >= 1)
+//! 
+//! \return  Reallocations
+//!
+//====================================================================================================================================
+
+		STATS(size_t reallocations() const noexcept;)
+
+//====================================================================================================================================
+//!
+//! \brief  Makes room for size elements, so that pushes below it do not take memory and pops do not return it
+//! 
+//! \param  size  Number of elements
+//!
+//! \throw  std::bad_alloc, std::overflow_error if size is above the limit
+//!
+//====================================================================================================================================
+
+		void reserve(size_t size);
+
 //====================================================================================================================================
 //!
 //! \brief  Pushes an element to the stack
 //! 
 //! \param  val  Value to push to the top of the stack
 //!
-//! \throw  std::bad_alloc
+//! \throw  std::bad_alloc, std::overflow_error
 //!
 //====================================================================================================================================
 
@@ -97,7 +202,7 @@ namespace NStack
 //! 
 //! \param  val  Value to push to the top of the stack
 //!
-//! \throw  std::bad_alloc
+//! \throw  std::bad_alloc, std::overflow_error
 //!
 //====================================================================================================================================
 
@@ -131,11 +236,11 @@ namespace NStack
 //!
 //! \param   rStack  The stack to swap with
 //!
-//! \throw   std::_Is_nothrow_swappable<T>::value  
+//! \throw   std::is_nothrow_swappable_v<T>  
 //!
 //====================================================================================================================================
 
-		void swap(Stack &rStack) noexcept(std::_Is_nothrow_swappable<T>::value);
+		void swap(Stack &rStack) noexcept(std::is_nothrow_swappable_v<T>);
 
 //====================================================================================================================================
 //!
@@ -143,7 +248,7 @@ namespace NStack
 //!
 //====================================================================================================================================
 
-		HASH_GUARD(inline void rehash() noexcept { hash_ = std::move(makeHash()); })
+		HASH_GUARD(inline void rehash() noexcept { cold_->hash.assign(makeHash()); })
 
 //====================================================================================================================================
 //!
@@ -153,7 +258,7 @@ namespace NStack
 //!
 //====================================================================================================================================
 
-		HASH_GUARD(inline std::string_view getHash() const noexcept { return hash_; })
+		HASH_GUARD(inline std::string_view getHash() const noexcept { return cold_->hash; })
 
 //====================================================================================================================================
 //!
@@ -173,20 +278,23 @@ namespace NStack
 //!
 //====================================================================================================================================
 
-		template<typename Char, typename Traits = std::char_traits<Char>>
-		void dump(std::basic_ostream<Char, Traits> &rOstr) const noexcept;
+		template<typename Char = char, typename Traits = std::char_traits<Char>>
+		void dump(std::basic_ostream<Char, Traits> &rOstr = std::cout) const noexcept;
 
 	private:
-		CANARY_GUARD(const std::string CANARY_VALUE;)
+		static constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::Stack;
 
-		CANARY_GUARD(const std::string canaryStart_;)
-		HASH_GUARD(std::string hash_;)
+		size_t                     counter_, // Hot fields go first, they are touched by every push and pop
+		                           size_,
+		                           limit_;
+		NMemory::VirtualBuffer<T>  buffer_;  // Empty until the inline buffer is exceeded
+		size_t                     reserved_; // Elements kept by reserve(), pops do not return memory below it
+		std::array<T, INLINE_SIZE> inline_;
 
-		size_t               counter_,
-		                     size_;
-		std::unique_ptr<T[]> buffer_;
+		STATS(size_t highWater_     = NULL;)
+		STATS(size_t reallocations_ = NULL;)
 
-		CANARY_GUARD(const std::string canaryFinish_;)
+		CANARY_GUARD(NGuard::ColdPtr cold_;)
 
 //====================================================================================================================================
 //!
@@ -204,9 +312,9 @@ namespace NStack
 			{
 				std::string tmp(std::to_string(counter_) + std::to_string(size_));
 
-				for (size_t i = 0; i < counter_; ++i) tmp += std::to_string(buffer_[i]);
+				for (size_t i = 0; i < counter_; ++i) tmp += std::to_string(data()[i]);
 
-				return std::string(NHash::Hash(tmp).getHash());				
+				return std::string(NHash::Hash<>(tmp).getHash());				
 			}
 		)
 
@@ -217,8 +325,8 @@ namespace NStack
 
 #pragma region STATIC_VARIABLES
 
-	template<typename T>
-	size_t Stack<T>::numberOfInstances = 0;
+	template<typename T, size_t INLINE_SIZE>
+	size_t Stack<T, INLINE_SIZE>::numberOfInstances = 0;
 
 #pragma endregion
 
@@ -235,25 +343,31 @@ namespace NStack
 	//!
 	//====================================================================================================================================
 
-	template<typename T>
-	Logger& operator<<(Logger &rLogger, const Stack<T> &crStack);
+	template<typename T, size_t INLINE_SIZE>
+	Logger& operator<<(Logger &rLogger, const Stack<T, INLINE_SIZE> &crStack);
 
 #pragma endregion
 
 #pragma region METHOD_DEFINITION
 
-	template<typename T>
-	inline Stack<T>::Stack(size_t size /* = DEFAULT_SIZE */) noexcept :
-		CANARY_GUARD(CANARY_VALUE(NHash::Hash("Stack" + std::to_string(++numberOfInstances)).getHash()),)
-		CANARY_GUARD(canaryStart_(CANARY_VALUE),)
-		HASH_GUARD(hash_(),)
-
+	template<typename T, size_t INLINE_SIZE>
+	inline Stack<T, INLINE_SIZE>::Stack(size_t                      size      /* = DEFAULT_SIZE */, 
+	                                    size_t                      maxSize   /* = DEFAULT_MAX_SIZE */, 
+	                                    [[maybe_unused]] std::pmr::memory_resource *pResource /* = std::pmr::get_default_resource() */) : // Only the guards use it
 		counter_(NULL),
-		size_(size),
-		buffer_(new T[size])
+		size_(INLINE_SIZE),
+		limit_(maxSize),
+		buffer_(),
+		reserved_(NULL),
+		inline_()
 
-		CANARY_GUARD(, canaryFinish_(CANARY_VALUE))
+		CANARY_GUARD(, cold_(NHash::Hash<>("Stack" + std::to_string(++numberOfInstances)).getHash(), pResource))
 	{
+		static_assert(INLINE_SIZE, "Stack needs at least one inline element\n");
+
+		if (size >= INLINE_SIZE)
+			spill(size + 1);
+
 		HASH_GUARD(rehash();)
 
 		CANARY_GUARD(numberOfInstances--;)
@@ -264,19 +378,22 @@ namespace NStack
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline Stack<T>::Stack(const Stack<T> &crStack) noexcept :
-		CANARY_GUARD(CANARY_VALUE(NHash::Hash("Stack" + std::to_string(++numberOfInstances)).getHash()),)
-		CANARY_GUARD(canaryStart_(CANARY_VALUE),)
-		HASH_GUARD(hash_(),)
-
-		counter_(crStack.counter_),
-		size_(crStack.size_),
-		buffer_(new T[crStack.size_])
+	template<typename T, size_t INLINE_SIZE>
+	inline Stack<T, INLINE_SIZE>::Stack(const Stack<T, INLINE_SIZE> &crStack) :
+		counter_(NULL),
+		size_(INLINE_SIZE),
+		limit_(crStack.limit_),
+		buffer_(),
+		reserved_(NULL),
+		inline_()
 
-		CANARY_GUARD(, canaryFinish_(CANARY_VALUE))
+		CANARY_GUARD(, cold_(NHash::Hash<>("Stack" + std::to_string(++numberOfInstances)).getHash(), crStack.cold_.resource()))
 	{
-		std::copy(crStack.buffer_.get(), crStack.buffer_.get() + crStack.counter_, buffer_.get());
+		if (crStack.counter_ >= INLINE_SIZE)
+			spill(crStack.counter_ + 1);
+
+		counter_ = crStack.counter_;
+		std::copy(crStack.data(), crStack.data() + crStack.counter_, data());
 
 		HASH_GUARD(rehash();)
 
@@ -288,22 +405,22 @@ namespace NStack
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline Stack<T>::Stack(Stack<T> &&rrStack) noexcept :
-		CANARY_GUARD(CANARY_VALUE(NHash::Hash("Stack" + std::to_string(++numberOfInstances)).getHash()),)
-		CANARY_GUARD(canaryStart_(CANARY_VALUE), )
-		HASH_GUARD(hash_(rrStack.hash_), )
-
+	template<typename T, size_t INLINE_SIZE>
+	inline Stack<T, INLINE_SIZE>::Stack(Stack<T, INLINE_SIZE> &&rrStack) noexcept :
 		counter_(rrStack.counter_),
 		size_(rrStack.size_),
-		buffer_(rrStack.buffer_.release())
+		limit_(rrStack.limit_),
+		buffer_(std::move(rrStack.buffer_)),
+		reserved_(rrStack.reserved_),
+		inline_(rrStack.inline_)
 
-		CANARY_GUARD(, canaryFinish_(CANARY_VALUE))
+		CANARY_GUARD(, cold_(NHash::Hash<>("Stack" + std::to_string(++numberOfInstances)).getHash(), rrStack.cold_.resource()))
 	{
-		rrStack.counter_ = NULL;
-		rrStack.size_    = NULL;
-		rrStack.buffer_  = nullptr;
-		HASH_GUARD(rrStack.hash_.clear();)
+		HASH_GUARD(cold_->hash.assign(rrStack.cold_->hash);)
+		rrStack.counter_  = NULL;
+		rrStack.size_     = INLINE_SIZE;
+		rrStack.reserved_ = NULL;
+		HASH_GUARD(rrStack.cold_->hash.clear();)
 
 		CANARY_GUARD(numberOfInstances--;)
 		numberOfInstances++;
@@ -313,8 +430,8 @@ namespace NStack
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline Stack<T>::~Stack()
+	template<typename T, size_t INLINE_SIZE>
+	inline Stack<T, INLINE_SIZE>::~Stack()
 	{
 		numberOfInstances--;
 
@@ -323,75 +440,122 @@ namespace NStack
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	void Stack<T>::reallocMemory()
+	template<typename T, size_t INLINE_SIZE>
+	void Stack<T, INLINE_SIZE>::reallocMemory()
 	{
 		GUARD_CHECK()
 
-		T *pBuf = buffer_.release();
+		STATS(reallocations_++;)
 
-		size_ <<= 1;
-		buffer_.reset(new T[size_]);
+		[[maybe_unused]] size_t oldSize = size_;
 
-		std::copy(pBuf, pBuf + counter_, buffer_.get());
+		if (!buffer_)
+			spill((size_ + 1) << 1);
+
+		else if (!buffer_.commit(size_ << 1))
+			throw std::overflow_error(std::string("[") + __FUNCTION__ + "] Stack overflow\n");
+
+		size_ = buffer_.capacity();
+
+		USDT(stack__grow, this, oldSize, size_);
 
 		HASH_GUARD(rehash();)
 
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	Stack<T> &Stack<T>::operator=(const Stack &crStack) noexcept
+	template<typename T, size_t INLINE_SIZE>
+	void Stack<T, INLINE_SIZE>::spill(size_t size)
+	{
+		NMemory::VirtualBuffer<T> buffer(limit_ + 1); // One spare element, so that the full stack is still valid
+		if (!buffer || !buffer.commit(std::min(size, limit_ + 1))) // The stack stays inline on failure
+			throw std::bad_alloc();
+
+		std::copy(inline_.data(), inline_.data() + counter_, buffer.get());
+
+		buffer_ = std::move(buffer);
+		size_   = buffer_.capacity();
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	inline T *Stack<T, INLINE_SIZE>::data() noexcept
+	{
+		return (buffer_ ? buffer_.get() : inline_.data());
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	inline const T *Stack<T, INLINE_SIZE>::data() const noexcept
+	{
+		return (buffer_ ? buffer_.get() : inline_.data());
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	void Stack<T, INLINE_SIZE>::shrinkMemory() noexcept
+	{
+		buffer_.decommit(size_ >> 1);
+
+		size_ = buffer_.capacity();
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	Stack<T, INLINE_SIZE> &Stack<T, INLINE_SIZE>::operator=(const Stack &crStack)
 	{
 		GUARD_CHECK()
 
 		if (this != &crStack)
 		{
-			counter_ = crStack.counter_;
+			counter_ = NULL;
 
-			if (size_ != crStack.size_)
+			if (limit_ != crStack.limit_)
 			{
-				size_ = crStack.size_;
-
-				buffer_.reset(new T[size_]);
+				limit_    = crStack.limit_;
+				buffer_   = NMemory::VirtualBuffer<T>();
+				size_     = INLINE_SIZE;
+				reserved_ = NULL;
 			}
 
-			std::copy(crStack.buffer_.get(), crStack.buffer_.get() + crStack.size_, buffer_.get());
+			size_t reserved = reserved_;
+			reserve(crStack.counter_);
+			reserved_ = reserved; // The depth of the copy is not a reservation
+
+			counter_ = crStack.counter_;
+			std::copy(crStack.data(), crStack.data() + crStack.counter_, data());
 		}
-		HASH_GUARD(hash_ = crStack.hash_;)
+		HASH_GUARD(cold_->hash.assign(crStack.cold_->hash);)
 
 		GUARD_CHECK()
 
 		return (*this);
 	}
 
-	template<typename T>
-	Stack<T> &Stack<T>::operator=(Stack &&rrStack) noexcept
+	template<typename T, size_t INLINE_SIZE>
+	Stack<T, INLINE_SIZE> &Stack<T, INLINE_SIZE>::operator=(Stack &&rrStack) noexcept
 	{
 		GUARD_CHECK()
 
 		assert(this != &rrStack);
 
-		buffer_ = nullptr;
+		counter_  = rrStack.counter_;
+		size_     = rrStack.size_;
+		limit_    = rrStack.limit_;
+		buffer_   = std::move(rrStack.buffer_);
+		reserved_ = rrStack.reserved_;
+		inline_   = rrStack.inline_;
 
-		counter_ = rrStack.counter_;
-		size_    = rrStack.size_;
-		buffer_  = std::move(rrStack.buffer_);
+		HASH_GUARD(cold_->hash.assign(rrStack.cold_->hash);)
 
-		HASH_GUARD(hash_ = rrStack.hash_;)
-
-		rrStack.counter_ = NULL;
-		rrStack.size_    = NULL;
-		rrStack.buffer_  = nullptr;
-		HASH_GUARD(rrStack.hash_.clear();)
+		rrStack.counter_  = NULL;
+		rrStack.size_     = INLINE_SIZE;
+		rrStack.reserved_ = NULL;
+		HASH_GUARD(rrStack.cold_->hash.clear();)
 
 		GUARD_CHECK()
 
 		return (*this);
 	}
 
-	template<typename T>
-	inline bool Stack<T>::operator==(const Stack &crStack) const
+	template<typename T, size_t INLINE_SIZE>
+	inline bool Stack<T, INLINE_SIZE>::operator==(const Stack &crStack) const
 	{
 		GUARD_CHECK()
 
@@ -403,61 +567,120 @@ namespace NStack
 
 		GUARD_CHECK()
 
-		return std::equal(&buffer_[0], &buffer_[counter_ - 1], &crStack.buffer_[0]);
+		return std::equal(data(), data() + counter_, crStack.data());
 	}
 
-	template<typename T>
-	inline bool Stack<T>::operator!=(const Stack &crStack) const 
+	template<typename T, size_t INLINE_SIZE>
+	inline bool Stack<T, INLINE_SIZE>::operator!=(const Stack &crStack) const 
 	{
 		return (!(*this == crStack));
 	}
 
-	template<typename T>
-	inline size_t Stack<T>::size() const noexcept
+	template<typename T, size_t INLINE_SIZE>
+	inline size_t Stack<T, INLINE_SIZE>::size() const noexcept
 	{ 
 		return counter_;
 	}
 
-	template<typename T>
-	inline bool Stack<T>::empty() const noexcept
+	template<typename T, size_t INLINE_SIZE>
+	inline bool Stack<T, INLINE_SIZE>::empty() const noexcept
 	{ 
 		return (counter_ ? false : true); 
 	}
 
-	template<typename T>
-	inline void Stack<T>::push(crVal_ val)
+	template<typename T, size_t INLINE_SIZE>
+	inline size_t Stack<T, INLINE_SIZE>::capacity() const noexcept
+	{ 
+		return size_;
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	inline size_t Stack<T, INLINE_SIZE>::limit() const noexcept
+	{ 
+		return limit_;
+	}
+
+#if STATS_LVL >= 1
+
+	template<typename T, size_t INLINE_SIZE>
+	inline size_t Stack<T, INLINE_SIZE>::highWater() const noexcept
+	{ 
+		return highWater_;
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	inline size_t Stack<T, INLINE_SIZE>::reallocations() const noexcept
+	{ 
+		return reallocations_;
+	}
+
+#endif // STATS_LVL
+
+	template<typename T, size_t INLINE_SIZE>
+	void Stack<T, INLINE_SIZE>::reserve(size_t size)
+	{
+		GUARD_CHECK()
+
+		if (size > limit_)
+			throw std::overflow_error(std::string("[") + __FUNCTION__ + "] Stack overflow\n");
+
+		if (size >= size_)
+		{
+			if (!buffer_)                      spill(size + 1);
+			else if (!buffer_.commit(size + 1)) throw std::bad_alloc();
+
+			size_ = buffer_.capacity();
+		}
+
+		reserved_ = std::max(reserved_, size + 1); // The spare element of the full stack is kept too
+
+		HASH_GUARD(rehash();)
+
+		GUARD_CHECK()
+	}
+
+	template<typename T, size_t INLINE_SIZE>
+	inline void Stack<T, INLINE_SIZE>::push(crVal_ val)
 	{
 		GUARD_CHECK()
 
-		if (counter_ + 1 == size_) 
+		if (counter_ == limit_)
+			throw std::overflow_error(std::string("[") + __FUNCTION__ + "] Stack overflow\n");
+
+		if (counter_ + 1 >= size_) 
 			reallocMemory();
 
-		buffer_[counter_] = val;
+		data()[counter_] = val;
 		++counter_;
+		STATS(if (counter_ > highWater_) highWater_ = counter_;)
 
 		HASH_GUARD(rehash();)
 
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline void Stack<T>::push(rrVal_ val)
+	template<typename T, size_t INLINE_SIZE>
+	inline void Stack<T, INLINE_SIZE>::push(rrVal_ val)
 	{
 		GUARD_CHECK()
 
-		if (counter_ + 1 == size_) 
+		if (counter_ == limit_)
+			throw std::overflow_error(std::string("[") + __FUNCTION__ + "] Stack overflow\n");
+
+		if (counter_ + 1 >= size_) 
 			reallocMemory();
 
-		buffer_[counter_] = val;
+		data()[counter_] = val;
 		++counter_;
+		STATS(if (counter_ > highWater_) highWater_ = counter_;)
 
 		HASH_GUARD(rehash();)
 
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline void Stack<T>::pop()
+	template<typename T, size_t INLINE_SIZE>
+	inline void Stack<T, INLINE_SIZE>::pop()
 	{
 		GUARD_CHECK()
 
@@ -466,13 +689,16 @@ namespace NStack
 
 		--counter_;
 
+		if (buffer_ && counter_ * SHRINK_FACTOR < size_ && size_ > NMemory::GetPageSize() / sizeof(T) && (size_ >> 1) >= reserved_)
+			shrinkMemory();
+
 		HASH_GUARD(rehash();)
 
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline typename Stack<T>::crVal_ Stack<T>::top() const
+	template<typename T, size_t INLINE_SIZE>
+	inline typename Stack<T, INLINE_SIZE>::crVal_ Stack<T, INLINE_SIZE>::top() const
 	{
 		GUARD_CHECK()
 
@@ -481,67 +707,71 @@ namespace NStack
 
 		GUARD_CHECK()
 
-		return buffer_[counter_ - 1];
+		return data()[counter_ - 1];
 	}
 
-	template<typename T>
-	void Stack<T>::swap(Stack &rStack) noexcept(std::_Is_nothrow_swappable<T>::value)
+	template<typename T, size_t INLINE_SIZE>
+	void Stack<T, INLINE_SIZE>::swap(Stack &rStack) noexcept(std::is_nothrow_swappable_v<T>)
 	{
 		GUARD_CHECK()
 
 		using std::swap; // To have all possible swaps
 
-		HASH_GUARD(swap(hash_, rStack.hash_);)
 
 		swap(counter_, rStack.counter_);
 		swap(size_, rStack.size_);
+		swap(limit_, rStack.limit_);
+		swap(reserved_, rStack.reserved_);
 
-		swap(buffer_, rStack.buffer_);
+		buffer_.swap(rStack.buffer_);
+		inline_.swap(rStack.inline_);
+
+		HASH_GUARD(rehash(); rStack.rehash();) // Hashes stay in their own memory resources
 
 		GUARD_CHECK()
 	}
 
-	template<typename T>
-	inline bool Stack<T>::ok() const noexcept
+	template<typename T, size_t INLINE_SIZE>
+	inline bool Stack<T, INLINE_SIZE>::ok() const noexcept
 	{
-		return (CANARY_GUARD(canaryStart_ == CANARY_VALUE && canaryFinish_ == CANARY_VALUE && )
-				HASH_GUARD(hash_ == makeHash() && )
-				(size_ > counter_) && buffer_);		
+		return (CANARY_GUARD(cold_->canaryStart == cold_->CANARY_VALUE && cold_->canaryFinish == cold_->CANARY_VALUE && )
+				HASH_GUARD(cold_->hash == std::string_view(makeHash()) && )
+				(size_ > counter_) && (limit_ >= counter_) && data());		
 	}
 
-	template<typename T>
+	template<typename T, size_t INLINE_SIZE>
 	template<typename Char, typename Traits>
-	void Stack<T>::dump(std::basic_ostream<Char, Traits> &rOstr) const noexcept
+	void Stack<T, INLINE_SIZE>::dump(std::basic_ostream<Char, Traits> &rOstr) const noexcept
 	{
 		try
         {
             NDebugger::Text(std::string_view("\t[STACK DUMP]"), rOstr, NDebugger::Colors::Yellow);
 
 		    rOstr << "Stack <" << typeid(T).name() << "> [0x" << this << "]\n"
-			      << "{\n\tbuffer [" << counter_ << "] = 0x" << buffer_.get() << "\n\t{\n";
+			      << "{\n\tbuffer [" << counter_ << "] = 0x" << data() << "\n\t{\n";
 
-		    if (counter_) for (size_t i = 0; i < counter_; ++i) rOstr << "\t\t[" << i << "] = " << std::setw(8) << buffer_[i] << std::endl;
+		    if (counter_) for (size_t i = 0; i < counter_; ++i) rOstr << "\t\t[" << i << "] = " << std::setw(8) << data()[i] << std::endl;
 		    else                                                rOstr << "\t\tempty\n";
 
 		    rOstr << "\t}\n\n";
 
 		    CANARY_GUARD
 		    (
-			    rOstr << "\tCANARY_VALUE  = " << CANARY_VALUE << std::endl;
+			    rOstr << "\tCANARY_VALUE  = " << cold_->CANARY_VALUE << std::endl;
 
-			    rOstr << "\tCANARY_START  = " << canaryStart_;
-			    if (canaryStart_ == CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			    rOstr << "\tCANARY_START  = " << cold_->canaryStart;
+			    if (cold_->canaryStart == cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
 			    else                              NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 
-			    rOstr << "\tCANARY_FINISH = " << canaryFinish_;
-			    if (canaryFinish_ == CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			    rOstr << "\tCANARY_FINISH = " << cold_->canaryFinish;
+			    if (cold_->canaryFinish == cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
 			    else                               NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 			    )
 
 		    HASH_GUARD
 		    (
-			    rOstr << "\n\tHASH = " << hash_;		
-			    if (hash_ == makeHash()) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+			    rOstr << "\n\tHASH = " << cold_->hash;		
+			    if (cold_->hash == std::string_view(makeHash())) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
 			    else                     NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 		    )
 
@@ -553,7 +783,7 @@ namespace NStack
         {
             std::cerr << "Something went wrong in \"" << __FUNCTION__ << "\"! Goodbye!!!\n";
             
-            terminate();    
+            std::terminate();    
         }
 	}
 
@@ -561,9 +791,11 @@ namespace NStack
 
 #pragma region FUNCTION_DEFINITION
 
-	template<typename T>
-	Logger& operator<<(Logger &rLogger, const Stack<T> &crStack)
+	template<typename T, size_t INLINE_SIZE>
+	Logger& operator<<(Logger &rLogger, const Stack<T, INLINE_SIZE> &crStack)
 	{
+		auto lock = Logger::lock(); // The dump goes to the file directly
+
 		Logger::stdPack(std::string("Stack<") + typeid(T).name() + ">");
 
 		crStack.dump(Logger::getOfstream());
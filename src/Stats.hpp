@@ -0,0 +1,98 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Stats.hpp
+//!
+//! \brief	Runtime statistics of the CPU: retired instructions by category, stack and RAM usage, reallocations, guard checks
+//!
+//! \note   Compiled in only if STATS_LVL >= 1, every counter is a plain increment and is not there at all otherwise
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <ostream> // std::ostream
+
+#if STATS_LVL >= 1
+	#define STATS(...) __VA_ARGS__
+#else
+	#define STATS(...)
+#endif // STATS_LVL
+
+namespace NStats
+{
+
+#pragma region CONSTANTS
+
+#if STATS_LVL >= 1
+	constexpr bool ENABLED = true;
+#else
+	constexpr bool ENABLED = false;
+#endif // STATS_LVL
+
+#pragma endregion
+
+#pragma region STRUCTS
+
+//====================================================================================================================================
+//!
+//! \brief	Counters of one CPU, all zero if the statistics are not compiled in
+//!
+//====================================================================================================================================
+
+	struct Stats
+	{
+		unsigned long long retired,          // Instructions including end
+		                   arithmetic,       // add, sub, mul, div, sqrt, sin, cos
+		                   branchesTaken,    // jump and the conditional jumps which jumped
+		                   branchesNotTaken,
+		                   calls,
+		                   reallocations,    // Stack::reallocMemory() calls of the value and the return address stacks
+		                   guardChecks;      // GUARD_CHECK() made by the thread since the CPU was constructed or reset
+		size_t             stackHighWater,   // Maximum depth of the value stack
+		                   ramCellsUsed;     // Maximum number of RAM cells put at once
+	};
+
+#pragma endregion
+
+#pragma region STATIC_VARIABLES
+
+//====================================================================================================================================
+//!
+//! \brief	GUARD_CHECK() of all the objects of the thread, CPU reports the difference
+//!
+//====================================================================================================================================
+
+	STATS(inline thread_local unsigned long long guardChecks = 0;)
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+	inline std::ostream &operator<<(std::ostream &rOstr, const Stats &crStats);
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline std::ostream &operator<<(std::ostream &rOstr, const Stats &crStats)
+	{
+		return rOstr << "retired "             << crStats.retired
+		             << ", arithmetic "        << crStats.arithmetic
+		             << ", branches taken "    << crStats.branchesTaken
+		             << ", branches not taken " << crStats.branchesNotTaken
+		             << ", calls "             << crStats.calls
+		             << ", stack high-water "  << crStats.stackHighWater
+		             << ", RAM cells "         << crStats.ramCellsUsed
+		             << ", reallocations "     << crStats.reallocations
+		             << ", guard checks "      << crStats.guardChecks;
+	}
+
+#pragma endregion
+
+} // namespace NStats
@@ -14,15 +14,31 @@
 #error
 #endif /* __cplusplus */
 
-#include <cassert> // assert
-#include <iomanip> // std::setw
-#include <array>   // std::array
-
+#include <cassert>     // assert
+#include <iomanip>     // std::setw
+#include <iostream>    // std::cout
+#include <array>       // std::array
+#include <stdexcept>   // std::out_of_range
+#include <string>      // std::string
+#include <type_traits> // std::conditional_t, std::is_void_v
+#include <typeinfo>    // typeid
+
+#include <memory_resource> // std::pmr::memory_resource, std::pmr::string
+
+#include "Debugger.hpp"
 #include "Guard.hpp"
 
 #pragma region CLASSES
 
-template<typename T, size_t SIZE>
+//====================================================================================================================================
+//!
+//! \brief	Static storage, the derived class is passed as Derived (CRTP) so element access is resolved at compile time
+//!
+//! \note   Derived may hide inRange() to narrow the accessible part of the storage
+//!
+//====================================================================================================================================
+
+template<typename T, size_t SIZE, typename Derived = void>
 class Storage 
 {
 public:
@@ -30,13 +46,21 @@ public:
 	typedef       T &&rrVal_;
 	typedef const T  &crVal_;
 
-	explicit Storage()      noexcept;
+//====================================================================================================================================
+//!
+//! \brief	Constructs storage
+//!
+//! \param  pResource  Memory resource for the guard metadata
+//!
+//====================================================================================================================================
+
+	explicit Storage(std::pmr::memory_resource *pResource = std::pmr::get_default_resource()) noexcept;
 	Storage(const Storage&) noexcept;
 	Storage(Storage&&)      noexcept;
 	~Storage();
 
-	virtual Storage &operator=(const Storage&) noexcept;
-	virtual Storage &operator=(Storage&&)      noexcept;
+	Storage &operator=(const Storage&) noexcept;
+	Storage &operator=(Storage&&)      noexcept;
 
 //====================================================================================================================================
 //!
@@ -50,7 +74,7 @@ public:
 //!
 //====================================================================================================================================
 
-	virtual rVal_  operator[](size_t index);
+	rVal_  operator[](size_t index);
 
 //====================================================================================================================================
 //!
@@ -64,7 +88,35 @@ public:
 //!
 //====================================================================================================================================
 
-	virtual crVal_ operator[](size_t index) const;
+	crVal_ operator[](size_t index) const;
+
+//====================================================================================================================================
+//!
+//! \brief   Returnes element at index without size checking, for indices verified beforehand
+//! 
+//! \param   index  Position of the element
+//!
+//! \return  Element at index 
+//!
+//====================================================================================================================================
+
+	rVal_  get(size_t index)       noexcept;
+	crVal_ get(size_t index) const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief   Checks if the element at index is accessible
+//! 
+//! \param   index  Position of the element
+//!
+//! \return  Is index in range
+//!
+//====================================================================================================================================
+
+	bool inRange(size_t index) const noexcept
+	{
+		return (index < SIZE);
+	}
 
 //====================================================================================================================================
 //!
@@ -89,7 +141,7 @@ public:
 //!
 //====================================================================================================================================
 
-	void swap(Storage &rStorage) noexcept(std::_Is_nothrow_swappable<T>::value);
+	void swap(Storage &rStorage) noexcept(std::is_nothrow_swappable_v<T>);
 
 //====================================================================================================================================
 //!
@@ -97,7 +149,7 @@ public:
 //!
 //====================================================================================================================================
 
-	HASH_GUARD(inline void rehash() { hash_ = std::move(makeHash()); })
+	HASH_GUARD(inline void rehash() { cold_->hash.assign(makeHash()); })
 
 //====================================================================================================================================
 //!
@@ -107,7 +159,7 @@ public:
 //!
 //====================================================================================================================================
 
-	HASH_GUARD(inline std::string_view getHash() const { return hash_; })
+	HASH_GUARD(inline std::string_view getHash() const { return cold_->hash; })
 
 //====================================================================================================================================
 //!
@@ -125,20 +177,19 @@ public:
 //!
 //! \param  rOstr  Stream to output
 //!
-//! \throw  smth
-//!
 //====================================================================================================================================
 
-	// template<typename Char, typename Traits = std::char_traits<Char>>
-	// void dump(std::basic_ostream<Char, Traits> &rOstr) const;
+	void dump(std::ostream &rOstr = std::cout) const;
 
 protected:
-	CANARY_GUARD(const std::string CANARY_VALUE;)
-	CANARY_GUARD(std::string canaryStart_;)
-	
+	typedef std::conditional_t<std::is_void_v<Derived>, Storage, Derived> derived_;
+
+	derived_       &derived()       noexcept { return static_cast<derived_&>(*this); }
+	const derived_ &derived() const noexcept { return static_cast<const derived_&>(*this); }
+
 	std::array<T, SIZE> buf_;
 
-	CANARY_GUARD(std::string canaryFinish_;)
+	CANARY_GUARD(NGuard::ColdPtr cold_;) // Out of line, so buf_ starts the object
 
 //====================================================================================================================================
 //!
@@ -157,13 +208,11 @@ protected:
 			std::string tmp;
 			for (auto &&x : buf_) tmp += std::to_string(x);
 
-			return std::string(NHash::Hash(tmp).getHash());
+			return std::string(NHash::Hash<>(tmp).getHash());
 		}
 	)
 
 private:
-	HASH_GUARD(std::string hash_;)
-
 	static size_t numberOfInstances;
 };
 
@@ -171,82 +220,72 @@ private:
 
 #pragma region STATIC_VARIABLES
 
-template<typename T, size_t SIZE>
-size_t Storage<T, SIZE>::numberOfInstances = 0;
+template<typename T, size_t SIZE, typename Derived>
+size_t Storage<T, SIZE, Derived>::numberOfInstances = 0;
 
 #pragma endregion
 
 #pragma region FUNCTION_DECLARATION
 
-template<typename T, size_t SIZE>
-inline std::ostream &operator<<(std::ostream&, const Storage<T, SIZE>&);
+template<typename T, size_t SIZE, typename Derived>
+inline std::ostream &operator<<(std::ostream&, const Storage<T, SIZE, Derived>&);
 
 #pragma endregion
 
 #pragma region METHOD_DEFINITION
 
-template<typename T, size_t SIZE>
-Storage<T, SIZE>::Storage() noexcept :
-	CANARY_GUARD(CANARY_VALUE(NHash::Hash("Storage" + ++numberOfInstances).getHash()), )
-	CANARY_GUARD(canaryStart_(CANARY_VALUE), )
-	HASH_GUARD(hash_(), )
-
+template<typename T, size_t SIZE, typename Derived>
+Storage<T, SIZE, Derived>::Storage([[maybe_unused]] std::pmr::memory_resource *pResource /* = std::pmr::get_default_resource() */) noexcept :
 	buf_()
 
-	CANARY_GUARD(, canaryFinish_(CANARY_VALUE))
+	CANARY_GUARD(, cold_(NHash::Hash<>("Storage" + std::to_string(++numberOfInstances)).getHash(), pResource))
 {		
-	HASH_GUARD(hash_ = makeHash();)
+	HASH_GUARD(cold_->hash.assign(makeHash());)
 	CANARY_GUARD(numberOfInstances--;)
 	numberOfInstances++;
 
 	GUARD_CHECK()
 }
 
-template<typename T, size_t SIZE>
-Storage<T, SIZE>::Storage(const Storage &crStorage) noexcept :
-	CANARY_GUARD(CANARY_VALUE(NHash::Hash("Storage" + ++numberOfInstances).getHash()), )
-	CANARY_GUARD(canaryStart_(CANARY_VALUE), )
-	HASH_GUARD(hash_(crStorage.hash_), )
-
+template<typename T, size_t SIZE, typename Derived>
+Storage<T, SIZE, Derived>::Storage(const Storage &crStorage) noexcept :
 	buf_(crStorage.buf_)
 
-	CANARY_GUARD(, canaryFinish_(CANARY_VALUE))
+	CANARY_GUARD(, cold_(NHash::Hash<>("Storage" + std::to_string(++numberOfInstances)).getHash(), crStorage.cold_.resource()))
 {
+	HASH_GUARD(cold_->hash.assign(crStorage.cold_->hash);)
 	CANARY_GUARD(numberOfInstances--;)
 	numberOfInstances++;
 
 	GUARD_CHECK()
 }
 
-template<typename T, size_t SIZE>
-Storage<T, SIZE>::Storage(Storage &&rrStorage) noexcept :
-	CANARY_GUARD(CANARY_VALUE(NHash::Hash("Storage" + ++numberOfInstances).getHash()), )
-	CANARY_GUARD(canaryStart_(CANARY_VALUE), )
-	HASH_GUARD(hash_(std::move(rrStorage.hash_)), )
-
+template<typename T, size_t SIZE, typename Derived>
+Storage<T, SIZE, Derived>::Storage(Storage &&rrStorage) noexcept :
 	buf_(std::move(rrStorage.buf_))
 
-	CANARY_GUARD(, canaryFinish_(CANARY_VALUE))
+	CANARY_GUARD(, cold_(NHash::Hash<>("Storage" + std::to_string(++numberOfInstances)).getHash(), rrStorage.cold_.resource()))
 {
+	HASH_GUARD(cold_->hash.assign(rrStorage.cold_->hash);)
 	CANARY_GUARD(numberOfInstances--;)
 	numberOfInstances++;
 
 	rrStorage.buf_.fill(NULL);
-	HASH_GUARD(rrStorage.hash_.clear();)
+	HASH_GUARD(rrStorage.cold_->hash.clear();)
 	
 	GUARD_CHECK()
 }
 
-template<typename T, size_t SIZE>
-inline Storage<T, SIZE>::~Storage()
+template<typename T, size_t SIZE, typename Derived>
+inline Storage<T, SIZE, Derived>::~Storage()
 {
 	numberOfInstances--;
 
 	GUARD_CHECK()
 }
 
-template<typename T, size_t SIZE>
-inline Storage<T, SIZE> &Storage<T, SIZE>::operator=(const Storage &crStorage) noexcept
+template<typename T, size_t SIZE, typename Derived>
+inline Storage<T, SIZE, Derived> &Storage<T, SIZE, Derived>::operator=(const Storage &crStorage) noexcept
 {
 	GUARD_CHECK()
 
@@ -262,65 +301,83 @@ inline Storage<T, SIZE> &Storage<T, SIZE>::operator=(const Storage &crStorage) n
 	return (*this);
 }
 
-template<typename T, size_t SIZE>
-inline Storage<T, SIZE> &Storage<T, SIZE>::operator=(Storage &&rrStorage) noexcept
+template<typename T, size_t SIZE, typename Derived>
+inline Storage<T, SIZE, Derived> &Storage<T, SIZE, Derived>::operator=(Storage &&rrStorage) noexcept
 {
 	GUARD_CHECK()
 
 	assert(this != &rrStorage);
 
 	buf_ = std::move(rrStorage.buf_);
-	HASH_GUARD(hash_ = std::move(rrStorage.hash_);)
+	HASH_GUARD(cold_->hash.assign(rrStorage.cold_->hash);)
 
 	rrStorage.buf_.fill(NULL);
-	HASH_GUARD(rrStorage.hash_.clear();)
+	HASH_GUARD(rrStorage.cold_->hash.clear();)
 
 	GUARD_CHECK()
 
 	return (*this);
 }
 
-template<typename T, size_t SIZE>
-inline typename Storage<T, SIZE>::rVal_ Storage<T, SIZE>::operator[](size_t index)
+template<typename T, size_t SIZE, typename Derived>
+inline typename Storage<T, SIZE, Derived>::rVal_ Storage<T, SIZE, Derived>::operator[](size_t index)
 {
 	GUARD_CHECK()
 
-	return  buf_.at(index);
+	if (!derived().inRange(index)) throw std::out_of_range(std::string("[") + __FUNCTION__ + "] Storage out of range\n");
+
+	return buf_[index];
 }
 
-template<typename T, size_t SIZE>
-inline typename Storage<T, SIZE>::crVal_ Storage<T, SIZE>::operator[](size_t index) const
+template<typename T, size_t SIZE, typename Derived>
+inline typename Storage<T, SIZE, Derived>::crVal_ Storage<T, SIZE, Derived>::operator[](size_t index) const
 {
 	GUARD_CHECK()
 
-	return buf_.at(index);
+	if (!derived().inRange(index)) throw std::out_of_range(std::string("[") + __FUNCTION__ + "] Storage out of range\n");
+
+	return buf_[index];
+}
+
+template<typename T, size_t SIZE, typename Derived>
+inline typename Storage<T, SIZE, Derived>::rVal_ Storage<T, SIZE, Derived>::get(size_t index) noexcept
+{
+	assert(derived().inRange(index));
+
+	return buf_[index];
+}
+
+template<typename T, size_t SIZE, typename Derived>
+inline typename Storage<T, SIZE, Derived>::crVal_ Storage<T, SIZE, Derived>::get(size_t index) const noexcept
+{
+	assert(derived().inRange(index));
+
+	return buf_[index];
 }
 
-template<typename T, size_t SIZE>
-inline void Storage<T, SIZE>::swap(Storage &rStorage) noexcept(std::_Is_nothrow_swappable<T>::value)
+template<typename T, size_t SIZE, typename Derived>
+inline void Storage<T, SIZE, Derived>::swap(Storage &rStorage) noexcept(std::is_nothrow_swappable_v<T>)
 {
 	GUARD_CHECK()
 
 	using std::swap; // To have all possible swaps
 
 	buf_.swap(rStorage.buf_);
-	HASH_GUARD(swap(hash_, rStorage.hash_);)
+	HASH_GUARD(rehash(); rStorage.rehash();) // Hashes stay in their own memory resources
 
 	GUARD_CHECK()
 }
 
-template<typename T, size_t SIZE>
-bool Storage<T, SIZE>::ok() const noexcept
+template<typename T, size_t SIZE, typename Derived>
+bool Storage<T, SIZE, Derived>::ok() const noexcept
 {
-	return (CANARY_GUARD(canaryStart_ == CANARY_VALUE && canaryFinish_ == CANARY_VALUE && )
-			HASH_GUARD(hash_ == makeHash() && )
-			&buf_);
+	return (CANARY_GUARD(cold_->canaryStart == cold_->CANARY_VALUE && cold_->canaryFinish == cold_->CANARY_VALUE && )
+			HASH_GUARD(cold_->hash == std::string_view(makeHash()) && )
+			true);
 }
 
-/*
-template<typename T, size_t SIZE>
-template<typename Char, typename Traits>
-void Storage<T, SIZE>::dump(std::basic_ostream<Char, Traits> &rOstr) const
+template<typename T, size_t SIZE, typename Derived>
+void Storage<T, SIZE, Derived>::dump(std::ostream &rOstr /* = std::cout */) const
 {
 	rOstr << "[STORAGE DUMP]\n" 
           << "Storage <" << typeid(T).name() << ", " << SIZE << "> [0x" << this << "]\n{\n"
@@ -332,36 +389,35 @@ void Storage<T, SIZE>::dump(std::basic_ostream<Char, Traits> &rOstr) const
 
 	CANARY_GUARD
 	(
-		rOstr << "\tCANARY_VALUE  = " << CANARY_VALUE << std::endl;
+		rOstr << "\tCANARY_VALUE  = " << cold_->CANARY_VALUE << std::endl;
 
-		rOstr << "\tCANARY_START  = " << canaryStart_;
-		if (canaryStart_ == CANARY_VALUE) NDebugger::Text(" TRUE ", rOstr, NDebugger::Colors::Green);
-		else                              NDebugger::Text(" FALSE", rOstr, NDebugger::Colors::Red);
+		rOstr << "\tCANARY_START  = " << cold_->canaryStart;
+		if (cold_->canaryStart == cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+		else                              NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 
-		rOstr << "\tCANARY_FINISH = " << canaryFinish_;
-		if (canaryFinish_ == CANARY_VALUE) NDebugger::Text(" TRUE ", rOstr, NDebugger::Colors::Green);
-		else                               NDebugger::Text(" FALSE", rOstr, NDebugger::Colors::Red);
+		rOstr << "\tCANARY_FINISH = " << cold_->canaryFinish;
+		if (cold_->canaryFinish == cold_->CANARY_VALUE) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+		else                               NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 	)
 
 	HASH_GUARD
 	(
-		rOstr << "\n\tHASH = " << hash_;
-		if (hash_ == makeHash()) NDebugger::Text(" TRUE ", rOstr, NDebugger::Colors::Green);
-		else                     NDebugger::Text(" FALSE", rOstr, NDebugger::Colors::Red);
+		rOstr << "\n\tHASH = " << cold_->hash;
+		if (std::string_view(cold_->hash) == makeHash()) NDebugger::Text(std::string_view(" TRUE "), rOstr, NDebugger::Colors::Green);
+		else                     NDebugger::Text(std::string_view(" FALSE"), rOstr, NDebugger::Colors::Red);
 	)
 
 	rOstr << "}\n[     END     ]\n\n";
 }
-*/
 
 #pragma endregion
 
 #pragma region FUNCTION_DEFINITION
 
-template<typename T, size_t SIZE>
-inline std::ostream& operator<<(std::ostream& rOstr, const Storage<T, SIZE> &crStorage)
+template<typename T, size_t SIZE, typename Derived>
+inline std::ostream& operator<<(std::ostream& rOstr, const Storage<T, SIZE, Derived> &crStorage)
 {
-	// crStorage.dump(rOstr);
+	crStorage.dump(rOstr);
 
 	return rOstr;
 }
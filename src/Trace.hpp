@@ -0,0 +1,444 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   Trace.hpp
+//!
+//! \brief	Binary instruction trace: writer used by the interpreter and reader used by the offline decoder
+//!
+//! \note   File: MAGIC, VERSION, value kind, opcode names, register names, then records.
+//!         Record: opcode, pc, nanoseconds since the previous record, number of operands, operands.
+//!         Operand: kind, then zigzag value, register index or label. All integers are LEB128 varints.
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#include <chrono>      // std::chrono::steady_clock
+#include <cstdint>     // uint64_t, int64_t
+#include <cstring>     // std::memcpy
+#include <fstream>     // std::ofstream, std::ifstream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <type_traits> // std::is_floating_point
+#include <vector>      // std::vector
+
+namespace NTrace
+{
+
+#pragma region CONSTANTS
+
+	constexpr std::string_view MAGIC       = "CPUTRC";
+	constexpr uint64_t         VERSION     = 1;
+	constexpr size_t           BUFFER_SIZE = 1 << 16;
+	constexpr size_t           MAX_VARINT  = 10;
+
+#pragma endregion
+
+#pragma region ENUMS
+
+	enum class ValueKind : unsigned char
+	{
+		Integer,
+		Floating
+	};
+
+	enum class ArgKind : unsigned char
+	{
+		Value,       // 5
+		Register,    // ax
+		RamRegister, // [ax]
+		RamValue,    // [5]
+		Label        // loop
+	};
+
+#pragma endregion
+
+#pragma region STRUCTS
+
+	struct Arg
+	{
+		ArgKind     kind;
+		int64_t     integer;  // Value of the integer programm or register index
+		double      floating; // Value of the floating programm
+		std::string label;
+	};
+
+	struct Event
+	{
+		unsigned         opcode;
+		uint64_t         pc;
+		uint64_t         time; // Nanoseconds since the trace was started
+		std::vector<Arg> args;
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	Appends val as a LEB128 varint
+//!
+//! \param  rOut  Where to append
+//! \param  val   Value
+//!
+//====================================================================================================================================
+
+	inline void PutVarint(std::string &rOut, uint64_t val);
+
+	inline uint64_t ZigZag(int64_t val) noexcept;
+
+	inline int64_t UnZigZag(uint64_t val) noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	Appends the operand, done once per instruction when the programm is loaded
+//!
+//! \param  rOut  Encoded operands of the instruction
+//! \param  kind  Kind of the operand
+//! \param  val   Value or register index
+//!
+//====================================================================================================================================
+
+	template<typename T>
+	void PutArg(std::string &rOut, ArgKind kind, T val);
+
+	inline void PutLabel(std::string &rOut, std::string_view label);
+
+#pragma endregion
+
+#pragma region CLASSES
+
+//====================================================================================================================================
+//!
+//! \brief	Buffers records and writes them to the file in big chunks
+//!
+//====================================================================================================================================
+
+	class Writer final
+	{
+	public:
+
+//====================================================================================================================================
+//!
+//! \brief	Opens the file and writes the header
+//!
+//! \param  path       Trace file
+//! \param  valueKind  How operand values are encoded
+//! \param  crOpcodes  Names of the opcodes, the index is the opcode
+//! \param  crRegs     Names of the registers, the index is the register
+//!
+//====================================================================================================================================
+
+		Writer(const std::string &path, ValueKind valueKind, const std::vector<std::string_view> &crOpcodes, const std::vector<std::string_view> &crRegs);
+		Writer(const Writer&) = delete;
+		Writer(Writer&&)      = delete;
+		~Writer();
+
+		Writer &operator=(const Writer&) = delete;
+		Writer &operator=(Writer&&)      = delete;
+
+		bool is_open() const;
+
+//====================================================================================================================================
+//!
+//! \brief	Appends the record, the file is written only when the buffer is full
+//!
+//! \param  opcode     Opcode of the instruction
+//! \param  pc         Position of the instruction
+//! \param  numOfArgs  Number of the operands
+//! \param  args       Operands encoded by PutArg
+//!
+//====================================================================================================================================
+
+		void write(unsigned opcode, uint64_t pc, unsigned char numOfArgs = 0, std::string_view args = "");
+
+		void flush();
+
+	private:
+		std::ofstream                         file_;
+		std::string                           buf_;
+		std::chrono::steady_clock::time_point last_;
+	};
+
+//====================================================================================================================================
+//!
+//! \brief	Reads the trace record by record
+//!
+//====================================================================================================================================
+
+	class Reader final
+	{
+	public:
+		explicit Reader(const std::string &path);
+
+//====================================================================================================================================
+//!
+//! \brief	 Checks that the file is open and has a valid header
+//!
+//! \return  Is the trace readable
+//!
+//====================================================================================================================================
+
+		bool ok() const;
+
+		bool next(Event &rEvent);
+
+		ValueKind valueKind() const noexcept;
+
+		std::string_view opcode(unsigned opcode) const noexcept;
+
+		std::string_view reg(size_t reg) const noexcept;
+
+	private:
+		std::ifstream            file_;
+		bool                     ok_;
+		ValueKind                valueKind_;
+		std::vector<std::string> opcodes_,
+		                         regs_;
+		uint64_t                 time_;
+
+		bool getVarint(uint64_t &rVal);
+		bool getString(std::string &rStr);
+		bool getNames(std::vector<std::string> &rNames);
+	};
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline void PutVarint(std::string &rOut, uint64_t val)
+	{
+		while (val >= 0x80)
+		{
+			rOut.push_back(static_cast<char>((val & 0x7f) | 0x80));
+			val >>= 7;
+		}
+
+		rOut.push_back(static_cast<char>(val));
+	}
+
+	inline uint64_t ZigZag(int64_t val) noexcept
+	{
+		return ((static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63));
+	}
+
+	inline int64_t UnZigZag(uint64_t val) noexcept
+	{
+		return static_cast<int64_t>((val >> 1) ^ (~(val & 1) + 1));
+	}
+
+	template<typename T>
+	void PutArg(std::string &rOut, ArgKind kind, T val)
+	{
+		rOut.push_back(static_cast<char>(kind));
+
+		if (kind == ArgKind::Register || kind == ArgKind::RamRegister)
+			PutVarint(rOut, static_cast<uint64_t>(val));
+
+		else if constexpr (std::is_floating_point<T>::value)
+		{
+			double   dbl  = static_cast<double>(val);
+			uint64_t bits = 0;
+			std::memcpy(&bits, &dbl, sizeof(bits));
+
+			PutVarint(rOut, bits);
+		}
+		else
+			PutVarint(rOut, ZigZag(static_cast<int64_t>(val)));
+	}
+
+	inline void PutLabel(std::string &rOut, std::string_view label)
+	{
+		rOut.push_back(static_cast<char>(ArgKind::Label));
+
+		PutVarint(rOut, label.length());
+		rOut.append(label);
+	}
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	inline Writer::Writer(const std::string &path, ValueKind valueKind, const std::vector<std::string_view> &crOpcodes, const std::vector<std::string_view> &crRegs) :
+		file_(path, std::ios::binary),
+		buf_(),
+		last_(std::chrono::steady_clock::now())
+	{
+		buf_.reserve(BUFFER_SIZE);
+
+		buf_.append(MAGIC);
+		PutVarint(buf_, VERSION);
+		buf_.push_back(static_cast<char>(valueKind));
+
+		for (auto &&names : { &crOpcodes, &crRegs })
+		{
+			PutVarint(buf_, names->size());
+			for (auto &&name : *names)
+			{
+				PutVarint(buf_, name.length());
+				buf_.append(name);
+			}
+		}
+	}
+
+	inline Writer::~Writer()
+	{
+		flush();
+	}
+
+	inline bool Writer::is_open() const
+	{
+		return file_.is_open();
+	}
+
+	inline void Writer::write(unsigned opcode, uint64_t pc, unsigned char numOfArgs /* = 0 */, std::string_view args /* = "" */)
+	{
+		auto now = std::chrono::steady_clock::now();
+
+		PutVarint(buf_, opcode);
+		PutVarint(buf_, pc);
+		PutVarint(buf_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count()));
+		buf_.push_back(static_cast<char>(numOfArgs));
+		buf_.append(args);
+
+		last_ = now;
+
+		if (buf_.size() >= BUFFER_SIZE - (MAX_VARINT << 2) - args.length())
+			flush();
+	}
+
+	inline void Writer::flush()
+	{
+		if (buf_.empty()) return;
+
+		file_.write(buf_.data(), buf_.size());
+		file_.flush();
+
+		buf_.clear();
+	}
+
+	inline Reader::Reader(const std::string &path) :
+		file_(path, std::ios::binary),
+		ok_(false),
+		valueKind_(ValueKind::Integer),
+		opcodes_(),
+		regs_(),
+		time_(NULL)
+	{
+		std::string magic(MAGIC.length(), '\0');
+		if (!file_.read(magic.data(), magic.length()) || magic != MAGIC) return;
+
+		uint64_t version = 0;
+		if (!getVarint(version) || version != VERSION) return;
+
+		char kind = 0;
+		if (!file_.get(kind)) return;
+		valueKind_ = static_cast<ValueKind>(kind);
+
+		ok_ = getNames(opcodes_) && getNames(regs_);
+	}
+
+	inline bool Reader::ok() const
+	{
+		return ok_;
+	}
+
+	inline bool Reader::next(Event &rEvent)
+	{
+		uint64_t opcode = 0,
+		         delta  = 0;
+		char     num    = 0;
+		if (!ok_ || !getVarint(opcode) || !getVarint(rEvent.pc) || !getVarint(delta) || !file_.get(num)) return false;
+
+		rEvent.opcode = static_cast<unsigned>(opcode);
+		rEvent.time   = (time_ += delta);
+		rEvent.args.resize(static_cast<unsigned char>(num));
+
+		for (auto &&arg : rEvent.args)
+		{
+			char kind = 0;
+			if (!file_.get(kind)) return false;
+
+			arg = { static_cast<ArgKind>(kind), 0, 0., "" };
+
+			uint64_t val = 0;
+			if (arg.kind == ArgKind::Label)
+			{
+				if (!getString(arg.label)) return false;
+			}
+			else if (!getVarint(val)) return false;
+
+			else if (arg.kind == ArgKind::Register || arg.kind == ArgKind::RamRegister)
+				arg.integer = static_cast<int64_t>(val);
+
+			else if (valueKind_ == ValueKind::Floating)
+				std::memcpy(&arg.floating, &val, sizeof(val));
+
+			else
+				arg.integer = UnZigZag(val);
+		}
+
+		return true;
+	}
+
+	inline ValueKind Reader::valueKind() const noexcept
+	{
+		return valueKind_;
+	}
+
+	inline std::string_view Reader::opcode(unsigned opcode) const noexcept
+	{
+		return (opcode < opcodes_.size() ? std::string_view(opcodes_[opcode]) : std::string_view("null"));
+	}
+
+	inline std::string_view Reader::reg(size_t reg) const noexcept
+	{
+		return (reg < regs_.size() ? std::string_view(regs_[reg]) : std::string_view("null"));
+	}
+
+	inline bool Reader::getVarint(uint64_t &rVal)
+	{
+		rVal = 0;
+		for (unsigned shift = 0; shift < (MAX_VARINT * 7); shift += 7)
+		{
+			char byte = 0;
+			if (!file_.get(byte)) return false;
+
+			rVal |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80)) return true;
+		}
+
+		return false;
+	}
+
+	inline bool Reader::getString(std::string &rStr)
+	{
+		uint64_t length = 0;
+		if (!getVarint(length)) return false;
+
+		rStr.resize(static_cast<size_t>(length));
+
+		return static_cast<bool>(file_.read(rStr.data(), rStr.length()));
+	}
+
+	inline bool Reader::getNames(std::vector<std::string> &rNames)
+	{
+		uint64_t num = 0;
+		if (!getVarint(num)) return false;
+
+		rNames.resize(static_cast<size_t>(num));
+		for (auto &&name : rNames)
+			if (!getString(name)) return false;
+
+		return true;
+	}
+
+#pragma endregion
+
+} // namespace NTrace
@@ -0,0 +1,81 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include <iomanip>  // std::setw
+#include <iostream> // std::cout, std::cerr
+#include <string>   // std::string
+
+#include "../Trace.hpp"
+
+//====================================================================================================================================
+//!
+//! \brief	Offline decoder of the binary trace written by Compiler<>::startTrace()
+//!
+//! \note   TraceDecoder <trace> [--csv]
+//!
+//====================================================================================================================================
+
+std::string ArgToString(const NTrace::Reader &crReader, const NTrace::Arg &crArg)
+{
+	std::string val;
+	if (crArg.kind == NTrace::ArgKind::Label)
+		return crArg.label;
+	else if (crArg.kind == NTrace::ArgKind::Register || crArg.kind == NTrace::ArgKind::RamRegister)
+		val = std::string(crReader.reg(static_cast<size_t>(crArg.integer)));
+	else if (crReader.valueKind() == NTrace::ValueKind::Floating)
+		val = std::to_string(crArg.floating);
+	else
+		val = std::to_string(crArg.integer);
+
+	if (crArg.kind == NTrace::ArgKind::RamRegister || crArg.kind == NTrace::ArgKind::RamValue)
+		return ("[" + val + "]");
+
+	return val;
+}
+
+int main(int argc, char *argv[])
+{
+	std::ios::sync_with_stdio(false);
+
+	if (argc < 2)
+	{
+		std::cerr << "Usage: TraceDecoder <trace> [--csv]\n";
+
+		return 1;
+	}
+
+	NTrace::Reader reader(argv[1]);
+	if (!reader.ok())
+	{
+		std::cerr << "Not a trace: " << argv[1] << '\n';
+
+		return 1;
+	}
+
+	bool csv = (argc >= 3 && std::string(argv[2]) == "--csv");
+	if (csv)
+		std::cout << "pc,time_ns,opcode,arg1,arg2,arg3\n";
+
+	std::streamsize width = 1 << 3;
+
+	NTrace::Event event = {};
+	while (reader.next(event))
+	{
+		if (csv)
+		{
+			std::cout << event.pc << ',' << event.time << ',' << reader.opcode(event.opcode);
+			for (size_t i = 0; i < 3; i++)
+				std::cout << ',' << (i < event.args.size() ? ArgToString(reader, event.args[i]) : "");
+		}
+		else
+		{ // Same look as Operation::dump()
+			std::cout << std::setw(width) << event.pc << ' ' << std::setw(width << 1) << event.time << "ns OP: " << std::setw(width) << reader.opcode(event.opcode);
+			for (size_t i = 0; i < event.args.size(); i++)
+				std::cout << ", ARG" << i + 1 << ": " << std::setw(width) << ArgToString(reader, event.args[i]);
+		}
+
+		std::cout << '\n';
+	}
+
+	return 0;
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>      // std::array
+#include <chrono>     // std::chrono::milliseconds
+#include <cassert>    // assert
+#include <filesystem> // std::filesystem::create_directory, std::filesystem::remove_all
+#include <fstream>    // std::ifstream, std::ofstream
+#include <iostream>   // std::cout
+#include <iterator>   // std::istreambuf_iterator
+#include <sstream>    // std::ostringstream
+#include <string>     // std::string
+#include <thread>     // std::this_thread::sleep_for
+
+#include "../Assembler.hpp"
+
+namespace NAssemblerTests
+{
+	void Atomic();
+	void Collected();
+	void Parallel();
+	void Chunked();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t ASSEMBLER_TEST_FUNC_NUM = 4;
+
+	constexpr std::array<test_func_t, ASSEMBLER_TEST_FUNC_NUM> ASSEMBLER_TEST_FUNC
+	{
+		Atomic,
+		Collected,
+		Parallel,
+		Chunked
+	};
+
+	constexpr const char *ASSEMBLER_TEST_DIR = "AssemblerTests";
+
+	std::string ReadAll(const std::filesystem::path &crPath)
+	{
+		std::ifstream file(crPath, std::ios::binary);
+
+		return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	}
+
+	void WriteAll(const std::filesystem::path &crPath, const std::string &crText)
+	{
+		std::ofstream file(crPath, std::ios::binary);
+		file << crText;
+	}
+
+	std::string Errors(NCompiler::Compiler<int> &rCompiler, const std::filesystem::path &crPath)
+	{ // Messages of the converters, they go to std::cerr
+		std::ostringstream errors;
+		auto *pOld = std::cerr.rdbuf(errors.rdbuf());
+
+		bool ok = rCompiler.text2com(crPath) && rCompiler.text2bin(crPath) && rCompiler.com2bin(crPath);
+
+		std::cerr.rdbuf(pOld);
+
+		return (ok ? "" : errors.str());
+	}
+
+	size_t CountFiles(const std::filesystem::path &crDir)
+	{
+		size_t count = 0;
+		for (auto &&entry : std::filesystem::directory_iterator(crDir))
+			count += entry.is_regular_file();
+
+		return count;
+	}
+
+	void RunAllTests()
+	{
+		float step     = 100.f / ASSEMBLER_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = ASSEMBLER_TEST_FUNC.cbegin(); it != ASSEMBLER_TEST_FUNC.cend(); ++it)
+		{
+			std::filesystem::remove_all(ASSEMBLER_TEST_DIR);
+			std::filesystem::create_directory(ASSEMBLER_TEST_DIR);
+
+			(*it)();
+
+			std::cout << '\r' << "Assembler tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::filesystem::remove_all(ASSEMBLER_TEST_DIR);
+
+		std::cout << std::endl;
+	}
+
+	void Atomic()
+	{
+		std::filesystem::path path = std::filesystem::path(ASSEMBLER_TEST_DIR) / "out.txt";
+		WriteAll(path, "old");
+
+		{
+			NAtomicFile::Output output(path);
+			assert(output.is_open());
+
+			output << "new " << 42;
+			assert(ReadAll(path) == "old"); // Not seen until committed
+		}
+		assert(ReadAll(path) == "old");
+		assert(CountFiles(ASSEMBLER_TEST_DIR) == 1); // The temporary is removed
+
+		NAtomicFile::Output output(path);
+		output << "new " << 42;
+		[[maybe_unused]] bool committed = output.commit();
+		assert(committed);
+
+		committed = output.commit();
+		assert(!committed);
+
+		assert(ReadAll(path) == "new 42");
+		assert(CountFiles(ASSEMBLER_TEST_DIR) == 1);
+	}
+
+	void Collected()
+	{
+		std::filesystem::path dir(ASSEMBLER_TEST_DIR);
+		for (auto &&name : { "a.txt", "aCom.txt", "aBinText.txt", "aBinCom.txt", "b.txt", "c.bin" })
+			WriteAll(dir / name, "end\n");
+
+		auto sources = NAssembler::Collect(dir, NAssembler::Mode::text2com);
+		assert(sources.size() == 2 && sources[0] == dir / "a" && sources[1] == dir / "b");
+
+		auto coms = NAssembler::Collect(dir, NAssembler::Mode::com2bin);
+		assert(coms.size() == 1 && coms[0] == dir / "a");
+
+		assert(NAssembler::Collect(dir / "b.txt", NAssembler::Mode::text2bin).front() == dir / "b");
+		assert(NAssembler::Collect(dir / "b",     NAssembler::Mode::text2bin).front() == dir / "b");
+	}
+
+	void Parallel()
+	{
+		std::filesystem::path dir(ASSEMBLER_TEST_DIR);
+
+		constexpr size_t FILES = 32;
+		for (size_t i = 0; i < FILES; i++)
+		{
+			std::string source = "push 0\n";
+			for (size_t j = 0; j <= i; j++)
+				source += ":loop" + std::to_string(j) + "\n    push " + std::to_string(j) + "\n    move 1, ax\n    cmp ax, 5\n    jb loop" + std::to_string(j) + "\n";
+			source += (i == FILES / 2 ? "    bad 1\nend\n" : "end\n");
+
+			WriteAll(dir / ("p" + std::to_string(i) + ".txt"), source);
+		}
+
+		NAssembler::Assembler<int> assembler(4);
+		auto files = NAssembler::Collect(dir, NAssembler::Mode::text2com);
+		assert(files.size() == FILES);
+
+		for (auto mode : { NAssembler::Mode::text2com, NAssembler::Mode::text2bin, NAssembler::Mode::com2bin })
+		{
+			auto results = assembler.run(files, mode);
+			assert(results.size() == FILES);
+
+			for (size_t i = 0; i < FILES; i++)
+				assert(results[i].path == files[i] && results[i].ok == (files[i] != dir / ("p" + std::to_string(FILES / 2))));
+		}
+
+		NCompiler::Compiler<int> compiler; // The files of the pool are the ones of the sequential converters
+		for (auto &&file : files)
+		{
+			std::string name = file.generic_string();
+			if (file == dir / ("p" + std::to_string(FILES / 2)))
+			{
+				assert(!std::filesystem::exists(name + "Com.txt") && !std::filesystem::exists(name + "BinText.txt"));
+
+				continue;
+			}
+
+			std::string com     = ReadAll(name + "Com.txt"),
+			            binText = ReadAll(name + "BinText.txt"),
+			            binCom  = ReadAll(name + "BinCom.txt");
+
+			[[maybe_unused]] bool converted = compiler.text2com(file) && compiler.text2bin(file) && compiler.com2bin(file);
+			assert(converted);
+			assert(com == ReadAll(name + "Com.txt") && binText == ReadAll(name + "BinText.txt") && binCom == ReadAll(name + "BinCom.txt"));
+		}
+	}
+
+	void Chunked()
+	{
+		std::filesystem::path path = std::filesystem::path(ASSEMBLER_TEST_DIR) / "big";
+		std::string           name = path.generic_string();
+
+		std::string source = "push 0\nmove 0, ax\njump start\n";
+		for (size_t i = 0; source.length() < 3 * NParser::MIN_CHUNK; i++) // Labels are used before and after the chunk of their own
+			source += ":l" + std::to_string(i) + "\n    push " + std::to_string(i % 100) + "\n    pop\n    jump n" + std::to_string(i) + "\n"
+			          "n" + std::to_string(i) + ":\n    move 1, bx\n";
+		source += ":start\n    push ax\n    push 1\n    add\n    pop ax\n    cmp ax, 3\n    jb l0\nend\n";
+		WriteAll(name + ".txt", source);
+
+		NCompiler::Compiler<int> sequential,
+		                         chunked;
+		chunked.setThreads(4);
+		assert(NParser::SplitSource(source, chunked.threads()).size() == 3);
+
+		std::string errors = Errors(sequential, path);
+		assert(errors.empty());
+
+		std::string com     = ReadAll(name + "Com.txt"),
+		            binText = ReadAll(name + "BinText.txt"),
+		            binCom  = ReadAll(name + "BinCom.txt");
+
+		errors = Errors(chunked, path);
+		assert(errors.empty());
+		assert(com == ReadAll(name + "Com.txt") && binText == ReadAll(name + "BinText.txt") && binCom == ReadAll(name + "BinCom.txt"));
+
+		[[maybe_unused]] bool loaded = sequential.fromTextFile(path) && chunked.fromTextFile(path);
+		assert(loaded);
+		assert(sequential.executed() == chunked.executed());
+
+		for (auto &&error : { std::string("bad 1\n"), std::string("push [1\n"), std::string("push 1x\n") })
+		{ // The first error of the source is reported, in the last chunk and in the middle one
+			for (size_t at : { source.length() - 4, source.find('\n', source.length() / 2) + 1 })
+			{
+				WriteAll(name + ".txt", source.substr(0, at) + error + source.substr(at) + "bad 2\n");
+
+				std::string expected = Errors(sequential, path);
+				errors = Errors(chunked, path);
+				assert(!expected.empty() && expected == errors);
+				assert(com == ReadAll(name + "Com.txt")); // The failed conversion leaves the old output
+			}
+		}
+	}
+
+} // namespace NAssemblerTests
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>      // std::array
+#include <chrono>     // std::chrono::milliseconds
+#include <cassert>    // assert
+#include <filesystem> // std::filesystem::remove_all
+#include <fstream>    // std::ofstream
+#include <iostream>   // std::cout
+#include <string>     // std::string
+#include <thread>     // std::this_thread::sleep_for
+
+#include "../Cache.hpp"
+#include "../Compiler.hpp"
+
+namespace NCacheTests
+{
+	void Digests();
+	void Entries();
+	void Evicted();
+	void Images();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t CACHE_TEST_FUNC_NUM = 4;
+
+	constexpr std::array<test_func_t, CACHE_TEST_FUNC_NUM> CACHE_TEST_FUNC
+	{
+		Digests,
+		Entries,
+		Evicted,
+		Images
+	};
+
+	constexpr const char *CACHE_TEST_DIR = "CacheTests";
+
+	size_t CountImages(const std::filesystem::path &crDir)
+	{
+		size_t count = 0;
+		for (auto &&entry : std::filesystem::directory_iterator(crDir))
+			count += (entry.path().extension() == NCache::EXTENSION);
+
+		return count;
+	}
+
+	void RunAllTests()
+	{
+		float step     = 100.f / CACHE_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = CACHE_TEST_FUNC.cbegin(); it != CACHE_TEST_FUNC.cend(); ++it)
+		{
+			std::filesystem::remove_all(CACHE_TEST_DIR);
+
+			(*it)();
+
+			std::cout << '\r' << "Cache tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::filesystem::remove_all(CACHE_TEST_DIR);
+
+		std::cout << std::endl;
+	}
+
+	void Digests()
+	{ // Test vectors of XXH64
+		assert(NCache::Digest("")    == 0xEF46DB3751D8E999ULL);
+		assert(NCache::Digest("a")   == 0xD24EC4F1A98C6E5BULL);
+		assert(NCache::Digest("abc") == 0x44BC2CF5AD770999ULL);
+		assert(NCache::Digest("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ULL);
+
+		assert(NCache::Digest("abc", 1) != NCache::Digest("abc"));
+	}
+
+	void Entries()
+	{
+		NCache::Cache cache(CACHE_TEST_DIR);
+		assert(cache.is_open());
+
+		std::string           image;
+		[[maybe_unused]] bool loaded = cache.load(1, image);
+		assert(!loaded && cache.misses() == 1);
+
+		std::string           stored("image\0with zeros", 16);
+		[[maybe_unused]] bool written = cache.store(1, stored);
+		assert(written);
+
+		loaded = cache.load(1, image);
+		assert(loaded && image == stored && cache.hits() == 1);
+
+		NCache::Cache other(CACHE_TEST_DIR); // Another process
+		loaded = other.load(1, image);
+		assert(loaded && image == stored);
+
+		for (auto &&entry : std::filesystem::directory_iterator(CACHE_TEST_DIR))
+		{
+			std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+			file.seekp(-1, std::ios::end);
+			file.put('!');
+		}
+		loaded = cache.load(1, image);
+		assert(!loaded); // Broken
+
+		loaded = cache.load(2, image);
+		assert(!loaded);
+
+		written = cache.store(1, stored);
+		assert(written);
+
+		for (auto &&entry : std::filesystem::directory_iterator(CACHE_TEST_DIR))
+			std::filesystem::resize_file(entry.path(), sizeof(NCache::Header) + 1);
+		loaded = cache.load(1, image);
+		assert(!loaded); // Truncated, the header is not trusted with the size
+	}
+
+	void Evicted()
+	{
+		const std::string image(1 << 10, 'x');
+
+		NCache::Cache cache(CACHE_TEST_DIR, 3 * (image.length() + sizeof(NCache::Header)));
+		for (uint64_t key = 1; key <= 3; key++)
+		{
+			[[maybe_unused]] bool written = cache.store(key, image);
+			assert(written);
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+		assert(CountImages(CACHE_TEST_DIR) == 3);
+
+		std::string           loaded;
+		[[maybe_unused]] bool hit = cache.load(1, loaded);
+		assert(hit); // 2 is the least recently used now
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		[[maybe_unused]] bool written = cache.store(4, image);
+		assert(written);
+		assert(CountImages(CACHE_TEST_DIR) == 3);
+
+		std::array<bool, 4> hits{};
+		for (uint64_t key = 1; key <= 4; key++)
+			hits[key - 1] = cache.load(key, loaded);
+		assert(hits[0] && !hits[1] && hits[2] && hits[3]);
+	}
+
+	void Images()
+	{
+		std::filesystem::create_directory(CACHE_TEST_DIR);
+
+		std::string path = std::string(CACHE_TEST_DIR) + "/programm";
+		{
+			std::ofstream file(path + ".txt");
+			file << "push 0\n"
+			        "move 0, ax\n"
+			        "push 30\n"
+			        ":loop\n"
+			        "    push 5\n"
+			        "    call fact\n"
+			        "    pop\n"
+			        "    push -1\n"
+			        "    add\n"
+			        "    dup\n"
+			        "    push 0\n"
+			        "    jb loop\n"
+			        "end\n"
+			        "fact:\n"
+			        "    dup\n"
+			        "    push 1\n"
+			        "    jae one\n"
+			        "    dup\n"
+			        "    push -1\n"
+			        "    add\n"
+			        "    call fact\n"
+			        "    mul\n"
+			        ":one\n"
+			        "    ret\n";
+		}
+
+		NCompiler::Compiler<int> plain;
+		[[maybe_unused]] bool    loaded = plain.fromTextFile(path);
+		assert(loaded);
+
+		NCompiler::Compiler<int> cached;
+		[[maybe_unused]] bool    started = cached.startCache(std::string(CACHE_TEST_DIR) + "/images");
+		assert(started);
+
+		loaded = cached.fromTextFile(path);
+		assert(loaded && cached.cache()->hits() == 0);
+
+		loaded = cached.fromTextFile(path);
+		assert(loaded && cached.cache()->hits() == 1);
+		assert(cached.executed() == plain.executed());
+
+		NCompiler::Compiler<double> other; // T is a part of the key
+		started = other.startCache(std::string(CACHE_TEST_DIR) + "/images");
+		assert(started);
+
+		loaded = other.fromTextFile(path);
+		assert(loaded && other.cache()->hits() == 0);
+
+		NCompiler::Compiler<int> next; // Image of the previous run, the labels come from it
+		started = next.startCache(std::string(CACHE_TEST_DIR) + "/images");
+		assert(started);
+
+		loaded = next.fromTextFile(path);
+		assert(loaded && next.cache()->hits() == 1);
+		assert(next.executed() == plain.executed());
+	}
+
+} // namespace NCacheTests
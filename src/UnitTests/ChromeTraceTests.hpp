@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
+#include <cassert>   // assert
+#include <cstdio>    // std::remove
+#include <fstream>   // std::ifstream
+#include <iostream>  // std::cout
+#include <iterator>  // std::istreambuf_iterator
+#include <string>    // std::string
+#include <thread>    // std::thread, std::this_thread::sleep_for
+
+#include "../ChromeTrace.hpp"
+
+namespace NChromeTraceTests
+{
+	void PutString();
+	void Spans();
+	void Threads();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t CHROME_TRACE_TEST_FUNC_NUM = 3;
+
+	constexpr std::array<test_func_t, CHROME_TRACE_TEST_FUNC_NUM> CHROME_TRACE_TEST_FUNC
+	{
+		PutString,
+		Spans,
+		Threads
+	};
+
+	constexpr const char *CHROME_TRACE_TEST_FILE = "ChromeTraceTests.json";
+
+	size_t Count(const std::string &crText, const std::string &crWhat)
+	{
+		size_t count = 0;
+		for (size_t pos = crText.find(crWhat); pos != std::string::npos; pos = crText.find(crWhat, pos + 1))
+			count++;
+
+		return count;
+	}
+
+	std::string ReadAll(const char *pPath)
+	{
+		std::ifstream file(pPath);
+
+		return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	}
+
+	void RunAllTests()
+	{
+		float step     = 100.f / CHROME_TRACE_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = CHROME_TRACE_TEST_FUNC.cbegin(); it != CHROME_TRACE_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Chrome trace tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::remove(CHROME_TRACE_TEST_FILE);
+
+		std::cout << std::endl;
+	}
+
+	void PutString()
+	{
+		std::string out;
+		NChromeTrace::PutString(out, "C:\\dir\\\"prog\"\n");
+		assert(out == "\"C:\\\\dir\\\\\\\"prog\\\" \"");
+
+		out.clear();
+		NChromeTrace::PutTime(out, 1234567);
+		assert(out == "1234.567");
+
+		out.clear();
+		NChromeTrace::PutTime(out, 5);
+		assert(out == "0.005");
+	}
+
+	void Spans()
+	{
+		{
+			NChromeTrace::Sink  sink(CHROME_TRACE_TEST_FILE);
+			NChromeTrace::Track track(sink, "main");
+			assert(sink.is_open());
+
+			{
+				NChromeTrace::Span run(&track, "fromTextFile", "run", "prog");
+				track.begin("fib", "call");
+				track.begin("fib", "call"); // Never returns
+				track.end();
+				assert(track.depth() == 2);
+			}
+			assert(track.depth() == 0);
+
+			track.end(); // Unbalanced ends are ignored
+			assert(track.depth() == 0);
+
+			NChromeTrace::Span none(nullptr, "nothing", "run");
+		}
+
+		std::string text = ReadAll(CHROME_TRACE_TEST_FILE);
+		assert(text.rfind("{\"traceEvents\":[", 0) == 0);
+		assert(text.substr(text.length() - 4) == "\n]}\n");
+		assert(Count(text, "\"ph\":\"B\"") == 3);
+		assert(Count(text, "\"ph\":\"E\"") == 3);
+		assert(Count(text, "\"args\":{\"detail\":\"prog\"}") == 1);
+		assert(Count(text, "nothing") == 0);
+	}
+
+	void Threads()
+	{
+		constexpr size_t THREADS = 4,
+		                 CALLS   = 10000; // Several flushes of every track
+
+		{
+			NChromeTrace::Sink sink(CHROME_TRACE_TEST_FILE);
+
+			std::array<std::thread, THREADS> threads;
+			for (auto &&thread : threads)
+				thread = std::thread([&sink]
+				{
+					NChromeTrace::Track track(sink, "worker");
+					for (size_t i = 0; i < CALLS; i++)
+					{
+						track.begin("f", "call");
+						track.end();
+					}
+				});
+
+			for (auto &&thread : threads)
+				thread.join();
+		}
+
+		std::string text = ReadAll(CHROME_TRACE_TEST_FILE);
+		assert(Count(text, "\"ph\":\"B\"") == THREADS * CALLS);
+		assert(Count(text, "\"ph\":\"E\"") == THREADS * CALLS);
+		for (size_t tid = 1; tid <= THREADS; tid++)
+			assert(Count(text, "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) + ",") == 1);
+	}
+}
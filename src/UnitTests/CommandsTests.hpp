@@ -0,0 +1,287 @@
+#pragma once
+
+#include <array>      // std::array
+#include <chrono>     // std::chrono::milliseconds
+#include <cassert>    // assert
+#include <filesystem> // std::filesystem::remove
+#include <fstream>    // std::ofstream
+#include <iostream>   // std::cout
+#include <string>     // std::string
+#include <thread>     // std::this_thread::sleep_for
+
+#include "../CPUCommands.hpp"
+#include "../Compiler.hpp"
+
+namespace NCommandsTests
+{
+	using namespace NCpu::Commands;
+
+	void Kinds();
+	void Specialized();
+	void Handlers();
+	void Lookup();
+	void FarCalls();
+	void UnknownLabel();
+	void SkipFunction();
+	void Reload();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t COMMANDS_TEST_FUNC_NUM = 8;
+
+	constexpr std::array<test_func_t, COMMANDS_TEST_FUNC_NUM> COMMANDS_TEST_FUNC
+	{
+		Kinds,
+		Specialized,
+		Handlers,
+		Lookup,
+		FarCalls,
+		UnknownLabel,
+		SkipFunction,
+		Reload
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / COMMANDS_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = COMMANDS_TEST_FUNC.cbegin(); it != COMMANDS_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Commands tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void Kinds()
+	{
+		assert(OperandKind("")     == Operand::none);
+		assert(OperandKind("42")   == Operand::imm);
+		assert(OperandKind("-0x1") == Operand::imm);
+		assert(OperandKind("ax")   == Operand::reg);
+		assert(OperandKind("[7]")  == Operand::mem_imm);
+		assert(OperandKind("[bx]") == Operand::mem_reg);
+		assert(OperandKind("[]")   == Operand::mem_imm);
+		assert(OperandKind("[x]")  == Operand::mem_imm); // Malformed, but RAM all the same
+		assert(OperandKind("loop") == Operand::label);
+	}
+
+	void Specialized()
+	{
+		assert(Specialize(Commands::push, Operand::imm,     Operand::none) == Opcode::push_imm);
+		assert(Specialize(Commands::push, Operand::reg,     Operand::none) == Opcode::push_reg);
+		assert(Specialize(Commands::push, Operand::mem_imm, Operand::none) == Opcode::push_mem_imm);
+		assert(Specialize(Commands::push, Operand::mem_reg, Operand::none) == Opcode::push_mem_reg);
+		assert(Specialize(Commands::push, Operand::label,   Operand::none) == Opcode::NUM);
+
+		assert(Specialize(Commands::pop, Operand::none,    Operand::none) == Opcode::pop);
+		assert(Specialize(Commands::pop, Operand::mem_reg, Operand::none) == Opcode::pop_mem);
+		assert(Specialize(Commands::pop, OperandKind("[]"), Operand::none) == Opcode::pop_mem); // Regression: pop [] popped the stack
+
+		assert(Specialize(Commands::cmp, Operand::reg, Operand::imm) == Opcode::cmp_reg_imm);
+		assert(Specialize(Commands::cmp, Operand::imm, Operand::reg) == Opcode::cmp_imm_reg);
+		assert(Specialize(Commands::cmp, Operand::reg, Operand::reg) == Opcode::cmp_reg_reg);
+		assert(Specialize(Commands::cmp, Operand::mem_imm, Operand::imm) == Opcode::NUM);
+
+		assert(Specialize(Commands::move, Operand::imm, Operand::reg) == Opcode::move_imm_reg);
+		assert(Specialize(Commands::move, Operand::reg, Operand::reg) == Opcode::move_reg_reg);
+		assert(Specialize(Commands::move, Operand::imm, Operand::imm) == Opcode::NUM);
+
+		assert(Specialize(Commands::jb,  Operand::label, Operand::none) == Opcode::jb);
+		assert(Specialize(Commands::end, Operand::none,  Operand::none) == Opcode::end);
+
+		for (size_t i = 0; i < static_cast<size_t>(Opcode::NUM); i++) // Generalize() reverses every opcode
+			assert(Generalize(static_cast<Opcode>(i)) != Commands::undefined);
+		assert(Generalize(Opcode::push_mem_reg) == Commands::push && Generalize(Opcode::pop_mem) == Commands::pop);
+		assert(Generalize(Opcode::cmp_imm_reg)  == Commands::cmp  && Generalize(Opcode::move_imm_reg) == Commands::move);
+		assert(Generalize(Opcode::NUM)          == Commands::undefined);
+
+		const std::string path = "CommandsTests"; // pop [] takes the RAM, the stack keeps its three values for the pops
+		{
+			std::ofstream file(path + ".txt");
+			file << "push 0\npush 1\npush 2\npush 3\npush [5]\npop []\npop\npop\npop\nend\n";
+		}
+
+		NCompiler::Compiler<int> comp;
+		[[maybe_unused]] bool loaded = comp.fromTextFile(path);
+		assert(loaded && comp.executed() == 10);
+
+		std::filesystem::remove(path + ".txt");
+	}
+
+	void Handlers()
+	{
+		NCpu::CPU<int> cpu;
+		cpu.push(0, NCpu::CPU<int>::MemoryStorage::STACK); // SP is read from the top after a pop
+
+		Operands<int> operands{ { 5, 0, 0 }, { REG::NUM, REG::AX, REG::NUM } };
+		[[maybe_unused]] Flow flow = CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::move_imm_reg)](cpu, operands);
+		assert(flow == Flow::next);
+
+		operands = { { 0, 7, 0 }, { REG::AX, REG::NUM, REG::NUM } };
+		CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::cmp_reg_imm)](cpu, operands);
+
+		auto pair = cpu.getPair();
+		assert(pair.first == 7 && pair.second == 5);
+
+		operands = { { 0, 0, 0 }, { REG::AX, REG::BX, REG::NUM } };
+		CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::move_reg_reg)](cpu, operands);
+		CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::cmp_reg_reg)](cpu, operands);
+
+		pair = cpu.getPair();
+		assert(pair.first == 5 && pair.second == 5);
+
+		flow = CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::jump)](cpu, operands);
+		assert(flow == Flow::jump);
+
+		flow = Execute(cpu, Opcode::jump, operands);
+		assert(flow == Flow::jump);
+
+		flow = Execute(cpu, Opcode::call, operands);
+		assert(flow == Flow::call);
+
+		flow = Execute(cpu, Opcode::ret, operands);
+		assert(flow == Flow::ret); // The address is left to the interpreter
+
+		flow = Execute(cpu, Opcode::end, operands);
+		assert(flow == Flow::next);
+
+		static_assert(CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::end)] == nullptr, "Built at compile time");
+		static_assert(CPU_OPCODES<int>::buf[static_cast<size_t>(Opcode::ret)] == &cpu_ret<int>, "Built at compile time");
+	}
+
+	void Lookup()
+	{
+		typedef CPU_COMMANDS table_t;
+
+		static_assert(table_t::names.find("jbe") == static_cast<size_t>(Commands::jbe), "Built at compile time");
+
+		for (auto &&com : table_t::buf)
+		{
+			assert(table_t::find(com.name)   == &com);
+			assert(table_t::find(com.number) == &com);
+		}
+
+		for (std::string_view name : { "", "pus", "pushx", "PUSH", "jb ", "ax", ":loop" })
+			assert(table_t::find(name) == table_t::cend());
+
+		assert(table_t::find(Commands::NUM)       == table_t::cend());
+		assert(table_t::find(Commands::undefined) == table_t::cend());
+	}
+
+	void FarCalls()
+	{ // Returns to the program counters 0 and 1, and from a function beyond the range of a short
+		const std::string path = "CommandsTests";
+		{
+			std::ofstream file(path + ".txt");
+			file << "call near\n"
+			        "call far\n"
+			        "end\n"
+			        "near:\n"
+			        "    ret\n";
+			for (size_t i = 0; i < 70000; i++)
+				file << "push " << i << '\n';
+			file << "far:\n"
+			        "    jump back\n"
+			        "    push 1\n"
+			        ":back\n"
+			        "    ret\n";
+		}
+
+		NCompiler::Compiler<int> comp;
+		[[maybe_unused]] bool loaded = comp.fromTextFile(path);
+		assert(loaded && comp.executed() == 6);
+
+		loaded = comp.text2com(path) && comp.fromComFile(path + "Com");
+		assert(loaded && comp.executed() == 6);
+
+		for (auto &&suffix : { ".txt", "Com.txt" })
+			std::filesystem::remove(path + suffix);
+	}
+
+	void UnknownLabel()
+	{ // Fails the load, as a jump to the start would loop forever
+		const std::string path = "CommandsTests";
+		{
+			std::ofstream file(path + ".txt");
+			file << "push 0\n"
+			        ":start\n"
+			        "jump nowhere\n"
+			        "end\n";
+		}
+
+		NCompiler::Compiler<int> comp;
+		[[maybe_unused]] bool loaded = comp.fromTextFile(path);
+		assert(!loaded && comp.executed() == 0);
+
+		std::filesystem::remove(path + ".txt");
+	}
+
+	void SkipFunction()
+	{ // A function met on the way is skipped past its ret, by the Com files too
+		const std::string path = "CommandsTests";
+		{
+			std::ofstream file(path + ".txt");
+			file << "push 0\n"
+			        "func:\n"
+			        "    push 1\n"
+			        ":inside\n"
+			        "    pop\n"
+			        "    ret\n"
+			        "push 2\n"
+			        "end\n"
+			        "push 3\n";
+		}
+
+		NCompiler::Compiler<int> comp;
+		[[maybe_unused]] bool loaded = comp.fromTextFile(path);
+		assert(loaded && comp.executed() == 3);
+
+		loaded = comp.text2com(path) && comp.fromComFile(path + "Com");
+		assert(loaded && comp.executed() == 3);
+
+		for (auto &&suffix : { ".txt", "Com.txt" })
+			std::filesystem::remove(path + suffix);
+	}
+
+	void Reload()
+	{ // Every load releases the memory of the previous one, so a reused compiler does not grow
+		const std::string path = "CommandsTests";
+		{
+			std::ofstream file(path + ".txt");
+			file << "push 0\n"
+			        "call func\n"
+			        "end\n"
+			        "func:\n";
+			for (size_t i = 0; i < 10000; i++)
+				file << ":label" << i << "\n"
+				        "    push " << i << "\n"
+				        "    pop\n";
+			file << "    ret\n";
+		}
+
+		NCompiler::Compiler<int> comp;
+		[[maybe_unused]] bool ran = comp.run();
+		assert(!ran);
+
+		[[maybe_unused]] bool loaded = comp.fromTextFile(path);
+		assert(loaded && comp.executed() == 20004);
+
+		ran = comp.run();
+		assert(ran && comp.executed() == 20004); // Runs it again without the load
+
+		size_t memory = comp.memory();
+		for (size_t i = 0; i < 25; i++)
+		{
+			loaded = comp.load(path) && comp.run();
+			assert(loaded && comp.executed() == 20004);
+		}
+		assert(comp.memory() == memory);
+
+		std::filesystem::remove(path + ".txt");
+	}
+
+} // namespace NCommandsTests
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
+#include <cassert>   // assert
+#include <iostream>  // std::cout
+#include <thread>    // std::this_thread::sleep_for
+
+#include "../Logger.hpp"
+
+namespace NLoggerTests
+{
+	void LevelFilter();
+	void SubsystemFilter();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t LOGGER_TEST_FUNC_NUM = 2;
+
+	constexpr std::array<test_func_t, LOGGER_TEST_FUNC_NUM> LOGGER_TEST_FUNC
+	{
+		LevelFilter,
+		SubsystemFilter
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / LOGGER_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = LOGGER_TEST_FUNC.cbegin(); it != LOGGER_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Logger tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void LevelFilter()
+	{ // Records below the level of the subsystem are dropped, the ones at and above it pass
+		Logger::setLevel(Logger::Subsystem::Stack, Logger::Level::Warning);
+
+		assert(!Logger::enabled(Logger::Level::Trace,   Logger::Subsystem::Stack));
+		assert(!Logger::enabled(Logger::Level::Info,    Logger::Subsystem::Stack));
+		assert( Logger::enabled(Logger::Level::Warning, Logger::Subsystem::Stack));
+		assert( Logger::enabled(Logger::Level::Error,   Logger::Subsystem::Stack));
+
+		Logger::setLevel(Logger::Subsystem::Stack, Logger::Level::Trace);
+		assert(Logger::enabled(Logger::Level::Trace, Logger::Subsystem::Stack));
+	}
+
+	void SubsystemFilter()
+	{ // A subsystem turned off drops even its errors, the others still pass
+		Logger::setLevel(Logger::Subsystem::CPU, Logger::Level::Off);
+
+		assert(!Logger::enabled(Logger::Level::Error, Logger::Subsystem::CPU));
+		assert( Logger::enabled(Logger::Level::Trace, Logger::Subsystem::Compiler));
+		assert( Logger::enabled(Logger::Level::Error, Logger::Subsystem::General));
+
+		int written = 0; // LOG_AT() finds the closest LOG_SUBSYSTEM, as in the classes which declare their own
+		{
+			constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::CPU;
+			LOG_AT(Error, written++)
+		}
+		{
+			constexpr NLog::Subsystem LOG_SUBSYSTEM = NLog::Subsystem::Compiler;
+			LOG_AT(Error, written++)
+		}
+		assert(written == (LOG_MIN_LEVEL <= 4 ? 1 : 0)); // Off at compile time drops both
+
+		Logger::setLevel(Logger::Subsystem::CPU, Logger::Level::Trace);
+	}
+
+} // namespace NLoggerTests
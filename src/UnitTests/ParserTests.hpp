@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm> // std::copy, std::count, std::min
+#include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
+#include <cassert>   // assert
+#include <iostream>  // std::cout
+#include <string>    // std::string
+#include <thread>    // std::this_thread::sleep_for
+
+#include "../Parser.hpp"
+
+namespace NParserTests
+{
+	void Classify();
+	void Tokens();
+	void LongLine();
+	void TooManyOperands();
+	void ParseLine();
+	void Values();
+	void MalformedValues();
+	void Chunks();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t PARSER_TEST_FUNC_NUM = 8;
+
+	constexpr std::array<test_func_t, PARSER_TEST_FUNC_NUM> PARSER_TEST_FUNC
+	{
+		Classify,
+		Tokens,
+		LongLine,
+		TooManyOperands,
+		ParseLine,
+		Values,
+		MalformedValues,
+		Chunks
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / PARSER_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = PARSER_TEST_FUNC.cbegin(); it != PARSER_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Parser tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void Classify()
+	{ // Every byte value in every position, the vectors must agree with the table
+		char block[NScanner::BLOCK] = { };
+		for (unsigned val = 0; val < 256; val++)
+			for (size_t pos = 0; pos < NScanner::BLOCK; pos++)
+			{
+				for (size_t i = 0; i < NScanner::BLOCK; i++)
+					block[i] = static_cast<char>((i * 7 + val) % 256);
+				block[pos] = static_cast<char>(val);
+
+				auto scalar = NScanner::ClassifyScalar(block),
+				     vector = NScanner::Classify(block);
+				assert(scalar.tokens == vector.tokens && scalar.newlines == vector.newlines);
+			}
+
+		std::string_view line = "mov ax,\t[bx]\r\n:l";
+		char text[NScanner::BLOCK] = { };
+		std::copy(line.begin(), line.end(), text);
+
+		auto masks = NScanner::Classify(text);
+		assert((masks.tokens & 0x3FFFF) == 0b11'1100'1111'0011'0111); // NUL bytes after the line are tokens too
+		assert(masks.newlines == 1 << 13);
+		assert(NScanner::FirstBit(masks.newlines) == 13);
+	}
+
+	void Tokens()
+	{
+		std::string_view source = "push 0\r\n\n  move 0, ax\n\t:loop\nmov ax,bx\n   \nend";
+
+		NParser::Lexer     lexer(source);
+		NParser::Statement statement{};
+
+		[[maybe_unused]] bool read = lexer.next(statement);
+		assert(read);
+		assert(statement.cmd == "push" && statement.args[0] == "0" && statement.args[1].empty());
+		assert(statement.line == 1 && statement.column == 1);
+
+		read = lexer.next(statement);
+		assert(read);
+		assert(statement.cmd == "move" && statement.args[0] == "0" && statement.args[1] == "ax");
+		assert(statement.line == 3 && statement.column == 3);
+
+		read = lexer.next(statement);
+		assert(read);
+		assert(statement.cmd == ":loop" && statement.args[0].empty());
+		assert(statement.line == 4 && statement.column == 2);
+
+		read = lexer.next(statement);
+		assert(read);
+		assert(statement.cmd == "mov" && statement.args[0] == "ax" && statement.args[1] == "bx");
+
+		read = lexer.next(statement);
+		assert(read);
+		assert(statement.cmd == "end" && statement.line == 7);
+
+		read = lexer.next(statement);
+		assert(!read);
+		assert(!lexer.failed() && lexer.error().empty());
+
+		// The tokens point into the source
+		assert(statement.cmd.data() == source.data() + source.length() - 3);
+	}
+
+	void LongLine()
+	{
+		std::string label(1 << 12, 'a'), // Longer than the old line buffer
+		            source = "call " + label + "\n" + label + ":\nret";
+
+		NParser::Lexer     lexer(source);
+		NParser::Statement statement{};
+
+		[[maybe_unused]] bool read = lexer.next(statement);
+		assert(read && statement.args[0] == label);
+		read = lexer.next(statement);
+		assert(read && statement.cmd.length() == label.length() + 1);
+		read = lexer.next(statement);
+		assert(read && statement.cmd == "ret" && statement.line == 3);
+	}
+
+	void TooManyOperands()
+	{
+		NParser::Lexer     lexer("push 1\n  add ax, bx, cx, dx\npush 2");
+		NParser::Statement statement{};
+
+		[[maybe_unused]] bool read = lexer.next(statement);
+		assert(read);
+		read = lexer.next(statement);
+		assert(!read);
+		assert(lexer.failed());
+		assert(lexer.error() == "Too many operands at line 2, column 19");
+
+		read = lexer.next(statement);
+		assert(!read); // Stops at the error
+	}
+
+	void ParseLine()
+	{
+		NParser::Operation op = NParser::ParseCode("  jb  loop, ");
+		assert(op.cmd == "jb" && op.args[0] == "loop" && op.args[1].empty());
+
+		op = NParser::ParseCode("");
+		assert(op.cmd.empty());
+
+		op = NParser::ParseCode("add ax, bx, cx, dx");
+		assert(op.cmd == "add" && op.args[2] == "cx");
+	}
+
+	void Values()
+	{
+		int    i = 0;
+		double d = 0.;
+
+		assert(NParser::ParseValue("42", i)    && i == 42);
+		assert(NParser::ParseValue("-7", i)    && i == -7);
+		assert(NParser::ParseValue("+3", i)    && i == 3);
+		assert(NParser::ParseValue("0x1F", i)  && i == 31);
+		assert(NParser::ParseValue("-0b101", i) && i == -5);
+		assert(NParser::ParseValue("[16]", i)  && i == 16);
+		assert(NParser::ParseValue("-2147483648", i) && i == -2147483647 - 1);
+
+		assert(NParser::ParseValue("0.000001", i) && i == 0); // Truncated as the stream did
+		assert(NParser::ParseValue("-2.9", i)     && i == -2);
+		assert(NParser::ParseValue("1e3", i)      && i == 1000);
+		assert(NParser::ParseValue(".5", i)       && i == 0); // IsImmediate() takes it, so it must parse
+		assert(NParser::ParseValue("-.9", i)      && i == 0);
+		assert(NParser::ParseValue("[.5]", i)     && i == 0);
+
+		assert(NParser::ParseValue("2.5", d)   && d == 2.5);
+		assert(NParser::ParseValue("-1e-6", d) && d == -1e-6);
+		assert(NParser::ParseValue("0x10", d)  && d == 16.);
+		assert(NParser::ParseValue(".5", d)    && d == .5);
+
+		assert(NParser::IsImmediate("-1") && NParser::IsImmediate("[0x10]") && NParser::IsImmediate(".5"));
+		assert(!NParser::IsImmediate("ax") && !NParser::IsImmediate("[bx]") && !NParser::IsImmediate("loop") && !NParser::IsImmediate(""));
+	}
+
+	void MalformedValues()
+	{
+		int           i = 7;
+		unsigned char u = 0;
+		double        d = 0.;
+
+		for (std::string_view str : { "", "-", "+", ".", "-.", ".e1", "12a", "1.2.3", "0x", "0xG", "0b2", "--1", "+-1", "1e", "0x1.5", "2147483648", "-2147483649", "1e10" })
+			assert(!NParser::ParseValue(str, i));
+		assert(i == 7); // Untouched on failure
+
+		assert(!NParser::ParseValue("256", u) && !NParser::ParseValue("-1", u));
+		assert(NParser::ParseValue("255", u) && u == 255);
+
+		assert(!NParser::ParseValue("1.5x", d) && !NParser::ParseValue("0b", d));
+	}
+
+	void Chunks()
+	{
+		std::string source;
+		for (size_t i = 0; source.length() < 3 * NParser::MIN_CHUNK + 100; i++)
+			source += "push " + std::to_string(i) + "\n";
+		source += "end"; // No newline at the end
+
+		for (size_t parts : { 1, 2, 3, 8 })
+		{
+			auto chunks = NParser::SplitSource(source, parts);
+			assert(chunks.size() == std::min<size_t>(parts, 3));
+
+			std::string joined;
+			size_t      line = 1;
+			for (auto &&chunk : chunks)
+			{
+				assert(!chunk.text.empty() && chunk.line == line);
+				assert(chunk.text.data() == source.data() + joined.length()); // Whole lines in order
+				assert(joined.empty() || joined.back() == '\n');
+
+				joined.append(chunk.text);
+				line += std::count(chunk.text.begin(), chunk.text.end(), '\n');
+			}
+			assert(joined == source);
+		}
+
+		assert(NParser::SplitSource("push 1\nend\n", 4).size() == 1);
+		assert(NParser::SplitSource("", 4).size() == 1);
+	}
+
+} // namespace NParserTests
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>      // std::array
+#include <chrono>     // std::chrono::milliseconds
+#include <cassert>    // assert
+#include <filesystem> // std::filesystem::path
+#include <iostream>   // std::cout
+#include <thread>     // std::this_thread::sleep_for
+
+#include "../Probes.hpp"
+
+namespace NProbesTests
+{
+	void RunIds();
+	void Scopes();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t PROBES_TEST_FUNC_NUM = 2;
+
+	constexpr std::array<test_func_t, PROBES_TEST_FUNC_NUM> PROBES_TEST_FUNC
+	{
+		RunIds,
+		Scopes
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / PROBES_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = PROBES_TEST_FUNC.cbegin(); it != PROBES_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Probes tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void RunIds()
+	{ // Unique in the process, so the probes of different VMs can be told apart
+		unsigned long long first  = NProbes::NextRunId(),
+		                   second = NProbes::NextRunId();
+		assert(first && second > first);
+	}
+
+	void Scopes()
+	{ // Fire their probes where sys/sdt.h is installed, are empty otherwise: both must build either way
+		std::filesystem::path path     = "ProbesTests";
+		size_t                executed = 0;
+		unsigned long long    id       = NProbes::NextRunId();
+		{
+			NProbes::Phase phase("load", path);
+			NProbes::Run   run(id, path, executed);
+
+			USDT(call, run.id(), executed, executed);
+			executed++;
+			USDT(ret, run.id(), executed, executed);
+
+			assert(run.id() == id);
+		}
+
+		assert(executed == 1);
+	}
+
+} // namespace NProbesTests
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>      // std::array
+#include <chrono>     // std::chrono::milliseconds
+#include <cassert>    // assert
+#include <filesystem> // std::filesystem::remove
+#include <fstream>    // std::ofstream
+#include <iostream>   // std::cout
+#include <map>        // std::map
+#include <sstream>    // std::ostringstream, std::istringstream
+#include <string>     // std::string
+#include <thread>     // std::this_thread::sleep_for
+
+#include "../Compiler.hpp"
+#include "../Profiler.hpp"
+
+namespace NProfilerTests
+{
+	void Opcodes();
+	void Folded();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t PROFILER_TEST_FUNC_NUM = 2;
+
+	constexpr std::array<test_func_t, PROFILER_TEST_FUNC_NUM> PROFILER_TEST_FUNC
+	{
+		Opcodes,
+		Folded
+	};
+
+	constexpr const char *PROFILER_TEST_PATH = "ProfilerTests";
+
+	void RunAllTests()
+	{
+		{ // main calls func twice, every func calls inner once
+			std::ofstream file(std::string(PROFILER_TEST_PATH) + ".txt");
+			file << "push 0\n"
+			        "call func\n"
+			        "call func\n"
+			        "end\n"
+			        "func:\n"
+			        "    push 1\n"
+			        "    add\n"
+			        "    call inner\n"
+			        "    ret\n"
+			        "inner:\n"
+			        "    push 2\n"
+			        "    pop\n"
+			        "    ret\n";
+		}
+
+		float step     = 100.f / PROFILER_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = PROFILER_TEST_FUNC.cbegin(); it != PROFILER_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Profiler tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::filesystem::remove(std::string(PROFILER_TEST_PATH) + ".txt");
+
+		std::cout << std::endl;
+	}
+
+	void Opcodes()
+	{ // Counts of the opcode report, the ticks differ from run to run
+		NCompiler::Compiler<int> comp;
+#if PROFILE_LVL >= 1
+		[[maybe_unused]] bool loaded = comp.startProfile() && comp.fromTextFile(PROFILER_TEST_PATH);
+		assert(loaded && comp.executed() == 18);
+
+		std::ostringstream report;
+		comp.reportProfile(report);
+
+		std::istringstream lines(report.str());
+		std::string        line;
+		std::getline(lines, line);
+		assert(line == "[PROFILE] Opcodes");
+		std::getline(lines, line); // Header
+
+		std::map<std::string, unsigned long long> counts;
+		while (std::getline(lines, line) && line.front() != '[')
+		{
+			std::istringstream columns(line);
+			std::string        opcode;
+			unsigned long long count = 0;
+			columns >> opcode >> count;
+
+			[[maybe_unused]] bool unique = counts.emplace(opcode, count).second;
+			assert(unique);
+		}
+
+		assert((counts == std::map<std::string, unsigned long long>{ { "push", 5 }, { "add", 2 }, { "pop", 2 }, { "call", 4 }, { "ret", 4 } }));
+		assert(line == "[PROFILE] Hottest instructions");
+#else
+		[[maybe_unused]] bool started = comp.startProfile();
+		assert(!started);
+#endif // PROFILE_LVL
+	}
+
+	void Folded()
+	{ // One line per stack with the instructions executed right in it, end is not counted
+		NCompiler::Compiler<int> comp;
+#if PROFILE_LVL >= 2
+		[[maybe_unused]] bool loaded = comp.startProfile() && comp.fromTextFile(PROFILER_TEST_PATH);
+		assert(loaded);
+
+		std::ostringstream folded;
+		comp.foldProfile(folded);
+		assert(folded.str() == "main 3\n"
+		                       "main;func 8\n"
+		                       "main;func;inner 6\n");
+#else
+		std::ostringstream folded;
+		comp.foldProfile(folded);
+		assert(folded.str().empty());
+#endif // PROFILE_LVL
+	}
+
+} // namespace NProfilerTests
@@ -3,10 +3,11 @@
 #pragma once
 
 #include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
 #include <iostream>  // std::cout
-#include <Windows.h> // SleepEx
+#include <thread>    // std::this_thread::sleep_for
 
-#include "..\Register.hpp"
+#include "../Register.hpp"
 
 using namespace NRegister;
 
@@ -14,15 +15,17 @@ namespace NRegisterTests
 {
 	void CopyMoveOperatorsAndConstructorsSwap();
 	void DumpOkLog();
+	void Names();
 
 	typedef void(*test_func_t)();
 
-	constexpr size_t REGISTER_TEST_FUNC_NUM = 2;
+	constexpr size_t REGISTER_TEST_FUNC_NUM = 3;
 
 	constexpr std::array<test_func_t, REGISTER_TEST_FUNC_NUM> REGISTER_TEST_FUNC
 	{
 		CopyMoveOperatorsAndConstructorsSwap,
-		DumpOkLog
+		DumpOkLog,
+		Names
 	};
 
 	void RunAllTests()
@@ -34,7 +37,7 @@ namespace NRegisterTests
 			(*it)();
 
 			std::cout << '\r' << "Register tests complete progress: " << (progress += step) << '%';
-			SleepEx(500, false);
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
 		}
 
 		std::cout << std::endl;
@@ -63,4 +66,18 @@ namespace NRegisterTests
 		l << a;
 	}
 
+	void Names()
+	{
+		for (size_t reg = 0; reg < static_cast<size_t>(REG::NUM); reg++)
+		{
+			std::string name(REG_NAMES[reg]);
+
+			assert(MakeReg(name)             == static_cast<REG>(reg));
+			assert(MakeReg("[" + name + "]") == static_cast<REG>(reg));
+		}
+
+		for (std::string_view name : { "", "a", "axx", "AX", "[ax", "ax]", "[]", "[[ax]]", "0" })
+			assert(MakeReg(name) == REG::NUM && !IsReg(name));
+	}
+
 } // namespace NStackTests
\ No newline at end of file
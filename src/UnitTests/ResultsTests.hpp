@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
+#include <cassert>   // assert
+#include <cmath>     // std::fabs
+#include <iostream>  // std::cout
+#include <sstream>   // std::stringstream
+#include <thread>    // std::this_thread::sleep_for
+
+#include "../Benchmarks/BenchmarkResults.hpp"
+
+namespace NResultsTests
+{
+	void Percentile();
+	void MannWhitney();
+	void RoundTrip();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t RESULTS_TEST_FUNC_NUM = 3;
+
+	constexpr std::array<test_func_t, RESULTS_TEST_FUNC_NUM> RESULTS_TEST_FUNC
+	{
+		Percentile,
+		MannWhitney,
+		RoundTrip
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / RESULTS_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = RESULTS_TEST_FUNC.cbegin(); it != RESULTS_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Results tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void Percentile()
+	{
+		assert(NBenchmarks::Percentile({}, 50.) == 0.);
+		assert(NBenchmarks::Percentile({ 3., 1., 2. }, 50.)  == 2.);
+		assert(NBenchmarks::Percentile({ 3., 1., 2. }, 99.)  == 3.);
+		assert(NBenchmarks::Percentile({ 3., 1., 2. }, 0.)   == 1.);
+		assert(NBenchmarks::Percentile({ 4., 1., 3., 2. }, 50.) == 2.);
+	}
+
+	void MannWhitney()
+	{
+		std::vector<double> fast = { 1., 2., 3., 4., 5. },
+		                    slow = { 6., 7., 8., 9., 10. };
+
+		// Every slow run is slower, 1 of C(10, 5) orderings
+		assert(std::fabs(NBenchmarks::MannWhitney(fast, slow) - 1. / 252.) < 1e-12);
+		assert(std::fabs(NBenchmarks::MannWhitney(slow, fast) - 1.)        < 1e-12);
+
+		std::vector<double> mixed = { 1.5, 2.5, 3.5, 4.5, 5.5 };
+		assert(NBenchmarks::MannWhitney(fast, mixed) > .05);
+
+		// The normal approximation must agree with the exact test in direction
+		std::vector<double> bigFast, bigSlow;
+		for (size_t i = 0; i < 40; i++)
+		{
+			bigFast.push_back(static_cast<double>(i));
+			bigSlow.push_back(static_cast<double>(i) + 20.);
+		}
+		assert(NBenchmarks::MannWhitney(bigFast, bigSlow) < .05);
+		assert(NBenchmarks::MannWhitney(bigSlow, bigFast) > .95);
+	}
+
+	void RoundTrip()
+	{
+		std::vector<NBenchmarks::Result> results(2);
+		results[0] = { "Fibbonachi", "fromTextFile", "int",    0, 221498, { 1000.5, 2000., 1500. } };
+		results[1] = { "Numeric",    "fromComFile",  "double", 3, 360004, { 7. } };
+
+		std::stringstream stream;
+		NBenchmarks::WriteJson(stream, results);
+
+		std::vector<NBenchmarks::Result> read;
+		[[maybe_unused]] bool            ok = NBenchmarks::ReadJson(stream, read);
+		assert(ok && read.size() == results.size());
+		for (size_t i = 0; i < read.size(); i++)
+		{
+			assert(read[i].name()        == results[i].name());
+			assert(read[i].guardLevel    == results[i].guardLevel);
+			assert(read[i].instructions  == results[i].instructions);
+			assert(read[i].runs          == results[i].runs);
+		}
+
+		std::stringstream broken("{ \"version\": 1, \"results\": [ { \"program\": ");
+		std::vector<NBenchmarks::Result> none;
+		ok = NBenchmarks::ReadJson(broken, none);
+		assert(!ok);
+
+		std::stringstream extra("{ \"results\": [ { \"program\": \"a\", \"note\": { \"x\": [true, null] }, \"runs_ns\": [1] } ], \"host\": \"b\" }");
+		ok = NBenchmarks::ReadJson(extra, none);
+		assert(ok && none.size() == 1 && none[0].runs.size() == 1);
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
+#include <cassert>   // assert
+#include <iostream>  // std::cout
+#include <memory>    // std::make_unique
+#include <thread>    // std::thread, std::this_thread::sleep_for
+
+#include "../AsyncLog.hpp"
+
+namespace NRingBufferTests
+{
+	void PushPopOrder();
+	void FullEmpty();
+	void ProducerConsumer();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t RING_BUFFER_TEST_FUNC_NUM = 3;
+
+	constexpr std::array<test_func_t, RING_BUFFER_TEST_FUNC_NUM> RING_BUFFER_TEST_FUNC
+	{
+		PushPopOrder,
+		FullEmpty,
+		ProducerConsumer
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / RING_BUFFER_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = RING_BUFFER_TEST_FUNC.cbegin(); it != RING_BUFFER_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "RingBuffer tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void PushPopOrder()
+	{
+		NLog::RingBuffer<int, 8> ring;
+		for (int i = 0; i < 5; ++i)
+		{
+			[[maybe_unused]] bool pushed = ring.push([&](int &rVal) { rVal = i; });
+			assert(pushed);
+		}
+
+		int val = 0;
+		for (int i = 0; i < 5; ++i)
+		{
+			[[maybe_unused]] bool popped = ring.pop(val);
+			assert(popped && val == i);
+		}
+	}
+
+	void FullEmpty()
+	{
+		NLog::RingBuffer<int, 4> ring;
+		assert(ring.empty());
+
+		int                   val    = 0;
+		[[maybe_unused]] bool popped = ring.pop(val);
+		assert(!popped);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			[[maybe_unused]] bool pushed = ring.push([&](int &rVal) { rVal = i; });
+			assert(pushed);
+		}
+
+		[[maybe_unused]] bool pushed = ring.push([&](int &rVal) { rVal = -1; });
+		assert(!pushed);
+
+		popped = ring.pop(val);
+		assert(popped && val == 0);
+
+		pushed = ring.push([&](int &rVal) { rVal = 4; });
+		assert(pushed); // Wraps around
+	}
+
+	void ProducerConsumer()
+	{
+		constexpr int NUM = 1 << 16;
+
+		auto pRing = std::make_unique<NLog::RingBuffer<int, 64>>();
+		std::thread producer([&]
+		{
+			for (int i = 0; i < NUM; ++i)
+				while (!pRing->push([&](int &rVal) { rVal = i; }));
+		});
+
+		int val      = 0,
+			expected = 0;
+		while (expected < NUM)
+			if (pRing->pop(val))
+			{
+				assert(val == expected);
+				expected++;
+			}
+
+		producer.join();
+		assert(pRing->empty());
+	}
+
+} // namespace NRingBufferTests
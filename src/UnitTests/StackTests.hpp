@@ -1,8 +1,10 @@
 #pragma once
 
-#include <array> // std::array
+#include <array>  // std::array
+#include <chrono> // std::chrono::milliseconds
+#include <thread> // std::this_thread::sleep_for
 
-#include "..\Stack.hpp"
+#include "../Stack.hpp"
 
 using namespace NStack;
 
@@ -10,16 +12,22 @@ namespace NStackTests
 {
 	void CopyMoveOperatorsAndConstructorsSwap();
 	void PushPopTopSize();
+	void InlineReserve();
+	void GrowthKeepsAddresses();
+	void OverflowShrink();
 	void DumpOkLog();
 
 	typedef void(*test_func_t)();
 
-	constexpr size_t STACK_TEST_FUNC_NUM = 3;
+	constexpr size_t STACK_TEST_FUNC_NUM = 6;
 
 	constexpr std::array<test_func_t, STACK_TEST_FUNC_NUM> STACK_TEST_FUNC
 	{
 		CopyMoveOperatorsAndConstructorsSwap,
 		PushPopTopSize,
+		InlineReserve,
+		GrowthKeepsAddresses,
+		OverflowShrink,
 		DumpOkLog
 	};
 
@@ -32,7 +40,7 @@ namespace NStackTests
 			(*it)();
 
 			std::cout << '\r' << "Stack tests complete progress: " << (progress += step) << '%';
-			SleepEx(500, false);
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
 		}
 
 		std::cout << std::endl;
@@ -62,6 +70,99 @@ namespace NStackTests
 		assert(a.top() == 7);
 	}
 
+	void InlineReserve()
+	{
+		Stack<int, 8> a;
+		for (int i = 0; i < 7; ++i)
+			a.push(i);
+
+		assert(a.capacity() == 8);
+
+		a.reserve(1 << 10);
+		assert(a.capacity() > (1 << 10) && a.top() == 6);
+
+		Stack<int, 8> b(1 << 10);
+		assert(b.capacity() > (1 << 10));
+
+		Stack<int, 8> c(8, 1 << 12); // Reserve past the limit is refused, not clamped
+		c.push(42);
+
+		bool overflow = false;
+		try
+		{
+			c.reserve((1 << 12) + 1);
+		}
+		catch (const std::overflow_error&)
+		{
+			overflow = true;
+		}
+		assert(overflow && c.top() == 42);
+
+		c.reserve(1 << 12);
+		assert(c.capacity() > (1 << 12) && c.top() == 42);
+
+		Stack<int, 8> d(1 << 20, 1 << 12); // The expected depth of the constructor is a hint, it is clamped
+		assert(d.capacity() > (1 << 12));
+	}
+
+	void GrowthKeepsAddresses()
+	{
+		Stack<> a(DEFAULT_INLINE_SIZE);
+		a.push(1);
+
+		const int *pFirst = &a.top();
+		for (int i = 0; i < (1 << 16); ++i)
+			a.push(i);
+
+		while (a.size() != 1)
+			a.pop();
+
+		assert(&a.top() == pFirst);
+	}
+
+	void OverflowShrink()
+	{
+		Stack<> a(1, 1 << 12);
+
+		bool overflow = false;
+		try
+		{
+			for (int i = 0; i <= (1 << 12); ++i)
+				a.push(i);
+		}
+		catch (const std::overflow_error&)
+		{
+			overflow = true;
+		}
+
+		assert(overflow && a.size() == a.limit());
+
+		size_t spike = a.capacity();
+		while (!a.empty())
+			a.pop();
+
+		assert(a.capacity() < spike);
+
+		Stack<> b; // Memory past the reservation is returned, the reserved one is kept
+		b.reserve(1 << 16);
+
+		size_t reserved = b.capacity();
+		b.push(1);
+		b.push(2);
+		b.pop();
+		b.pop();
+		assert(b.capacity() == reserved);
+
+		for (int i = 0; i < (1 << 18); ++i)
+			b.push(i);
+
+		spike = b.capacity();
+		while (!b.empty())
+			b.pop();
+
+		assert(b.capacity() < spike && b.capacity() >= reserved);
+	}
+
 	void DumpOkLog()
 	{
 		Stack<> a;
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>      // std::array
+#include <chrono>     // std::chrono::milliseconds
+#include <cassert>    // assert
+#include <filesystem> // std::filesystem::remove
+#include <fstream>    // std::ofstream
+#include <iostream>   // std::cout
+#include <string>     // std::string
+#include <thread>     // std::this_thread::sleep_for
+
+#include "../Compiler.hpp"
+#include "../Stats.hpp"
+
+namespace NStatsTests
+{
+	void Counters();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t STATS_TEST_FUNC_NUM = 1;
+
+	constexpr std::array<test_func_t, STATS_TEST_FUNC_NUM> STATS_TEST_FUNC
+	{
+		Counters
+	};
+
+	void RunAllTests()
+	{
+		float step     = 100.f / STATS_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = STATS_TEST_FUNC.cbegin(); it != STATS_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Stats tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::cout << std::endl;
+	}
+
+	void Counters()
+	{ // Two branches taken and one not, two calls of a function with an add
+		const std::string path = "StatsTests";
+		{
+			std::ofstream file(path + ".txt");
+			file << "push 0\n"
+			        "push 1\n"
+			        "push 1\n"
+			        "je equal\n"
+			        "push 5\n"
+			        ":equal\n"
+			        "push 1\n"
+			        "push 2\n"
+			        "je never\n"
+			        "call func\n"
+			        "call func\n"
+			        "jump done\n"
+			        "push 7\n"
+			        ":done\n"
+			        "end\n"
+			        "func:\n"
+			        "    push 3\n"
+			        "    add\n"
+			        "    ret\n"
+			        ":never\n"
+			        "end\n";
+		}
+
+		NCompiler::Compiler<int> comp;
+		[[maybe_unused]] bool loaded = comp.fromTextFile(path);
+		assert(loaded && comp.executed() == 17);
+
+		NStats::Stats stats = comp.stats();
+		if constexpr (NStats::ENABLED)
+		{
+			assert(stats.retired          == 17);
+			assert(stats.arithmetic       == 2);
+			assert(stats.branchesTaken    == 2);
+			assert(stats.branchesNotTaken == 1);
+			assert(stats.calls            == 2);
+			assert(stats.stackHighWater   >= 3);
+		}
+		else
+			assert(!stats.retired && !stats.branchesTaken && !stats.branchesNotTaken && !stats.calls);
+
+		std::filesystem::remove(path + ".txt");
+	}
+
+} // namespace NStatsTests
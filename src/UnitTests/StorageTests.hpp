@@ -1,25 +1,28 @@
 #pragma once
 
 #include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
 #include <iostream>  // std::cout
-#include <Windows.h> // SleepEx
+#include <thread>    // std::this_thread::sleep_for
 
-#include "..\Storage.hpp"
+#include "../Storage.hpp"
 
 namespace NStorageTests
 {
 	void CopyMoveOperatorsAndConstructorsSwap();
 	void AtSize();
+	void GetInRange();
 	void DumpOkOut();
 
 	typedef void(*test_func_t)();
 
-	constexpr size_t STORAGE_TEST_FUNC_NUM = 3;
+	constexpr size_t STORAGE_TEST_FUNC_NUM = 4;
 
 	constexpr std::array<test_func_t, STORAGE_TEST_FUNC_NUM> STORAGE_TEST_FUNC
 	{
 		CopyMoveOperatorsAndConstructorsSwap,
 		AtSize,
+		GetInRange,
 		DumpOkOut
 	};
 
@@ -32,7 +35,7 @@ namespace NStorageTests
 			(*it)();
 
 			std::cout << '\r' << "Storage tests complete progress: " << (progress += step) << '%';
-			SleepEx(500, false);
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
 		}
 
 		std::cout << std::endl;
@@ -58,6 +61,26 @@ namespace NStorageTests
 		assert(a.size() == 5);
 	}
 
+	void GetInRange()
+	{
+		Storage<int, 5> a;
+		a.get(2) = 7;
+		assert(a[2] == 7);
+
+		assert(a.inRange(4) && !a.inRange(5));
+
+		bool thrown = false;
+		try
+		{
+			a[5] = 1;
+		}
+		catch (const std::out_of_range&)
+		{
+			thrown = true;
+		}
+		assert(thrown);
+	}
+
 	void DumpOkOut()
 	{
 		Storage<int, 5> a;
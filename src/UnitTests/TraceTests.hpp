@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>     // std::array
+#include <chrono>    // std::chrono::milliseconds
+#include <cassert>   // assert
+#include <cstdio>    // std::remove
+#include <iostream>  // std::cout
+#include <thread>    // std::this_thread::sleep_for
+
+#include "../Trace.hpp"
+
+namespace NTraceTests
+{
+	void ZigZag();
+	void RoundTrip();
+	void BadFile();
+
+	typedef void(*test_func_t)();
+
+	constexpr size_t TRACE_TEST_FUNC_NUM = 3;
+
+	constexpr std::array<test_func_t, TRACE_TEST_FUNC_NUM> TRACE_TEST_FUNC
+	{
+		ZigZag,
+		RoundTrip,
+		BadFile
+	};
+
+	constexpr const char *TRACE_TEST_FILE = "TraceTests.trc";
+
+	void RunAllTests()
+	{
+		float step     = 100.f / TRACE_TEST_FUNC_NUM,
+			  progress = 0;
+		for (auto it = TRACE_TEST_FUNC.cbegin(); it != TRACE_TEST_FUNC.cend(); ++it)
+		{
+			(*it)();
+
+			std::cout << '\r' << "Trace tests complete progress: " << (progress += step) << '%';
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		}
+
+		std::remove(TRACE_TEST_FILE);
+
+		std::cout << std::endl;
+	}
+
+	void ZigZag()
+	{
+		for (int64_t val : { 0LL, 1LL, -1LL, 63LL, -64LL, 1LL << 40, -(1LL << 62) })
+			assert(NTrace::UnZigZag(NTrace::ZigZag(val)) == val);
+
+		assert(NTrace::ZigZag(-1) == 1);
+		assert(NTrace::ZigZag(1)  == 2);
+
+		std::string buf;
+		NTrace::PutVarint(buf, 127);
+		assert(buf.length() == 1);
+
+		NTrace::PutVarint(buf, 128);
+		assert(buf.length() == 3);
+	}
+
+	void RoundTrip()
+	{
+		{
+			std::string args;
+			NTrace::PutArg(args, NTrace::ArgKind::Value,       -5);
+			NTrace::PutArg(args, NTrace::ArgKind::RamRegister, 2);
+			NTrace::PutLabel(args, "loop");
+
+			NTrace::Writer writer(TRACE_TEST_FILE, NTrace::ValueKind::Integer, { "push", "jump" }, { "AX", "BX", "CX" });
+			assert(writer.is_open());
+
+			for (uint64_t pc = 0; pc < 1 << 12; ++pc) // Crosses the buffer several times
+				writer.write(0, pc, 3, args);
+			writer.write(1, 7);
+		}
+
+		NTrace::Reader reader(TRACE_TEST_FILE);
+		assert(reader.ok());
+		assert(reader.opcode(1) == "jump");
+		assert(reader.reg(2)    == "CX");
+
+		NTrace::Event event = {};
+		uint64_t      time  = 0;
+		for (uint64_t pc = 0; pc < 1 << 12; ++pc)
+		{
+			[[maybe_unused]] bool read = reader.next(event);
+			assert(read);
+			assert(event.opcode == 0 && event.pc == pc && event.time >= time);
+			assert(event.args.size() == 3);
+			assert(event.args[0].kind == NTrace::ArgKind::Value       && event.args[0].integer == -5);
+			assert(event.args[1].kind == NTrace::ArgKind::RamRegister && event.args[1].integer == 2);
+			assert(event.args[2].kind == NTrace::ArgKind::Label       && event.args[2].label   == "loop");
+
+			time = event.time;
+		}
+
+		[[maybe_unused]] bool read = reader.next(event);
+		assert(read && event.opcode == 1 && event.pc == 7 && event.args.empty());
+
+		read = reader.next(event);
+		assert(!read);
+	}
+
+	void BadFile()
+	{
+		{
+			std::ofstream file(TRACE_TEST_FILE, std::ios::binary);
+			file << "NOTATRACE";
+		}
+
+		NTrace::Reader reader(TRACE_TEST_FILE);
+		assert(!reader.ok());
+
+		NTrace::Event         event = {};
+		[[maybe_unused]] bool read  = reader.next(event);
+		assert(!read);
+	}
+}
@@ -3,11 +3,35 @@
 #include "StackTests.hpp"
 #include "StorageTests.hpp"
 #include "RegisterTests.hpp"
+#include "RingBufferTests.hpp"
+#include "LoggerTests.hpp"
+#include "TraceTests.hpp"
+#include "ResultsTests.hpp"
+#include "ChromeTraceTests.hpp"
+#include "ParserTests.hpp"
+#include "CommandsTests.hpp"
+#include "AssemblerTests.hpp"
+#include "CacheTests.hpp"
+#include "StatsTests.hpp"
+#include "ProfilerTests.hpp"
+#include "ProbesTests.hpp"
 
 void RunTestsAutomatic()
 {
 	NStackTests::RunAllTests();
 	NStorageTests::RunAllTests();
 	NRegisterTests::RunAllTests();
+	NRingBufferTests::RunAllTests();
+	NLoggerTests::RunAllTests();
+	NTraceTests::RunAllTests();
+	NResultsTests::RunAllTests();
+	NChromeTraceTests::RunAllTests();
+	NParserTests::RunAllTests();
+	NCommandsTests::RunAllTests();
+	NAssemblerTests::RunAllTests();
+	NCacheTests::RunAllTests();
+	NStatsTests::RunAllTests();
+	NProfilerTests::RunAllTests();
+	NProbesTests::RunAllTests();
 }
 
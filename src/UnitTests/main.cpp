@@ -1,9 +1,14 @@
+#define STATS_LVL   1 // The counters of the CPU are tested
+#define PROFILE_LVL 2 // The opcode report and the folded stacks are tested
+
 #include "UnitTests.hpp"
 
 int main()
 {
 	RunTestsAutomatic();
 
+#ifdef _WIN32
 	system("pause");
+#endif // _WIN32
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,331 @@
+#pragma once
+
+//====================================================================================================================================
+//!
+//!	\file   VirtualBuffer.hpp
+//!
+//! \brief	Buffer that reserves address space up front and commits pages on demand
+//!
+//====================================================================================================================================
+
+#ifndef __cplusplus
+	#error
+	#error  Must use C++ to compile.
+	#error
+#endif /* __cplusplus */
+
+#ifdef _WIN32
+	#include <Windows.h>  // VirtualAlloc, VirtualFree, GetSystemInfo
+#else
+	#include <sys/mman.h> // mmap, mprotect, madvise, munmap
+	#include <unistd.h>   // sysconf
+#endif // _WIN32
+
+#include <new>         // std::bad_alloc
+#include <cassert>     // assert
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::swap
+
+namespace NMemory
+{
+
+#pragma region FUNCTION_DECLARATION
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns the size of the virtual memory page
+//!
+//! \return  Page size in bytes
+//!
+//====================================================================================================================================
+
+	inline size_t GetPageSize() noexcept;
+
+#pragma endregion
+
+#pragma region CLASSES
+
+	template<typename T>
+	class VirtualBuffer final
+	{
+	public:
+
+//====================================================================================================================================
+//!
+//! \brief	Reserves address space for maxSize elements, nothing is committed
+//!
+//! \param  maxSize  Maximum number of elements the buffer may ever hold
+//!
+//====================================================================================================================================
+
+		explicit VirtualBuffer(size_t maxSize = 0) noexcept;
+		VirtualBuffer(const VirtualBuffer&) = delete;
+		VirtualBuffer(VirtualBuffer&&)      noexcept;
+		~VirtualBuffer();
+
+		VirtualBuffer &operator=(const VirtualBuffer&) = delete;
+		VirtualBuffer &operator=(VirtualBuffer&&)      noexcept;
+
+		T       &operator[](size_t index)       noexcept;
+		const T &operator[](size_t index) const noexcept;
+
+		explicit operator bool() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns the first element of the buffer
+//!
+//! \return  Pointer to the reserved range (its address never changes)
+//!
+//====================================================================================================================================
+
+		T *get() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns number of elements backed by committed pages
+//!
+//! \return  Committed capacity
+//!
+//====================================================================================================================================
+
+		size_t capacity() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Returns number of elements the reserved range can hold
+//!
+//! \return  Reserved capacity
+//!
+//====================================================================================================================================
+
+		size_t maxSize() const noexcept;
+
+//====================================================================================================================================
+//!
+//! \brief	 Commits pages so that at least size elements are accessible (clamped to the reservation)
+//!
+//! \param   size  Required number of elements
+//!
+//! \return  False if the buffer is already at its reservation limit and can not grow
+//!
+//! \throw   std::bad_alloc
+//!
+//====================================================================================================================================
+
+		bool commit(size_t size);
+
+//====================================================================================================================================
+//!
+//! \brief	Returns pages which are not needed to hold size elements to the system
+//!
+//! \param  size  Number of elements which must stay accessible
+//!
+//====================================================================================================================================
+
+		void decommit(size_t size) noexcept;
+
+		void swap(VirtualBuffer &rBuf) noexcept;
+
+	private:
+		T      *pBuf_;
+		size_t  reserved_,  // In bytes
+		        committed_; // In bytes
+
+		void release() noexcept;
+	};
+
+#pragma endregion
+
+#pragma region METHOD_DEFINITION
+
+	template<typename T>
+	inline VirtualBuffer<T>::VirtualBuffer(size_t maxSize /* = 0 */) noexcept :
+		pBuf_(nullptr),
+		reserved_(NULL),
+		committed_(NULL)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "VirtualBuffer holds only trivially copyable types\n");
+
+		if (!maxSize) return;
+
+		size_t page  = GetPageSize(),
+		       bytes = (maxSize * sizeof(T) + page - 1) / page * page;
+
+#ifdef _WIN32
+		pBuf_ = static_cast<T*>(VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS));
+#else
+		void *pMem = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		pBuf_ = (pMem == MAP_FAILED ? nullptr : static_cast<T*>(pMem));
+#endif // _WIN32
+
+		if (pBuf_) reserved_ = bytes;
+	}
+
+	template<typename T>
+	inline VirtualBuffer<T>::VirtualBuffer(VirtualBuffer &&rrBuf) noexcept :
+		pBuf_(rrBuf.pBuf_),
+		reserved_(rrBuf.reserved_),
+		committed_(rrBuf.committed_)
+	{
+		rrBuf.pBuf_      = nullptr;
+		rrBuf.reserved_  = NULL;
+		rrBuf.committed_ = NULL;
+	}
+
+	template<typename T>
+	inline VirtualBuffer<T>::~VirtualBuffer()
+	{
+		release();
+	}
+
+	template<typename T>
+	inline VirtualBuffer<T> &VirtualBuffer<T>::operator=(VirtualBuffer &&rrBuf) noexcept
+	{
+		assert(this != &rrBuf);
+
+		release();
+
+		pBuf_      = rrBuf.pBuf_;
+		reserved_  = rrBuf.reserved_;
+		committed_ = rrBuf.committed_;
+
+		rrBuf.pBuf_      = nullptr;
+		rrBuf.reserved_  = NULL;
+		rrBuf.committed_ = NULL;
+
+		return (*this);
+	}
+
+	template<typename T>
+	inline T &VirtualBuffer<T>::operator[](size_t index) noexcept
+	{
+		assert(index < capacity());
+
+		return pBuf_[index];
+	}
+
+	template<typename T>
+	inline const T &VirtualBuffer<T>::operator[](size_t index) const noexcept
+	{
+		assert(index < capacity());
+
+		return pBuf_[index];
+	}
+
+	template<typename T>
+	inline VirtualBuffer<T>::operator bool() const noexcept
+	{
+		return (pBuf_ != nullptr);
+	}
+
+	template<typename T>
+	inline T *VirtualBuffer<T>::get() const noexcept
+	{
+		return pBuf_;
+	}
+
+	template<typename T>
+	inline size_t VirtualBuffer<T>::capacity() const noexcept
+	{
+		return committed_ / sizeof(T);
+	}
+
+	template<typename T>
+	inline size_t VirtualBuffer<T>::maxSize() const noexcept
+	{
+		return reserved_ / sizeof(T);
+	}
+
+	template<typename T>
+	bool VirtualBuffer<T>::commit(size_t size)
+	{
+		size_t page  = GetPageSize(),
+		       bytes = (size * sizeof(T) + page - 1) / page * page;
+
+		if (bytes > reserved_)
+			bytes = reserved_;
+
+		if (bytes <= committed_)
+			return (size <= capacity());
+
+		char *pFrom = reinterpret_cast<char*>(pBuf_) + committed_;
+#ifdef _WIN32
+		if (!VirtualAlloc(pFrom, bytes - committed_, MEM_COMMIT, PAGE_READWRITE))
+#else
+		if (mprotect(pFrom, bytes - committed_, PROT_READ | PROT_WRITE))
+#endif // _WIN32
+			throw std::bad_alloc();
+
+		committed_ = bytes;
+
+		return true;
+	}
+
+	template<typename T>
+	void VirtualBuffer<T>::decommit(size_t size) noexcept
+	{
+		size_t page  = GetPageSize(),
+		       bytes = (size * sizeof(T) + page - 1) / page * page;
+
+		if (bytes >= committed_)
+			return;
+
+		char *pFrom = reinterpret_cast<char*>(pBuf_) + bytes;
+#ifdef _WIN32
+		if (VirtualFree(pFrom, committed_ - bytes, MEM_DECOMMIT))
+#else
+		if (!madvise(pFrom, committed_ - bytes, MADV_DONTNEED) && !mprotect(pFrom, committed_ - bytes, PROT_NONE))
+#endif // _WIN32
+			committed_ = bytes;
+	}
+
+	template<typename T>
+	inline void VirtualBuffer<T>::swap(VirtualBuffer &rBuf) noexcept
+	{
+		using std::swap; // To have all possible swaps
+
+		swap(pBuf_,      rBuf.pBuf_);
+		swap(reserved_,  rBuf.reserved_);
+		swap(committed_, rBuf.committed_);
+	}
+
+	template<typename T>
+	inline void VirtualBuffer<T>::release() noexcept
+	{
+		if (pBuf_)
+#ifdef _WIN32
+			VirtualFree(pBuf_, 0, MEM_RELEASE);
+#else
+			munmap(pBuf_, reserved_);
+#endif // _WIN32
+
+		pBuf_      = nullptr;
+		reserved_  = NULL;
+		committed_ = NULL;
+	}
+
+#pragma endregion
+
+#pragma region FUNCTION_DEFINITION
+
+	inline size_t GetPageSize() noexcept
+	{
+		static const size_t PAGE_SIZE = []
+		{
+#ifdef _WIN32
+			SYSTEM_INFO info = { };
+			GetSystemInfo(&info);
+
+			return static_cast<size_t>(info.dwPageSize);
+#else
+			return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif // _WIN32
+		}();
+
+		return PAGE_SIZE;
+	}
+
+#pragma endregion
+
+} // namespace NMemory
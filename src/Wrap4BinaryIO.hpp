@@ -14,9 +14,12 @@
 #error
 #endif /* __cplusplus */
 
-#include <memory>  // std::unique_ptr
-#include <iosfwd>  // std::ifstream, std::ofstream
-#include <cassert> // assert
+#include <memory>      // std::unique_ptr
+#include <istream>     // std::istream
+#include <ostream>     // std::ostream
+#include <string>      // std::string
+#include <string_view> // std::string_view
+#include <cassert>     // assert
 
 #pragma region CLASSES
 
@@ -47,7 +50,7 @@ template<typename T>
 std::istream &operator>>(std::istream&, Wrap4BinaryIO<T>&);
 
 template<typename T>
-std::ostream &operator<<(std::ostream&, Wrap4BinaryIO<T>&);
+std::ostream &operator<<(std::ostream&, const Wrap4BinaryIO<T>&);
 
 #pragma endregion
 
@@ -101,7 +104,7 @@ inline Wrap4BinaryIO<T>::operator const T&() const noexcept
 #pragma region TEMPLATE_SPECIALIZATION
 
 template<>
-std::istream &operator>><std::string>(std::istream &rIstr, Wrap4BinaryIO<std::string> &rVal)
+inline std::istream &operator>><std::string>(std::istream &rIstr, Wrap4BinaryIO<std::string> &rVal)
 {
 	size_t size = 0;
 	rIstr.read(reinterpret_cast<char*>(&size), sizeof(size));
@@ -116,7 +119,7 @@ std::istream &operator>><std::string>(std::istream &rIstr, Wrap4BinaryIO<std::st
 }
 
 template<>
-std::ostream &operator<<<std::string>(std::ostream &rOstr, Wrap4BinaryIO<std::string> &rVal)
+inline std::ostream &operator<<<std::string>(std::ostream &rOstr, const Wrap4BinaryIO<std::string> &rVal)
 {
 	size_t size = rVal.operator const std::string&().length();
 	rOstr.write(reinterpret_cast<const char*>(&size), sizeof(size));
@@ -125,6 +128,17 @@ std::ostream &operator<<<std::string>(std::ostream &rOstr, Wrap4BinaryIO<std::st
 	return rOstr;
 }
 
+template<>
+inline std::ostream &operator<<<std::string_view>(std::ostream &rOstr, const Wrap4BinaryIO<std::string_view> &rVal)
+{ // Same layout as std::string, written without a copy
+	std::string_view str  = rVal;
+	size_t           size = str.length();
+	rOstr.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	rOstr.write(str.data(), size);
+
+	return rOstr;
+}
+
 #pragma endregion
 
 #pragma region FUNCTION_DEFINITION
@@ -138,9 +152,9 @@ std::istream &operator>>(std::istream &rIstr, Wrap4BinaryIO<T> &rVal)
 }
 
 template<typename T>
-std::ostream &operator<<(std::ostream &rOstr, Wrap4BinaryIO<T> &rVal)
+std::ostream &operator<<(std::ostream &rOstr, const Wrap4BinaryIO<T> &rVal)
 {
-	rOstr.write(reinterpret_cast<const char*>(&static_cast<T&>(rVal)), sizeof(T));
+	rOstr.write(reinterpret_cast<const char*>(&static_cast<const T&>(rVal)), sizeof(T));
 
 	return rOstr;
 }
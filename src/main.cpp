@@ -2,20 +2,17 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 /* cmd -D_SCL_SECURE_NO_WARNINGS _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING */
+/* g++ -std=c++17 -O2 -I src src/main.cpp src/AsyncLog.cpp src/Debugger.cpp src/Logger.cpp src/MyMath.cpp src/Parser.cpp -lpthread */
 
-#define GUARD_LVL 3
+#define GUARD_LVL   3
+#define PROFILE_LVL 0 // 1 - report of opcodes and instructions, 2 - also functions and CPU.folded for flame graphs
+#define STATS_LVL   0 // 1 - counters of the CPU (stack high-water, branches, reallocations...) after the run
 
 #include "Compiler.hpp"
 
 using namespace NCompiler;
 
-// |=-=-=-=-=-=-=|=-=-=-=-=-=|=-=-=-=-=-=|
-// |   GADJET    |  RELEASE  |   DEBUG   |
-// |=-=-=-=-=-=-=|=-=-=-=-=-=|=-=-=-=-=-=|
-// | PC-MAIN     | 7sec      | 9sec      |
-// | PC-TWINK    | 11sec     |           |
-// | LAPTOP-MAIN | 2min40sec | 2min46sec |
-// |=-=-=-=-=-=-=|=-=-=-=-=-=|=-=-=-=-=-=|
+// Timings of the execution paths are measured by the Benchmarks project, see Benchmarks/VMBenchmarks.hpp
 
 int main(int argc, char *argv[])
 {
@@ -28,8 +25,21 @@ int main(int argc, char *argv[])
 	{
 		std::string file((argc >= 2 ? argv[1] : "..\\..\\src\\Tests\\Text\\Text1Com"));		
 
+		std::unique_ptr<NChromeTrace::Sink> pSink;
+		if (argc >= 4 && *argv[3]) pSink = std::make_unique<NChromeTrace::Sink>(argv[3]); // Opened by chrome://tracing or ui.perfetto.dev
+
 		Compiler<> comp;
+		if (argc >= 3 && *argv[2]) comp.startTrace(argv[2]); // Decoded by TraceDecoder
+		if (pSink)                 comp.startChromeTrace(*pSink, "main");
+		if (argc >= 5 && *argv[4]) comp.startCache(argv[4]); // Images of the assembled programms, shared by the runs
+		comp.startProfile();
+
 		comp.fromComFile(file);
+		comp.reportProfile();
+
+		STATS(std::cout << comp.stats() << std::endl;)
+
+		CALL_GRAPH(std::ofstream folded("CPU.folded"); comp.foldProfile(folded);)
 	}
 	catch (const std::exception &exc)
 	{
@@ -40,7 +50,9 @@ int main(int argc, char *argv[])
 		std::cout << "Unhandled exeption\n";
 	}
 
+#ifdef _WIN32
 	system("pause");
+#endif // _WIN32
 	Logger::close();
     
 	return 0;